@@ -194,6 +194,10 @@ bad_catalogue_error::bad_catalogue_error(const std::string& msg, const std::any&
     : arbor_exception(pprintf("Error while opening catalogue '{}'", msg)), platform_error(pe)
 {}
 
+catalogue_compilation_error::catalogue_compilation_error(const std::string& name, const std::string& log)
+    : arbor_exception(pprintf("Failed to compile catalogue '{}':\n{}", name, log)), name(name), log(log)
+{}
+
 unsupported_abi_error::unsupported_abi_error(size_t v):
     arbor_exception(pprintf("ABI version is not supported by this version of arbor '{}'", v)),
     version{v} {}
@@ -13,6 +13,11 @@ struct fvm_integration_result {
     util::range<const threshold_crossing*> crossings;
     util::range<const arb_value_type*> sample_time;
     util::range<const arb_value_type*> sample_value;
+    // Largest rate of change of the membrane voltage over the last time step [mV/ms];
+    // only computed for adaptive time stepping. If that step changed the voltage
+    // by more than the tolerance, integration stops after it, before the end of
+    // the time step range.
+    arb_value_type voltage_rate = 0;
 };
 
 struct fvm_detector_info {
@@ -12,6 +12,7 @@
 #include "backends/gpu/shared_state.hpp"
 #include "backends/event_stream_state.hpp"
 #include "backends/gpu/chunk_writer.hpp"
+#include "backends/gpu/fine.hpp"
 #include "memory/copy.hpp"
 #include "memory/wrappers.hpp"
 #include "util/index_into.hpp"
@@ -175,12 +176,14 @@ shared_state::shared_state(task_system_handle tp,
                            const std::vector<arb_index_type>& src_to_spike_,
                            const fvm_detector_info& detector_info,
                            unsigned, // align parameter ignored
-                           arb_seed_type cbprng_seed_):
+                           arb_seed_type cbprng_seed_,
+                           arb_size_type n_remote_peer_):
     thread_pool(tp),
     n_detector(detector_info.count),
     n_cv(n_cv_),
+    n_remote_peer(n_remote_peer_),
     cv_to_cell(make_const_view(cv_to_cell_vec)),
-    voltage(n_cv_),
+    voltage(n_cv_+n_remote_peer_),
     current_density(n_cv_),
     conductivity(n_cv_),
     init_voltage(make_const_view(init_membrane_potential)),
@@ -355,7 +358,7 @@ unsigned shared_state::instantiate(mechanism& m,
 }
 
 void shared_state::reset() {
-    memory::copy(init_voltage, voltage);
+    memory::copy(init_voltage, voltage(0, n_cv));
     memory::fill(current_density, 0);
     memory::fill(conductivity, 0);
     time = 0;
@@ -368,6 +371,25 @@ void shared_state::reset() {
     stim_data.reset();
 }
 
+void shared_state::set_remote_peer_voltages(const std::vector<arb_value_type>& values) {
+    arb_assert(values.size() == n_remote_peer);
+    memory::copy(memory::make_const_view(values), voltage(n_cv, n_cv + n_remote_peer));
+}
+
+void shared_state::configure_exported_voltages(const std::vector<arb_index_type>& cvs) {
+    exported_cv = iarray(memory::make_const_view(cvs));
+    exported_voltage = array(cvs.size());
+}
+
+std::vector<arb_value_type> shared_state::exported_voltages() const {
+    std::vector<arb_value_type> result(exported_cv.size());
+    if (result.empty()) return result;
+    // Gather on the device, such that only the exported voltages are copied to the host.
+    gather(voltage.data(), exported_voltage.data(), exported_cv.data(), exported_cv.size());
+    memory::copy(exported_voltage, memory::make_view(result));
+    return result;
+}
+
 void shared_state::zero_currents() {
     memory::fill(current_density, 0);
     memory::fill(conductivity, 0);
@@ -132,12 +132,16 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
     arb_size_type n_intdom = 0;   // Number of distinct integration domains.
     arb_size_type n_detector = 0; // Max number of detectors on all cells.
     arb_size_type n_cv = 0;       // Total number of CVs.
+    arb_size_type n_remote_peer = 0; // Gap junction peers in other cell groups, whose voltages
+                                     // are stored past those of the CVs.
+    iarray exported_cv;              // CVs whose voltages are read by other cell groups.
+    mutable array exported_voltage;  // Voltages at exported_cv, gathered on the device.
 
     iarray cv_to_cell;            // Maps CV index to cell index.
     arb_value_type time = 0.0;    // integration start time [ms].
     arb_value_type time_to = 0.0; // integration end time [ms]
     arb_value_type dt  = 0.0;     // dt [ms].
-    array voltage;                // Maps CV index to membrane voltage [mV].
+    array voltage;                // Maps CV index to membrane voltage [mV], then remote peers.
     array current_density;        // Maps CV index to current density [A/m²].
     array conductivity;           // Maps CV index to membrane conductivity [kS/m²].
 
@@ -176,7 +180,9 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
                  const std::unordered_map<std::string, fvm_ion_config>& ions,
                  const fvm_stimulus_config& stims,
                  unsigned align,
-                 arb_seed_type cbprng_seed_ = 0u)
+                 arb_seed_type cbprng_seed_ = 0u,
+                 bool = false, // huge_pages parameter ignored
+                 arb_size_type n_remote_peer_ = 0)
         : shared_state{std::move(tp),
                        n_cell,
                        (arb_size_type) D.size(),
@@ -188,7 +194,8 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
                        src_to_spike,
                        detector_info,
                        align,
-                       cbprng_seed_}
+                       cbprng_seed_,
+                       n_remote_peer_}
     {
         configure_stimulus(stims);
         configure_solver(D);
@@ -207,7 +214,8 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
                  const std::vector<arb_index_type>& src_to_spike,
                  const fvm_detector_info& detector_info,
                  unsigned, // align parameter ignored
-                 arb_seed_type cbprng_seed_ = 0u);
+                 arb_seed_type cbprng_seed_ = 0u,
+                 arb_size_type n_remote_peer_ = 0);
 
     // Setup a mechanism and tie its backing store to this object
     unsigned instantiate(mechanism&,
@@ -217,6 +225,14 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
 
     void update_prng_state(mechanism&);
 
+    // Set the voltages of the remote peers [mV].
+    void set_remote_peer_voltages(const std::vector<arb_value_type>& values);
+
+    // Set the CVs whose voltages are read by gap junction peers in other
+    // cell groups, and return those voltages [mV].
+    void configure_exported_voltages(const std::vector<arb_index_type>& cvs);
+    std::vector<arb_value_type> exported_voltages() const;
+
     void zero_currents();
 
     // Return minimum and maximum voltage value [mV] across cells.
@@ -17,7 +17,7 @@ namespace kernel {
 ///     t_prev  : time of last test (ms)
 ///     size    : number of values to test
 ///     is_crossed  : crossing state at time t_prev (true or false)
-///     prev_values : values at sample points (see index) sampled at t_prev
+///     prev_values : values at each detector sampled at t_prev
 ///     index      : index with locations in values to test for crossing
 ///     values     : values at t_prev
 ///     thresholds : threshold values to watch for crossings
@@ -44,7 +44,7 @@ void test_thresholds_impl(
     if (i<size) {
         // Test for threshold crossing
         const auto cv     = cv_index[i];
-        const auto v_prev = prev_values[cv];
+        const auto v_prev = prev_values[i];
         const auto v      = values[cv];
         const auto thresh = thresholds[i];
         arb_index_type spike_idx = 0;
@@ -73,7 +73,7 @@ void test_thresholds_impl(
             is_crossed[i]=0;
         }
 
-        prev_values[cv] = v;
+        prev_values[i] = v;
     }
 
     if (crossed) {
@@ -85,13 +85,16 @@ __global__
 extern void reset_crossed_impl(
     int size,
     arb_index_type* __restrict__ const is_crossed,
+    arb_value_type* __restrict__ const prev_values,
     const arb_index_type* __restrict__ const cv_index,
     const arb_value_type* __restrict__ const values,
     const arb_value_type* __restrict__ const thresholds)
 {
     int i = threadIdx.x + blockIdx.x*blockDim.x;
     if (i<size) {
-        is_crossed[i] = values[cv_index[i]] >= thresholds[i];
+        const auto v = values[cv_index[i]];
+        prev_values[i] = v;
+        is_crossed[i] = v >= thresholds[i];
     }
 }
 
@@ -117,10 +120,10 @@ void test_thresholds_impl(
 }
 
 void reset_crossed_impl(
-    int size, arb_index_type* is_crossed,
+    int size, arb_index_type* is_crossed, arb_value_type* prev_values,
     const arb_index_type* cv_index, const arb_value_type* values, const arb_value_type* thresholds)
 {
-    launch_1d(size, 128, kernel::reset_crossed_impl, size, is_crossed, cv_index, values, thresholds);
+    launch_1d(size, 128, kernel::reset_crossed_impl, size, is_crossed, prev_values, cv_index, values, thresholds);
 }
 
 } // namespace gpu
@@ -38,6 +38,7 @@ void test_thresholds_impl(
 void reset_crossed_impl(
     int size,
     arb_index_type* is_crossed,
+    arb_value_type* prev_values,
     const arb_index_type* cv_index,
     const arb_value_type* values,
     const arb_value_type* thresholds);
@@ -69,7 +70,7 @@ public:
         cv_index_(memory::make_const_view(cv_index)),
         is_crossed_(n_detectors_),
         thresholds_(memory::make_const_view(thresholds)),
-        v_prev_(num_cv),
+        v_prev_(n_detectors_),
         // TODO: allocates enough space for 10 spikes per watch.
         // A more robust approach might be needed to avoid overflows.
         stack_(100*size(), context.gpu)
@@ -89,10 +90,9 @@ public:
     /// calling, because the values are used to determine the initial state
     void reset(const array& values) {
         values_ = values.data();
-        memory::copy(values, v_prev_);
         clear_crossings();
         if (size()>0) {
-            reset_crossed_impl((int)size(), is_crossed_.data(), cv_index_.data(), values_, thresholds_.data());
+            reset_crossed_impl((int)size(), is_crossed_.data(), v_prev_.data(), cv_index_.data(), values_, thresholds_.data());
         }
     }
 
@@ -150,7 +150,7 @@ private:
     iarray cv_index_;           // Compartment indexes of values to watch.
     iarray is_crossed_;         // Boolean flag for state of each watch.
     array thresholds_;          // Threshold for each watch.
-    array v_prev_;              // Values at previous sample time.
+    array v_prev_;              // Values at each detector at previous sample time.
 
     // Hybrid host/gpu data structure for accumulating threshold crossings.
     mutable stack_type stack_;
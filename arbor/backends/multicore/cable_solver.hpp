@@ -35,12 +35,13 @@ struct cable_solver {
     cable_solver(const std::vector<index_type>& p,
                  const std::vector<index_type>& cell_cv_divs,
                  const std::vector<value_type>& cap,
-                 const std::vector<value_type>& cond):
-        parent_index(p.begin(), p.end()),
-        cell_cv_divs(cell_cv_divs.begin(), cell_cv_divs.end()),
-        d(size(), 0), u(size(), 0),
-        cv_capacitance(cap.begin(), cap.end()),
-        invariant_d(size(), 0)
+                 const std::vector<value_type>& cond,
+                 const util::padded_allocator<>& alloc = {}):
+        parent_index(p.begin(), p.end(), alloc),
+        cell_cv_divs(cell_cv_divs.begin(), cell_cv_divs.end(), alloc),
+        d(size(), 0, alloc), u(size(), 0, alloc),
+        cv_capacitance(cap.begin(), cap.end(), alloc),
+        invariant_d(size(), 0, alloc)
     {
         // Sanity check
         arb_assert(cap.size() == size());
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -14,6 +15,7 @@
 #include <arbor/simd/simd.hpp>
 
 #include "io/sepval.hpp"
+#include "util/arena.hpp"
 #include "util/index_into.hpp"
 #include "util/padded_alloc.hpp"
 #include "util/rangeutil.hpp"
@@ -51,28 +53,28 @@ inline unsigned min_alignment(unsigned align) {
 using pad = util::padded_allocator<>;
 
 ion_state::ion_state(const fvm_ion_config& ion_data,
-                     unsigned align,
+                     const util::padded_allocator<>& alloc,
                      solver_ptr ptr):
-    alignment(min_alignment(align)),
+    alignment(min_alignment(alloc.alignment())),
     flags_{ion_data},
-    node_index_(ion_data.cv.begin(), ion_data.cv.end(), pad(alignment)),
-    iX_(ion_data.cv.size(), NAN, pad(alignment)),
-    gX_(ion_data.cv.size(), NAN, pad(alignment)),
-    charge(1u, ion_data.charge, pad(alignment)),
+    node_index_(ion_data.cv.begin(), ion_data.cv.end(), pad(alignment, alloc.arena())),
+    iX_(ion_data.cv.size(), NAN, pad(alignment, alloc.arena())),
+    gX_(ion_data.cv.size(), NAN, pad(alignment, alloc.arena())),
+    charge(1u, ion_data.charge, pad(alignment, alloc.arena())),
     solver(std::move(ptr)) {
     if (flags_.reset_xi()
-      ||flags_.reset_xd()) reset_Xi_ = {ion_data.reset_iconc.begin(), ion_data.reset_iconc.end(), pad(alignment)};
-    if (flags_.reset_xi()) init_Xi_  = {ion_data.init_iconc.begin(),  ion_data.init_iconc.end(),  pad(alignment)};
-    if (flags_.xi())       Xi_       = {ion_data.init_iconc.begin(),  ion_data.init_iconc.end(),  pad(alignment)};
+      ||flags_.reset_xd()) reset_Xi_ = {ion_data.reset_iconc.begin(), ion_data.reset_iconc.end(), pad(alignment, alloc.arena())};
+    if (flags_.reset_xi()) init_Xi_  = {ion_data.init_iconc.begin(),  ion_data.init_iconc.end(),  pad(alignment, alloc.arena())};
+    if (flags_.xi())       Xi_       = {ion_data.init_iconc.begin(),  ion_data.init_iconc.end(),  pad(alignment, alloc.arena())};
 
-    if (flags_.reset_xo()) reset_Xo_ = {ion_data.reset_econc.begin(), ion_data.reset_econc.end(), pad(alignment)};
-    if (flags_.reset_xo()) init_Xo_  = {ion_data.init_econc.begin(),  ion_data.init_econc.end(),  pad(alignment)};
-    if (flags_.xo())       Xo_       = {ion_data.init_econc.begin(),  ion_data.init_econc.end(),  pad(alignment)};
+    if (flags_.reset_xo()) reset_Xo_ = {ion_data.reset_econc.begin(), ion_data.reset_econc.end(), pad(alignment, alloc.arena())};
+    if (flags_.reset_xo()) init_Xo_  = {ion_data.init_econc.begin(),  ion_data.init_econc.end(),  pad(alignment, alloc.arena())};
+    if (flags_.xo())       Xo_       = {ion_data.init_econc.begin(),  ion_data.init_econc.end(),  pad(alignment, alloc.arena())};
 
-    if (flags_.reset_ex()) init_eX_ = {ion_data.init_revpot.begin(), ion_data.init_revpot.end(),  pad(alignment)};
-    if (flags_.ex())       eX_      = {ion_data.init_revpot.begin(), ion_data.init_revpot.end(),  pad(alignment)};
+    if (flags_.reset_ex()) init_eX_ = {ion_data.init_revpot.begin(), ion_data.init_revpot.end(),  pad(alignment, alloc.arena())};
+    if (flags_.ex())       eX_      = {ion_data.init_revpot.begin(), ion_data.init_revpot.end(),  pad(alignment, alloc.arena())};
 
-    if (flags_.xd())       Xd_      = {ion_data.reset_iconc.begin(), ion_data.reset_iconc.end(),  pad(alignment)};
+    if (flags_.xd())       Xd_      = {ion_data.reset_iconc.begin(), ion_data.reset_iconc.end(),  pad(alignment, alloc.arena())};
 }
 
 void ion_state::init_concentration() {
@@ -95,11 +97,17 @@ void ion_state::reset() {
 
 // istim_state methods:
 
-istim_state::istim_state(const fvm_stimulus_config& stim, unsigned align):
-    alignment(min_alignment(align)),
-    accu_to_cv_(stim.cv_unique.begin(), stim.cv_unique.end(), pad(alignment)),
-    frequency_(stim.frequency.begin(), stim.frequency.end(), pad(alignment)),
-    phase_(stim.phase.begin(), stim.phase.end(), pad(alignment))
+istim_state::istim_state(const fvm_stimulus_config& stim, const util::padded_allocator<>& alloc):
+    alignment(min_alignment(alloc.alignment())),
+    accu_index_(pad(alignment, alloc.arena())),
+    accu_to_cv_(stim.cv_unique.begin(), stim.cv_unique.end(), pad(alignment, alloc.arena())),
+    frequency_(stim.frequency.begin(), stim.frequency.end(), pad(alignment, alloc.arena())),
+    phase_(stim.phase.begin(), stim.phase.end(), pad(alignment, alloc.arena())),
+    envl_amplitudes_(pad(alignment, alloc.arena())),
+    envl_times_(pad(alignment, alloc.arena())),
+    envl_divs_(pad(alignment, alloc.arena())),
+    accu_stim_(pad(alignment, alloc.arena())),
+    envl_index_(pad(alignment, alloc.arena()))
 {
     using util::assign;
 
@@ -195,21 +203,24 @@ shared_state::shared_state(task_system_handle,    // ignored in mc backend
                            const std::vector<arb_index_type>& src_to_spike_,
                            const fvm_detector_info& detector_info,
                            unsigned align,
-                           arb_seed_type cbprng_seed_):
+                           arb_seed_type cbprng_seed_,
+                           bool huge_pages,
+                           arb_size_type n_remote_peer_):
     alignment(min_alignment(align)),
-    alloc(alignment),
+    alloc(alignment, std::make_shared<util::arena>(huge_pages)),
     n_detector(detector_info.count),
     n_cv(n_cv_),
-    cv_to_cell(math::round_up(cv_to_cell_vec.size(), alignment), pad(alignment)),
-    voltage(n_cv_, pad(alignment)),
-    current_density(n_cv_, pad(alignment)),
-    conductivity(n_cv_, pad(alignment)),
-    init_voltage(init_membrane_potential.begin(), init_membrane_potential.end(), pad(alignment)),
-    temperature_degC(n_cv_, pad(alignment)),
-    diam_um(diam.begin(), diam.end(), pad(alignment)),
-    area_um2(area.begin(), area.end(), pad(alignment)),
-    time_since_spike(n_cell*n_detector, pad(alignment)),
-    src_to_spike(src_to_spike_.begin(), src_to_spike_.end(), pad(alignment)),
+    n_remote_peer(n_remote_peer_),
+    cv_to_cell(math::round_up(cv_to_cell_vec.size(), alignment), alloc),
+    voltage(n_cv_+n_remote_peer_, alloc),
+    current_density(n_cv_, alloc),
+    conductivity(n_cv_, alloc),
+    init_voltage(init_membrane_potential.begin(), init_membrane_potential.end(), alloc),
+    temperature_degC(n_cv_, alloc),
+    diam_um(diam.begin(), diam.end(), alloc),
+    area_um2(area.begin(), area.end(), alloc),
+    time_since_spike(n_cell*n_detector, alloc),
+    src_to_spike(src_to_spike_.begin(), src_to_spike_.end(), alloc),
     cbprng_seed(cbprng_seed_),
     watcher{n_cv_, src_to_spike.data(), detector_info}
 {
@@ -239,6 +250,42 @@ void shared_state::reset() {
     stim_data.reset();
 }
 
+void shared_state::configure_solver(const fvm_cv_discretization& disc) {
+    solver = {disc.geometry.cv_parent,
+              disc.geometry.cell_cv_divs,
+              disc.cv_capacitance,
+              disc.face_conductance,
+              alloc};
+}
+
+void shared_state::add_ion(const std::string& ion_name,
+                           const fvm_ion_config& ion_info,
+                           ion_state::solver_ptr ptr) {
+    ion_data.emplace(std::piecewise_construct,
+                     std::forward_as_tuple(ion_name),
+                     std::forward_as_tuple(ion_info, alloc, std::move(ptr)));
+}
+
+void shared_state::configure_stimulus(const fvm_stimulus_config& stims) {
+    if (!stims.cv.empty()) stim_data = {stims, alloc};
+}
+
+void shared_state::set_remote_peer_voltages(const std::vector<arb_value_type>& values) {
+    arb_assert(values.size() == n_remote_peer);
+    std::copy(values.begin(), values.end(), voltage.begin() + n_cv);
+}
+
+void shared_state::configure_exported_voltages(const std::vector<arb_index_type>& cvs) {
+    exported_cv = iarray(cvs.begin(), cvs.end(), alloc);
+}
+
+std::vector<arb_value_type> shared_state::exported_voltages() const {
+    std::vector<arb_value_type> result;
+    result.reserve(exported_cv.size());
+    for (auto cv: exported_cv) result.push_back(voltage[cv]);
+    return result;
+}
+
 void shared_state::zero_currents() {
     util::zero(current_density);
     util::zero(conductivity);
@@ -247,7 +294,7 @@ void shared_state::zero_currents() {
 }
 
 std::pair<arb_value_type, arb_value_type> shared_state::voltage_bounds() const {
-    return util::minmax_value(voltage);
+    return util::minmax_value(util::subrange_view(voltage, 0, n_cv));
 }
 
 void shared_state::take_samples() {
@@ -373,7 +420,7 @@ unsigned shared_state::instantiate(arb::mechanism& m,
     // We used the padded_allocator to allocate arrays with the correct alignment, and allocate
     // sizes that are multiples of a width padded to account for SIMD access and per-vector alignment.
 
-    util::padded_allocator<> pad(m.data_alignment());
+    util::padded_allocator<> pad(m.data_alignment(), alloc.arena());
 
     // get new id
     auto id = streams.size();
@@ -68,7 +68,9 @@ struct ARB_ARBOR_API ion_state {
 
     ion_state() = default;
 
-    ion_state(const fvm_ion_config& ion_data, unsigned align, solver_ptr ptr);
+    // Construct state with arrays allocated by alloc, with its alignment
+    // raised to the SIMD width if needed.
+    ion_state(const fvm_ion_config& ion_data, const util::padded_allocator<>& alloc, solver_ptr ptr);
 
     // Set ion concentrations to weighted proportion of default concentrations.
     void init_concentration();
@@ -123,7 +125,7 @@ struct ARB_ARBOR_API istim_state {
     void add_current(const arb_value_type t, array& current_density);
 
     // Construct state from i_clamp data:
-    istim_state(const fvm_stimulus_config& stim_data, unsigned align);
+    istim_state(const fvm_stimulus_config& stim_data, const util::padded_allocator<>& alloc);
 
     istim_state() = default;
 };
@@ -134,17 +136,20 @@ struct ARB_ARBOR_API shared_state:
     cable_solver solver;
 
     unsigned alignment = 1;         // Alignment and padding multiple.
-    util::padded_allocator<> alloc; // Allocator with corresponging alignment/padding.
+    util::padded_allocator<> alloc; // Allocator with corresponging alignment/padding, from the arena of the group.
 
     arb_size_type n_intdom = 0;     // Number of integration domains.
     arb_size_type n_detector = 0;   // Max number of detectors on all cells.
     arb_size_type n_cv = 0;         // Total number of CVs.
+    arb_size_type n_remote_peer = 0; // Gap junction peers in other cell groups, whose voltages
+                                     // are stored past those of the CVs.
+    iarray exported_cv;              // CVs whose voltages are read by other cell groups.
 
     iarray cv_to_cell;              // Maps CV index to GID
     arb_value_type time = 0.0;      // integration start time [ms].
     arb_value_type time_to = 0.0;   // integration end time [ms]
     arb_value_type dt = 0.0;        // dt [ms].
-    array voltage;                  // Maps CV index to membrane voltage [mV].
+    array voltage;                  // Maps CV index to membrane voltage [mV], then remote peers.
     array current_density;          // Maps CV index to membrane current density contributions [A/m²].
     array conductivity;             // Maps CV index to membrane conductivity [kS/m²].
     array init_voltage;             // Maps CV index to initial membrane voltage [mV].
@@ -184,7 +189,9 @@ struct ARB_ARBOR_API shared_state:
                  const std::vector<arb_index_type>& src_to_spike,
                  const fvm_detector_info& detector_info,
                  unsigned align,
-                 arb_seed_type cbprng_seed_=0u);
+                 arb_seed_type cbprng_seed_=0u,
+                 bool huge_pages=false,
+                 arb_size_type n_remote_peer_=0);
 
     shared_state(task_system_handle tp,
                  arb_size_type n_cell,
@@ -195,7 +202,9 @@ struct ARB_ARBOR_API shared_state:
                  std::unordered_map<std::string, fvm_ion_config> ions,
                  const fvm_stimulus_config& stims,
                  unsigned align,
-                 arb_seed_type cbprng_seed_ = 0u)
+                 arb_seed_type cbprng_seed_ = 0u,
+                 bool huge_pages = false,
+                 arb_size_type n_remote_peer_ = 0)
         : shared_state{std::move(tp),
                        n_cell,
                        D.size(),
@@ -207,13 +216,20 @@ struct ARB_ARBOR_API shared_state:
                        src_to_spike,
                        detector,
                        align,
-                       cbprng_seed_}
+                       cbprng_seed_,
+                       huge_pages,
+                       n_remote_peer_}
     {
         configure_stimulus(stims);
         configure_solver(D);
         add_ions(D, ions);
     }
 
+    // As in shared_state_base, but allocating from the arena of the group.
+    void configure_solver(const fvm_cv_discretization& disc);
+    void add_ion(const std::string& ion_name, const fvm_ion_config& ion_info, ion_state::solver_ptr ptr=nullptr);
+    void configure_stimulus(const fvm_stimulus_config& stims);
+
     // Setup a mechanism and tie its backing store to this object
     unsigned instantiate(mechanism&,
                          const mechanism_overrides&,
@@ -222,6 +238,14 @@ struct ARB_ARBOR_API shared_state:
 
     void update_prng_state(mechanism&);
 
+    // Set the voltages of the remote peers [mV].
+    void set_remote_peer_voltages(const std::vector<arb_value_type>& values);
+
+    // Set the CVs whose voltages are read by gap junction peers in other
+    // cell groups, and return those voltages [mV].
+    void configure_exported_voltages(const std::vector<arb_index_type>& cvs);
+    std::vector<arb_value_type> exported_voltages() const;
+
     void zero_currents();
 
     // Return minimum and maximum voltage value [mV] across cells.
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <arbor/assert.hpp>
 #include <arbor/fvm_types.hpp>
 #include <arbor/math.hpp>
@@ -33,7 +36,7 @@ public:
         cv_index_(cv_index),
         is_crossed_(n_detectors_),
         thresholds_(thresholds),
-        v_prev_(num_cv)
+        v_prev_(n_detectors_)
     {
         arb_assert(n_detectors_==thresholds.size());
         // reset() needs to be called before this is ready for use
@@ -50,10 +53,11 @@ public:
     /// calling, because the values are used to determine the initial state
     void reset(const array& values) {
         values_ = values.data();
-        std::copy(values.begin(), values.end(), v_prev_.begin());
         clear_crossings();
         for (arb_size_type i = 0; i<n_detectors_; ++i) {
-            is_crossed_[i] = values_[cv_index_[i]]>=thresholds_[i];
+            auto v = values_[cv_index_[i]];
+            v_prev_[i] = v;
+            is_crossed_[i] = v>=thresholds_[i];
         }
     }
 
@@ -67,40 +71,57 @@ public:
         arb_assert(values_!=nullptr);
 
         // Reset all spike times to -1.0 indicating no spike has been recorded on the detector
-        for (arb_size_type i = 0; i<n_detectors_; ++i) {
-            auto cv     = cv_index_[i];
-            auto v_prev = v_prev_[cv];
-            auto v      = values_[cv];
-            auto thresh = thresholds_[i];
-            arb_index_type spike_idx = 0;
-
-            if (!time_since_spike.empty()) {
-                spike_idx = src_to_spike_[i];
-                time_since_spike[spike_idx] = -1.0;
+        if (!time_since_spike.empty()) {
+            for (arb_size_type i = 0; i<n_detectors_; ++i) {
+                time_since_spike[src_to_spike_[i]] = -1.0;
             }
+        }
 
-            if (!is_crossed_[i]) {
-                if (v>=thresh) {
-                    // The threshold has been passed, so estimate the time using
-                    // linear interpolation.
-                    auto pos = (thresh - v_prev)/(v - v_prev);
-                    auto crossing_time = math::lerp(t_before, t_after, pos);
-                    crossings_.push_back({i, crossing_time});
-
-                    if (!time_since_spike.empty()) {
-                        time_since_spike[spike_idx] = t_after - crossing_time;
-                    }
+        // The detectors are tested in chunks. The first passes over a chunk
+        // have no branches, so that they vectorise: they gather the voltages
+        // into a local buffer, which cannot alias the state, then update the
+        // state of all detectors, keeping the previous voltages for
+        // interpolation. Only if any detector of the chunk crossed its
+        // threshold upwards does the last pass look for those detectors.
+        arb_value_type v_now[chunk_size];
+        arb_value_type v_before[chunk_size];
+        arb_size_type up[chunk_size];
+        for (arb_size_type begin = 0; begin<n_detectors_; begin += chunk_size) {
+            arb_size_type n = std::min<arb_size_type>(chunk_size, n_detectors_-begin);
+            const auto* cv = cv_index_.data() + begin;
+            const auto* thresh = thresholds_.data() + begin;
+            auto* crossed = is_crossed_.data() + begin;
+            auto* v_prev = v_prev_.data() + begin;
+
+            for (arb_size_type j = 0; j<n; ++j) {
+                v_now[j] = values_[cv[j]];
+            }
 
-                    is_crossed_[i] = true;
-                }
+            arb_size_type fired = 0;
+            for (arb_size_type j = 0; j<n; ++j) {
+                auto v = v_now[j];
+                arb_size_type above = v>=thresh[j];
+                up[j] = above & !crossed[j];
+                fired |= up[j];
+                crossed[j] = above;
+                v_before[j] = v_prev[j];
+                v_prev[j] = v;
             }
-            else {
-                if (v<thresh) {
-                    is_crossed_[i] = false;
+            if (!fired) continue;
+
+            for (arb_size_type j = 0; j<n; ++j) {
+                if (!up[j]) continue;
+                // The threshold has been passed, so estimate the time using
+                // linear interpolation.
+                auto v = v_now[j];
+                auto pos = (thresh[j] - v_before[j])/(v - v_before[j]);
+                auto crossing_time = math::lerp(t_before, t_after, pos);
+                crossings_.push_back({begin + j, crossing_time});
+
+                if (!time_since_spike.empty()) {
+                    time_since_spike[src_to_spike_[begin + j]] = t_after - crossing_time;
                 }
             }
-
-            v_prev_[cv] = v;
         }
     }
 
@@ -114,6 +135,8 @@ public:
     }
 
 private:
+    static constexpr arb_size_type chunk_size = 64;
+
     // Non-owning pointers
     const arb_value_type* values_ = nullptr;
     const arb_index_type* src_to_spike_ = nullptr;
@@ -123,7 +146,7 @@ private:
     std::vector<arb_index_type> cv_index_;
     std::vector<arb_size_type> is_crossed_;
     std::vector<arb_value_type> thresholds_;
-    std::vector<arb_value_type> v_prev_;
+    std::vector<arb_value_type> v_prev_; // Voltage at each detector at the last test.
     std::vector<threshold_crossing> crossings_;
 };
 
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
@@ -76,17 +77,32 @@ using region_assignment_value = std::conditional_t<std::is_same_v<T, density>,
                                                    mcable_map<T>>;
 
 
-struct cable_cell_impl {
-    using value_type = cable_cell::value_type;
-    using index_type = cable_cell::index_type;
-    using size_type  = cable_cell::size_type;
-
+// Morphology and labels with their concretisation; immutable once built and
+// shared by a cell, its copies, and cells derived from it as a template.
+struct cable_cell_labelled_morphology {
     // The label dictionary.
     label_dict dictionary;
 
     // Embedded morphology and labelled region/locset lookup.
     mprovider provider;
 
+    cable_cell_labelled_morphology(const arb::morphology& m, const label_dict& labels, std::shared_ptr<thingify_cache> cache):
+        dictionary(labels),
+        provider(m, dictionary, std::move(cache))
+    {}
+
+    // The provider refers to the dictionary.
+    cable_cell_labelled_morphology(const cable_cell_labelled_morphology&) = delete;
+};
+
+struct cable_cell_impl {
+    using value_type = cable_cell::value_type;
+    using index_type = cable_cell::index_type;
+    using size_type  = cable_cell::size_type;
+
+    // Morphology and labels, possibly shared with other cells.
+    std::shared_ptr<const cable_cell_labelled_morphology> base;
+
     // Regional assignments.
     region_assignment<density> densities_;
     region_assignment<voltage_process> voltage_processes_;
@@ -115,22 +131,33 @@ struct cable_cell_impl {
     // The decorations on the cell.
     decor decorations;
 
+    // Per-instance factors on density mechanism parameters.
+    parameter_scaling scales_;
+
     // Discretization
     std::optional<cv_policy> discretization_;
-    cable_cell_impl(const arb::morphology& m, const label_dict& labels, const decor& decorations, const std::optional<cv_policy>& cvp):
-        dictionary(labels),
-        provider(m, dictionary),
+    cable_cell_impl(const arb::morphology& m,
+                    const label_dict& labels,
+                    const decor& decorations,
+                    const std::optional<cv_policy>& cvp,
+                    std::shared_ptr<thingify_cache> cache = {}):
+        base(std::make_shared<const cable_cell_labelled_morphology>(m, labels, std::move(cache))),
         decorations(decorations),
         discretization_{cvp}
     {
-        init();
+        init(decorations);
     }
 
     cable_cell_impl(): cable_cell_impl({}, {}, {}, {}) {}
+
+    // Copies share the labelled morphology.
     cable_cell_impl(const cable_cell_impl& other) = default;
-    cable_cell_impl(cable_cell_impl&& other) = default;
 
-    void init();
+    // Concretise paintings and placements.
+    void init(const decor&);
+
+    // Add paintings, placements and defaults to the decorations.
+    void extend(const decor&);
 
     template <typename T>
     auto& get_location_map(const T& it) {
@@ -177,7 +204,7 @@ struct cable_cell_impl {
     void paint(const mextent& cables, const std::string& str, const scaled_mechanism<density>& prop) {
         std::unordered_map<std::string, iexpr_ptr> im;
         for (const auto& [label, iex]: prop.scale_expr) {
-            im.insert_or_assign(label, thingify(iex, provider));
+            im.insert_or_assign(label, thingify(iex, base->provider));
         }
 
         auto& mm = get_region_map(prop.t_mech);
@@ -204,55 +231,80 @@ struct cable_cell_impl {
         }
     }
 
-    mlocation_list concrete_locset(const locset& l) const { return thingify(l, provider); }
-    mextent concrete_region(const region& r) const { return thingify(r, provider); }
+    mlocation_list concrete_locset(const locset& l) const { return thingify(l, base->provider); }
+    mextent concrete_region(const region& r) const { return thingify(r, base->provider); }
 };
 
 const std::optional<cv_policy>& cable_cell::discretization() const { return impl_->discretization_; }
-void cable_cell::discretization(cv_policy cvp) { impl_->discretization_ = std::move(cvp); }
-
+void cable_cell::discretization(cv_policy cvp) {
+    // The description may be shared with copies of this cell.
+    if (impl_.use_count()>1) impl_ = std::make_shared<cable_cell_impl>(*impl_);
+    impl_->discretization_ = std::move(cvp);
+}
 
-using impl_ptr = std::unique_ptr<cable_cell_impl, void (*)(cable_cell_impl*)>;
-impl_ptr make_impl(cable_cell_impl* c) { return impl_ptr(c, [](cable_cell_impl* p){ delete p; }); }
+void cable_cell_impl::extend(const decor& delta) {
+    for (const auto& [where, what]: delta.paintings()) decorations.paint(where, what);
+    for (const auto& [where, what, tag]: delta.placements()) decorations.place(where, what, delta.tag_of(tag));
+    for (const auto& what: delta.defaults().serialize()) decorations.set_default(what);
+    init(delta);
+}
 
-void cable_cell_impl::init() {
+void cable_cell_impl::init(const decor& items) {
     // Try to cache with a lookback of one since most models paint/place one
     // region/locset in direct succession. We also key on the stringy view of
     // expressions since in general equality is undecidable.
     std::string last_label = "";
     mextent last_region;
     mlocation_list last_locset;
-    for (const auto& [where, what]: decorations.paintings()) {
+    for (const auto& [where, what]: items.paintings()) {
         if (auto region = util::to_string(where); last_label != region) {
             last_label  = std::move(region);
-            last_region = thingify(where, provider);
+            last_region = thingify(where, base->provider);
         }
         std::visit([this, &last_region, &last_label] (auto&& what) { this->paint(last_region, last_label, what); }, what);
     }
-    for (const auto& [where, what, label]: decorations.placements()) {
+    for (const auto& [where, what, label]: items.placements()) {
         if (auto locset = util::to_string(where); last_label != locset) {
             last_label  = std::move(locset);
-            last_locset = thingify(where, provider);
+            last_locset = thingify(where, base->provider);
         }
         std::visit([this, &last_locset, &label=label] (auto&& what) { return this->place(last_locset, what, label); },
                    what);
     }
 }
 
-cable_cell::cable_cell(const arb::morphology& m, const decor& decorations, const label_dict& dictionary, const std::optional<cv_policy>& cvp):
-    impl_(make_impl(new cable_cell_impl(m, dictionary, decorations, cvp)))
+cable_cell::cable_cell(const arb::morphology& m,
+                       const decor& decorations,
+                       const label_dict& dictionary,
+                       const std::optional<cv_policy>& cvp,
+                       std::shared_ptr<thingify_cache> cache):
+    impl_(std::make_shared<cable_cell_impl>(m, dictionary, decorations, cvp, std::move(cache)))
 {}
 
-cable_cell::cable_cell(): impl_(make_impl(new cable_cell_impl())) {}
+cable_cell::cable_cell(const cable_cell& tmpl, const decor& delta, const parameter_scaling& scaling):
+    impl_(std::make_shared<cable_cell_impl>(*tmpl.impl_))
+{
+    impl_->extend(delta);
+    for (const auto& [mech, factors]: scaling) {
+        if (!impl_->densities_.count(mech)) {
+            throw cable_cell_error(util::pprintf("Scaling parameters of mechanism '{}', which is not painted on the cell", mech));
+        }
+        auto& scales = impl_->scales_[mech];
+        for (const auto& [param, factor]: factors) {
+            if (!std::isfinite(factor)) {
+                throw cable_cell_error(util::pprintf("Invalid factor {} on parameter '{}' of mechanism '{}'", factor, param, mech));
+            }
+            scales.try_emplace(param, 1.).first->second *= factor;
+        }
+    }
+}
 
-cable_cell::cable_cell(const cable_cell& other):
-    impl_(make_impl(new cable_cell_impl(*other.impl_)))
-{}
+cable_cell::cable_cell(): impl_(std::make_shared<cable_cell_impl>()) {}
 
-const label_dict& cable_cell::labels() const { return impl_->dictionary; }
-const concrete_embedding& cable_cell::embedding() const { return impl_->provider.embedding(); }
-const arb::morphology& cable_cell::morphology() const { return impl_->provider.morphology(); }
-const mprovider& cable_cell::provider() const { return impl_->provider; }
+const label_dict& cable_cell::labels() const { return impl_->base->dictionary; }
+const concrete_embedding& cable_cell::embedding() const { return impl_->base->provider.embedding(); }
+const arb::morphology& cable_cell::morphology() const { return impl_->base->provider.morphology(); }
+const mprovider& cable_cell::provider() const { return impl_->base->provider; }
 
 const region_assignment<density> cable_cell::densities() const { return impl_->densities_; }
 const region_assignment<voltage_process> cable_cell::voltage_processes() const { return impl_->voltage_processes_; }
@@ -272,6 +324,8 @@ const decor& cable_cell::decorations() const { return impl_->decorations; }
 
 const cable_cell_parameter_set& cable_cell::default_parameters() const { return impl_->decorations.defaults(); }
 
+const parameter_scaling& cable_cell::parameter_scales() const { return impl_->scales_; }
+
 //
 const cable_cell::lid_range_map& cable_cell::detector_ranges() const { return impl_->labeled_lid_ranges_[get_index_v<threshold_detector, placeable>]; }
 const cable_cell::lid_range_map& cable_cell::synapse_ranges() const { return impl_->labeled_lid_ranges_[get_index_v<synapse, placeable>]; }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <variant>
 #include <vector>
 
@@ -37,6 +38,14 @@ cable_cell_group::cable_cell_group(const std::vector<cell_gid_type>& gids,
     cg_targets = std::move(fvm_info.target_data);
 
     probe_map_ = std::move(fvm_info.probe_map);
+    adaptive_ = fvm_info.adaptive_timestep;
+
+    // Keep gap junction sites only if they can be coupled to other groups.
+    if (!fvm_info.gap_junction_cvs.empty()) {
+        junction_labels_ = std::move(fvm_info.gap_junction_data);
+        junction_cvs_ = std::move(fvm_info.gap_junction_cvs);
+        remote_junction_peers_ = std::move(fvm_info.remote_gap_junction_peers);
+    }
 
     // Create a list of the global identifiers for the spike sources
     for (auto source_gid: gids_) {
@@ -47,8 +56,16 @@ cable_cell_group::cable_cell_group(const std::vector<cell_gid_type>& gids,
     spike_sources_.shrink_to_fit();
 }
 
+void cable_cell_group::export_junctions(const std::vector<cell_member_type>& sites) {
+    std::vector<arb_size_type> cvs;
+    for (const auto& site: sites) cvs.push_back(junction_cvs_.at(site));
+    lowered_->export_voltages(cvs);
+}
+
 void cable_cell_group::reset() {
     spikes_.clear();
+    dt_step_ = 0;
+    dt_bound_ = 0;
 
     for (auto &entry: sampler_map_) {
         entry.second.sched.reset();
@@ -358,57 +375,145 @@ void run_samples(
     std::visit([&](auto& x) {run_samples(x, sc, raw_times, raw_samples, sample_records, scratch); }, sc.pdata_ptr->info);
 }
 
+std::vector<time_type> adaptive_timestep_bounds(const epoch& ep,
+                                                time_type& h,
+                                                time_type h_max,
+                                                const std::vector<time_type>& event_times,
+                                                const std::vector<time_type>& sample_times,
+                                                const adaptive_timestep_parameters& p) {
+    std::vector<time_type> bounds = {ep.t0};
+
+    const time_type h_min = std::min(p.dt_min, h_max);
+    h = std::min(std::max(h, h_min), h_max);
+
+    auto ev = event_times.begin();
+    auto sa = sample_times.begin();
+    for (time_type t = ep.t0; t<ep.t1;) {
+        // Restart with the smallest step after an event.
+        bool restart = false;
+        for (; ev!=event_times.end() && *ev<=t; ++ev) restart = true;
+        for (; sa!=sample_times.end() && *sa<=t; ++sa) {}
+        if (restart) h = h_min;
+
+        time_type next = ep.t1;
+        if (ev!=event_times.end()) next = std::min(next, *ev);
+        if (sa!=sample_times.end()) next = std::min(next, *sa);
+
+        // Stop at the next break point if it is less than a step away, or if
+        // stopping short would leave a sliver of less than half the minimum step.
+        t = next-t < h + 0.5*h_min? next: t+h;
+        bounds.push_back(t);
+        h = std::min(h*p.growth, h_max);
+    }
+    return bounds;
+}
+
 void cable_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange& event_lanes) {
     time_type tstart = lowered_->time();
 
-    // Bin and collate deliverable events from event lanes.
-    // Split epoch into equally sized timesteps (last timestep is chosen to match end of epoch)
-    timesteps_.reset(ep, dt);
-
-    PE(advance:samplesetup:clear);
-    sample_events_.resize(timesteps_.size());
-    for (auto& v: sample_events_) v.clear();
-    PL();
-
-    // Create sample events and delivery information.
-    //
-    // For each (schedule, sampler, probe set) in the sampler association
-    // map that will be triggered in this integration interval, create
-    // sample events for the lowered cell, one or more for each scheduled
-    // sample time and probe in the probe set.
-    //
-    // Each event is associated with an offset into the sample data and
-    // time buffers; these are assigned contiguously such that one call to
-    // a sampler callback can be represented by a `sampler_call_info`
-    // value as defined below, grouping together all the samples of the
-    // same probe for this callback in this association.
-
-    PE(advance:samplesetup);
-    std::vector<sampler_call_info> call_info;
-
-    sample_size_type n_samples = 0;
-    sample_size_type max_samples_per_call = 0;
-
+    // Query sample times for each sampler association that will be triggered
+    // in this integration interval. The times are copied, as the epoch may be
+    // integrated in several passes, during which the lock is not held.
+    struct sample_request {
+        sampler_function sampler;
+        std::vector<cell_address_type> probeset_ids;
+        std::vector<time_type> times;
+    };
+    PE(advance:samplesetup:schedule);
+    std::vector<sample_request> sample_requests;
+    std::unique_lock<std::mutex> guard(sampler_mex_, std::defer_lock);
     if (!sampler_map_.empty()) { // NOTE: We avoid the lock here as often as possible
         // SAFETY: We need the lock here, as _schedule_ is not reentrant.
-        std::lock_guard<std::mutex> guard(sampler_mex_);
+        guard.lock();
         for (auto& [sk, sa]: sampler_map_) {
             if (sa.probeset_ids.empty()) continue; // No need to make any schedule
-            auto sample_times = util::make_range(sa.sched.events(tstart, ep.t1));
-            sample_size_type n_times = sample_times.size();
-            if (n_times == 0) continue;
+            auto [first, last] = sa.sched.events(tstart, ep.t1);
+            if (first==last) continue;
+            sample_requests.push_back({sa.sampler, sa.probeset_ids, {first, last}});
+        }
+        guard.unlock();
+    }
+    PL();
+
+    std::vector<time_type> event_times, sample_breaks;
+    if (adaptive_) {
+        PE(advance:timesteps);
+        for (const auto& lane: event_lanes) {
+            for (const auto& ev: lane) event_times.push_back(ev.time);
+        }
+        for (const auto& req: sample_requests) {
+            sample_breaks.insert(sample_breaks.end(), req.times.begin(), req.times.end());
+        }
+        for (auto* v: {&event_times, &sample_breaks}) {
+            std::sort(v->begin(), v->end());
+            v->erase(std::unique(v->begin(), v->end()), v->end());
+        }
+        PL();
+    }
+
+    // With adaptive time stepping, the lowered cell stops early after a step
+    // that changed the voltage by more than the tolerance; the rest of the
+    // epoch is then planned again from there, bounded by the new estimate.
+    for (time_type t0 = tstart; t0<ep.t1; t0 = lowered_->time()) {
+        if (adaptive_) {
+            // Split the rest of the epoch into timesteps of varying length,
+            // with break points at all event and sample times.
+            PE(advance:timesteps);
+            std::vector<time_type> pending_events(std::lower_bound(event_times.begin(), event_times.end(), t0), event_times.end());
+            std::vector<time_type> pending_samples(std::upper_bound(sample_breaks.begin(), sample_breaks.end(), t0), sample_breaks.end());
+            const time_type h_max = dt_bound_>0? std::min(dt_bound_, dt): dt;
+            timesteps_.reset(adaptive_timestep_bounds(epoch(ep.id, t0, ep.t1), dt_step_, h_max, pending_events, pending_samples, *adaptive_));
+            PL();
+        }
+        else {
+            // Split epoch into equally sized timesteps (last timestep is chosen to match end of epoch)
+            timesteps_.reset(ep, dt);
+        }
+
+        PE(advance:samplesetup:clear);
+        sample_events_.resize(timesteps_.size());
+        for (auto& v: sample_events_) v.clear();
+        PL();
+
+        // Create sample events and delivery information.
+        //
+        // For each (schedule, sampler, probe set) in the sampler association
+        // map that will be triggered in this integration interval, create
+        // sample events for the lowered cell, one or more for each scheduled
+        // sample time and probe in the probe set.
+        //
+        // Each event is associated with an offset into the sample data and
+        // time buffers; these are assigned contiguously such that one call to
+        // a sampler callback can be represented by a `sampler_call_info`
+        // value as defined below, grouping together all the samples of the
+        // same probe for this callback in this association.
+
+        PE(advance:samplesetup);
+        std::vector<sampler_call_info> call_info;
+        std::vector<time_event_span> call_times;
+
+        sample_size_type n_samples = 0;
+        sample_size_type max_samples_per_call = 0;
+
+        for (const auto& req: sample_requests) {
+            const time_event_span times = {
+                std::lower_bound(req.times.data(), req.times.data() + req.times.size(), t0),
+                req.times.data() + req.times.size()};
+            sample_size_type n_times = times.second - times.first;
+            if (!n_times) continue;
             max_samples_per_call = std::max(max_samples_per_call, n_times);
-            for (const auto& pid: sa.probeset_ids) {
+            for (const auto& pid: req.probeset_ids) {
                 unsigned index = 0;
                 for (const auto& pdata: probe_map_.data_on(pid)) {
-                    call_info.push_back({sa.sampler,
+                    call_info.push_back({req.sampler,
                                          pid,
                                          index,
                                          pdata,
                                          n_samples,
                                          n_samples + n_times*pdata->n_raw()});
+                    call_times.push_back(times);
                     index++;
-                    for (auto t: sample_times) {
+                    for (auto t: util::make_range(times)) {
                         auto it = timesteps_.find(t);
                         arb_assert(it != timesteps_.end());
                         const auto timestep_index = it - timesteps_.begin();
@@ -421,35 +526,57 @@ void cable_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange
             }
             arb_assert(n_samples==call_info.back().end_offset);
         }
-    }
-    PL();
+        PL();
+
+        // Run integration and collect samples, spikes.
+        auto result = lowered_->integrate(timesteps_, event_lanes, sample_events_);
+        const time_type t1 = lowered_->time();
+
+        if (adaptive_) {
+            // Bound the step length such that the voltage changes by about
+            // dv_max per step, estimated from the last step taken.
+            const auto rate = result.voltage_rate;
+            dt_bound_ = rate>0? 0.9*adaptive_->dv_max/rate: dt;
+            dt_bound_ = std::max(dt_bound_, adaptive_->dt_min);
+            dt_step_ = std::min(dt_step_, dt_bound_);
+        }
 
-    // Run integration and collect samples, spikes.
-    auto result = lowered_->integrate(timesteps_, event_lanes, sample_events_);
+        // If integration stopped early, only the samples before the stop have
+        // been taken; the others are staged again in the next pass.
+        if (t1<ep.t1) {
+            for (auto i: util::count_along(call_info)) {
+                auto& sc = call_info[i];
+                const auto& [first, last] = call_times[i];
+                sample_size_type n_taken = std::lower_bound(first, last, t1) - first;
+                sc.end_offset = sc.begin_offset + n_taken*sc.pdata_ptr->n_raw();
+            }
+        }
 
-    // For each sampler callback registered in `call_info`, construct the
-    // vector of sample entries from the lowered cell sample times and values
-    // and then call the callback.
+        // For each sampler callback registered in `call_info`, construct the
+        // vector of sample entries from the lowered cell sample times and values
+        // and then call the callback.
 
-    PE(advance:sampledeliver);
-    std::vector<sample_record> sample_records;
-    sample_records.reserve(max_samples_per_call);
+        PE(advance:sampledeliver);
+        std::vector<sample_record> sample_records;
+        sample_records.reserve(max_samples_per_call);
 
-    fvm_probe_scratch scratch;
-    reserve_scratch(scratch, max_samples_per_call);
+        fvm_probe_scratch scratch;
+        reserve_scratch(scratch, max_samples_per_call);
 
-    for (auto& sc: call_info) {
-        run_samples(sc, result.sample_time.data(), result.sample_value.data(), sample_records, scratch);
-    }
-    PL();
+        for (auto& sc: call_info) {
+            if (sc.begin_offset==sc.end_offset) continue;
+            run_samples(sc, result.sample_time.data(), result.sample_value.data(), sample_records, scratch);
+        }
+        PL();
 
-    // Copy out spike voltage threshold crossings from the back end, then
-    // generate spikes with global spike source ids. The threshold crossings
-    // record the local spike source index, which must be converted to a
-    // global index for spike communication.
+        // Copy out spike voltage threshold crossings from the back end, then
+        // generate spikes with global spike source ids. The threshold crossings
+        // record the local spike source index, which must be converted to a
+        // global index for spike communication.
 
-    for (auto c: result.crossings) {
-        spikes_.emplace_back(spike_sources_[c.index], time_type(c.time));
+        for (auto c: result.crossings) {
+            spikes_.emplace_back(spike_sources_[c.index], time_type(c.time));
+        }
     }
 }
 
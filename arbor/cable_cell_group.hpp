@@ -1,9 +1,12 @@
 #pragma once
 
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <arbor/export.hpp>
+#include <arbor/cable_cell_param.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/sampling.hpp>
@@ -18,6 +21,18 @@
 
 namespace arb {
 
+// Step boundaries of the epoch `ep` for adaptive time stepping.
+//
+// The first step has length `h`, and each subsequent step is `p.growth` times longer,
+// up to `h_max`. Steps are split at the sorted `event_times` and `sample_times`,
+// and restart at `p.dt_min` after each event time. On return, `h` holds the step
+// length to continue with in the next epoch.
+ARB_ARBOR_API std::vector<time_type> adaptive_timestep_bounds(const epoch& ep,
+                                                              time_type& h,
+                                                              time_type h_max,
+                                                              const std::vector<time_type>& event_times,
+                                                              const std::vector<time_type>& sample_times,
+                                                              const adaptive_timestep_parameters& p);
 
 struct ARB_ARBOR_API cable_cell_group: public cell_group {
     cable_cell_group() = default;
@@ -46,7 +61,15 @@ struct ARB_ARBOR_API cable_cell_group: public cell_group {
 
     std::vector<probe_metadata> get_probe_metadata(const cell_address_type&) const override;
 
-    ARB_SERDES_ENABLE(cable_cell_group, gids_, spikes_, lowered_);
+    std::vector<mechanism_counters> get_mechanism_counters() const override { return lowered_->get_mechanism_counters(); }
+
+    cell_label_range junction_labels() const override { return junction_labels_; }
+    std::vector<cell_global_label_type> remote_junction_peers() const override { return remote_junction_peers_; }
+    void export_junctions(const std::vector<cell_member_type>& sites) override;
+    std::vector<arb_value_type> junction_voltages() const override { return lowered_->exported_voltages(); }
+    void set_remote_junction_voltages(const std::vector<arb_value_type>& values) override { lowered_->set_remote_peer_voltages(values); }
+
+    ARB_SERDES_ENABLE(cable_cell_group, gids_, spikes_, lowered_, dt_step_, dt_bound_);
 
     void t_serialize(serializer& ser, const std::string& k) const override;
     void t_deserialize(serializer& ser, const std::string& k) override;
@@ -66,6 +89,13 @@ private:
     // Range of timesteps within current epoch
     timestep_range timesteps_;
 
+    // Adaptive time stepping, if enabled: the step length to continue with and
+    // the bound on the step length from the error estimate of the last step
+    // taken; zero if not yet known.
+    std::optional<adaptive_timestep_parameters> adaptive_;
+    time_type dt_step_ = 0;
+    time_type dt_bound_ = 0;
+
     // List of samples to be taken
     std::vector<std::vector<sample_event>> sample_events_;
 
@@ -77,6 +107,12 @@ private:
 
     // Mutex for thread-safe access to sampler associations.
     std::mutex sampler_mex_;
+
+    // Gap junctions coupled across cell groups, if enabled: labels and CVs of
+    // the junction sites and peers in other groups.
+    cell_label_range junction_labels_;
+    std::unordered_map<cell_member_type, arb_size_type> junction_cvs_;
+    std::vector<cell_global_label_type> remote_junction_peers_;
 };
 
 } // namespace arb
@@ -52,6 +52,24 @@ ARB_ARBOR_API void check_global_properties(const cable_cell_global_properties& G
             throw cable_cell_error("missing init_reversal_potential or reversal_potential_method for ion "+ion);
         }
     }
+
+    if (auto& adapt = G.adaptive_timestep) {
+        if (!(adapt->dv_max > 0)) {
+            throw cable_cell_error("adaptive time step: dv_max must be positive");
+        }
+        if (!(adapt->dt_min > 0)) {
+            throw cable_cell_error("adaptive time step: dt_min must be positive");
+        }
+        if (!(adapt->growth >= 1)) {
+            throw cable_cell_error("adaptive time step: growth must be at least 1");
+        }
+    }
+
+    if (auto& t = G.gap_junction_coupling_interval) {
+        if (!(*t > 0) || !std::isfinite(*t)) {
+            throw cable_cell_error("gap junction coupling interval must be positive and finite");
+        }
+    }
 }
 
 cable_cell_parameter_set neuron_parameter_defaults = {
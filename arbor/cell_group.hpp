@@ -3,7 +3,9 @@
 #include <memory>
 #include <vector>
 
+#include <arbor/arb_types.hpp>
 #include <arbor/common_types.hpp>
+#include <arbor/mechanism_counters.hpp>
 #include <arbor/sampling.hpp>
 #include <arbor/schedule.hpp>
 #include <arbor/spike.hpp>
@@ -11,6 +13,7 @@
 
 #include "epoch.hpp"
 #include "event_lane.hpp"
+#include "label_resolution.hpp"
 
 // The specialized cell_group constructors are expected to accept at least:
 // - The gid vector of the cells belonging to the cell_group.
@@ -43,6 +46,22 @@ public:
     // also be thread-safe.
 
     virtual std::vector<probe_metadata> get_probe_metadata(const cell_address_type&) const { return {}; }
+
+    // Runtime counters of the mechanism instances in the group, if any.
+    virtual std::vector<mechanism_counters> get_mechanism_counters() const { return {}; }
+
+    // Gap junctions coupled across cell groups, see gap_junction_exchange.
+    //
+    // Groups with coupled gap junctions report the labels of the junction
+    // sites on their cells, and the peers on cells in other groups, one per
+    // remote peer voltage slot. They export the voltages at the sites chosen
+    // with export_junctions, and take those of their remote peers.
+    virtual cell_label_range junction_labels() const { return {}; }
+    virtual std::vector<cell_global_label_type> remote_junction_peers() const { return {}; }
+    virtual void export_junctions(const std::vector<cell_member_type>&) {}
+    virtual std::vector<arb_value_type> junction_voltages() const { return {}; }
+    virtual void set_remote_junction_voltages(const std::vector<arb_value_type>&) {}
+
     // trampolines for serialization
     virtual void t_serialize(serializer& s, const std::string&) const = 0;
     virtual void t_deserialize(serializer& s, const std::string&)  = 0;
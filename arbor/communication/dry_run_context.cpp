@@ -70,6 +70,61 @@ struct dry_run_context_impl {
         return gathered_vector<cell_gid_type>(std::move(gathered_gids), std::move(partition));
     }
 
+    gathered_vector<arb_value_type>
+    gather_values(const std::vector<arb_value_type>& local_values) const {
+        count_type local_size = local_values.size();
+
+        std::vector<arb_value_type> gathered_values;
+        gathered_values.reserve(local_size*num_ranks_);
+        for (count_type i = 0; i < num_ranks_; i++) {
+            util::append(gathered_values, local_values);
+        }
+
+        std::vector<count_type> partition;
+        for (count_type i = 0; i <= num_ranks_; i++) {
+            partition.push_back(i*local_size);
+        }
+
+        return gathered_vector<arb_value_type>(std::move(gathered_values), std::move(partition));
+    }
+
+    gathered_vector<cell_member_type>
+    gather_cell_members(const std::vector<cell_member_type>& local_members) const {
+        count_type local_size = local_members.size();
+
+        std::vector<cell_member_type> gathered_members;
+        gathered_members.reserve(local_size*num_ranks_);
+
+        for (count_type i = 0; i < num_ranks_; i++) {
+            util::append(gathered_members, local_members);
+        }
+
+        for (count_type i = 0; i < num_ranks_; i++) {
+            for (count_type j = i*local_size; j < (i+1)*local_size; j++){
+                gathered_members[j].gid += num_cells_per_tile_*i;
+            }
+        }
+
+        std::vector<count_type> partition;
+        for (count_type i = 0; i <= num_ranks_; i++) {
+            partition.push_back(i*local_size);
+        }
+
+        return gathered_vector<cell_member_type>(std::move(gathered_members), std::move(partition));
+    }
+
+    std::vector<arb_value_type>
+    max_values(const std::vector<arb_value_type>& local_values) const {
+        return local_values;
+    }
+
+    std::vector<arb_value_type>
+    sum_values(const std::vector<arb_value_type>& local_values) const {
+        auto result = local_values;
+        for (auto& v: result) v *= num_ranks_;
+        return result;
+    }
+
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const {
         cell_label_range global_ranges;
         for (unsigned i = 0; i < num_ranks_; i++) {
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <any>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <arbor/cable_cell_param.hpp>
+#include <arbor/common_types.hpp>
+#include <arbor/domain_decomposition.hpp>
+#include <arbor/recipe.hpp>
+
+#include "distributed_context.hpp"
+#include "execution_context.hpp"
+#include "label_resolution.hpp"
+#include "profile/profiler_macro.hpp"
+#include "threading/threading.hpp"
+#include "util/rangeutil.hpp"
+#include "util/span.hpp"
+
+#include "communication/gap_junction_exchange.hpp"
+
+namespace arb {
+
+ARB_ARBOR_API std::optional<time_type> gap_junction_coupling_interval(const recipe& rec) {
+    auto props = rec.get_global_properties(cell_kind::cable);
+    if (auto p = std::any_cast<cable_cell_global_properties>(&props)) return p->gap_junction_coupling_interval;
+    return std::nullopt;
+}
+
+gap_junction_exchange::gap_junction_exchange(const domain_decomposition& dom_dec,
+                                             const std::vector<cell_group_ptr>& groups,
+                                             context ctx):
+    ctx_(std::move(ctx))
+{
+    const auto& dist = ctx_->distributed;
+    const auto num_groups = groups.size();
+
+    // Resolve the remote peers of each group against the junction labels of
+    // the cells of all groups on all domains.
+    cell_labels_and_gids local_labels;
+    for (auto i: util::make_span(num_groups)) {
+        auto labels = groups[i]->junction_labels();
+        if (!labels.sizes.empty()) local_labels.append({std::move(labels), dom_dec.group(i).gids});
+    }
+    label_resolution_map label_map(dist->gather_cell_labels_and_gids(local_labels));
+
+    std::vector<std::vector<cell_member_type>> peers(num_groups);
+    std::vector<cell_member_type> wanted;
+    for (auto i: util::make_span(num_groups)) {
+        auto peer_resolver = resolver(&label_map);
+        for (const auto& peer: groups[i]->remote_junction_peers()) {
+            cell_member_type site{peer.gid, peer_resolver.resolve(peer)};
+            peers[i].push_back(site);
+            wanted.push_back(site);
+        }
+    }
+
+    // All sites wanted by any group, ordered by the domain they live on, such
+    // that the voltages exported by each domain in this order, and gathered in
+    // order of domains, line up with the sites.
+    auto site_order = [&](const cell_member_type& site) {
+        return std::make_tuple(dom_dec.gid_domain(site.gid), site.gid, site.index);
+    };
+    auto sites = dist->gather_cell_members(wanted).values();
+    util::sort_by(sites, site_order);
+    sites.erase(std::unique(sites.begin(), sites.end()), sites.end());
+    num_sites_ = sites.size();
+    if (sites.empty()) return;
+
+    // Export the local sites, in order, each from its group.
+    std::unordered_map<cell_gid_type, std::size_t> group_of;
+    for (auto i: util::make_span(num_groups)) {
+        for (auto gid: dom_dec.group(i).gids) group_of[gid] = i;
+    }
+
+    export_pos_.resize(num_groups);
+    std::vector<std::vector<cell_member_type>> exports(num_groups);
+    for (const auto& site: sites) {
+        if (dom_dec.gid_domain(site.gid) != dom_dec.domain_id()) continue;
+        auto i = group_of.at(site.gid);
+        exports[i].push_back(site);
+        export_pos_[i].push_back(num_local_sites_++);
+    }
+    for (auto i: util::make_span(num_groups)) groups[i]->export_junctions(exports[i]);
+
+    // Import the peers of each group from the gathered sites.
+    import_pos_.resize(num_groups);
+    for (auto i: util::make_span(num_groups)) {
+        for (const auto& site: peers[i]) {
+            auto it = std::lower_bound(sites.begin(), sites.end(), site,
+                                       [&](const auto& l, const auto& r) { return site_order(l) < site_order(r); });
+            import_pos_[i].push_back(it - sites.begin());
+        }
+    }
+}
+
+void gap_junction_exchange::exchange(const std::vector<cell_group_ptr>& groups) {
+    if (!num_sites_) return;
+    auto pool = ctx_->thread_pool.get();
+
+    PE(communication:gapjunctions:export);
+    std::vector<arb_value_type> local(num_local_sites_);
+    threading::parallel_for::apply(0, groups.size(), pool,
+        [&](int i) {
+            if (export_pos_[i].empty()) return;
+            auto values = groups[i]->junction_voltages();
+            for (auto j: util::count_along(values)) local[export_pos_[i][j]] = values[j];
+        });
+    PL();
+
+    PE(communication:gapjunctions:gather);
+    auto global = ctx_->distributed->gather_values(local);
+    PL();
+
+    PE(communication:gapjunctions:import);
+    const auto& values = global.values();
+    threading::parallel_for::apply(0, groups.size(), pool,
+        [&](int i) {
+            if (import_pos_[i].empty()) return;
+            std::vector<arb_value_type> peer_values;
+            peer_values.reserve(import_pos_[i].size());
+            for (auto pos: import_pos_[i]) peer_values.push_back(values[pos]);
+            groups[i]->set_remote_junction_voltages(peer_values);
+        });
+    PL();
+}
+
+} // namespace arb
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <arbor/common_types.hpp>
+#include <arbor/context.hpp>
+#include <arbor/domain_decomposition.hpp>
+#include <arbor/export.hpp>
+#include <arbor/recipe.hpp>
+
+#include "cell_group.hpp"
+#include "execution_context.hpp"
+
+namespace arb {
+
+// The interval at which gap junctions are coupled across cell groups, as set
+// in the cable cell global properties of the recipe; unset if gap junction
+// peers must share a cell group.
+ARB_ARBOR_API std::optional<time_type> gap_junction_coupling_interval(const recipe& rec);
+
+// Exchange of voltages between gap junction sites on cells in different cell
+// groups, on this and on other domains.
+//
+// Each cell group holds a voltage slot for every peer of its gap junctions that
+// lies in another group. On construction, these peers are resolved against the
+// junction labels of all cells, and each domain is told which of its sites are
+// needed anywhere. exchange() then gathers the voltages at those sites from all
+// domains and copies them into the peer slots; in between, the peer voltages
+// are held constant.
+class ARB_ARBOR_API gap_junction_exchange {
+public:
+    gap_junction_exchange() = default;
+
+    gap_junction_exchange(const domain_decomposition& dom_dec,
+                          const std::vector<cell_group_ptr>& groups,
+                          context ctx);
+
+    // Copy the current voltages at all exported sites into the peer slots.
+    void exchange(const std::vector<cell_group_ptr>& groups);
+
+    // The number of sites exported by all domains.
+    std::size_t num_sites() const { return num_sites_; }
+
+private:
+    context ctx_;
+    std::size_t num_sites_ = 0;
+
+    // Per local cell group: the positions of the group's exported voltages
+    // in the local export buffer, and of its peer voltages in the gathered
+    // voltages of all domains.
+    std::size_t num_local_sites_ = 0;
+    std::vector<std::vector<std::size_t>> export_pos_;
+    std::vector<std::vector<std::size_t>> import_pos_;
+};
+
+} // namespace arb
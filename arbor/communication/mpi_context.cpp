@@ -54,6 +54,26 @@ struct mpi_context_impl {
         return mpi::gather_all_with_partition(local_gids, comm_);
     }
 
+    gathered_vector<arb_value_type>
+    gather_values(const std::vector<arb_value_type>& local_values) const {
+        return mpi::gather_all_with_partition(local_values, comm_);
+    }
+
+    gathered_vector<cell_member_type>
+    gather_cell_members(const std::vector<cell_member_type>& local_members) const {
+        return mpi::gather_all_with_partition(local_members, comm_);
+    }
+
+    std::vector<arb_value_type>
+    max_values(const std::vector<arb_value_type>& local_values) const {
+        return mpi::reduce(local_values, MPI_MAX, comm_);
+    }
+
+    std::vector<arb_value_type>
+    sum_values(const std::vector<arb_value_type>& local_values) const {
+        return mpi::reduce(local_values, MPI_SUM, comm_);
+    }
+
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const {
         cell_label_range res;
         res.sizes  = mpi::gather_all(local_ranges.sizes, comm_);
@@ -192,6 +212,18 @@ struct remote_context_impl {
     gathered_vector<cell_gid_type>
     gather_gids(const std::vector<cell_gid_type>& local_gids) const { return mpi_.gather_gids(local_gids); }
 
+    gathered_vector<arb_value_type>
+    gather_values(const std::vector<arb_value_type>& local_values) const { return mpi_.gather_values(local_values); }
+
+    gathered_vector<cell_member_type>
+    gather_cell_members(const std::vector<cell_member_type>& local_members) const { return mpi_.gather_cell_members(local_members); }
+
+    std::vector<arb_value_type>
+    max_values(const std::vector<arb_value_type>& local_values) const { return mpi_.max_values(local_values); }
+
+    std::vector<arb_value_type>
+    sum_values(const std::vector<arb_value_type>& local_values) const { return mpi_.sum_values(local_values); }
+
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const {
         return mpi_.gather_cell_label_range(local_ranges);
     }
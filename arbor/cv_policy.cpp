@@ -1,9 +1,13 @@
+#include <cmath>
 #include <utility>
 #include <ostream>
+#include <stdexcept>
 #include <vector>
 
 #include <arbor/cable_cell.hpp>
+#include <arbor/cable_cell_param.hpp>
 #include <arbor/cv_policy.hpp>
+#include <arbor/math.hpp>
 #include <arbor/morph/locset.hpp>
 #include <arbor/morph/region.hpp>
 
@@ -128,6 +132,114 @@ ARB_ARBOR_API cv_policy cv_policy_max_extent(double ext, cv_policy_flag flag) {
     return cv_policy{cvp_cv_policy_max_extent{ext, reg::all(), flag}};
 }
 
+struct cvp_cv_policy_d_lambda {
+    double frequency_; // [Hz]
+    double d_lambda_;
+    region domain_;
+    cv_policy_flag flags_;
+
+    std::ostream& format(std::ostream& os) const {
+        os << "(d-lambda " << frequency_ << ' ' << d_lambda_ << ' ' << domain_ << ' ' << print_flag(flags_) << ')';
+        return os;
+    }
+
+    // Value of a painted parameter at a location, or `dflt` if not painted there.
+    template <typename T>
+    static double value_at(const mcable_map<T>& painted, mlocation loc, double dflt) {
+        for (const auto& [cable, p]: painted) {
+            if (cable.branch==loc.branch && cable.prox_pos<=loc.pos && loc.pos<=cable.dist_pos) {
+                return p.value*p.scale.get_scalar().value_or(1.);
+            }
+        }
+        return dflt;
+    }
+
+    locset cv_boundary_points(const cable_cell& cell) const {
+        const unsigned nbranch = cell.morphology().num_branches();
+        const auto& embed = cell.embedding();
+        if (!nbranch) return ls::nil();
+
+        // Global properties are not visible here; fall back to NEURON's defaults
+        // where the cell sets neither painted nor default values.
+        const auto& dflt = cell.default_parameters();
+        double ra_dflt = dflt.axial_resistivity.value_or(*neuron_parameter_defaults.axial_resistivity);
+        double cm_dflt = dflt.membrane_capacitance.value_or(*neuron_parameter_defaults.membrane_capacitance);
+        const auto ra = cell.axial_resistivities();
+        const auto cm = cell.membrane_capacitances();
+
+        auto add_cuts = [](std::vector<double>& cuts, const mcable& c, double pos) {
+            if (pos>c.prox_pos && pos<c.dist_pos) cuts.push_back(pos);
+        };
+
+        std::vector<mlocation> points;
+        auto comps = components(cell.morphology(), thingify(domain_, cell.provider()));
+
+        for (auto& comp: comps) {
+            for (mcable c: comp) {
+                // Electrotonic length of the cable at the given frequency, summed
+                // over pieces of constant parameters and linear radius.
+                std::vector<double> cuts = {c.prox_pos, c.dist_pos};
+                for (const auto& l: embed.segment_ends()) {
+                    if (l.branch==c.branch) add_cuts(cuts, c, l.pos);
+                }
+                for (const auto& [cable, _]: ra) {
+                    if (cable.branch==c.branch) { add_cuts(cuts, c, cable.prox_pos); add_cuts(cuts, c, cable.dist_pos); }
+                }
+                for (const auto& [cable, _]: cm) {
+                    if (cable.branch==c.branch) { add_cuts(cuts, c, cable.prox_pos); add_cuts(cuts, c, cable.dist_pos); }
+                }
+                util::sort(cuts);
+
+                double electrotonic_length = 0;
+                for (unsigned i = 1; i<cuts.size(); ++i) {
+                    if (cuts[i]==cuts[i-1]) continue;
+                    mlocation mid{c.branch, (cuts[i-1]+cuts[i])/2};
+                    double diam = 2*embed.radius(mid);                    // [µm]
+                    double r = value_at(ra, mid, ra_dflt);                // [Ω·cm]
+                    double m = 100*value_at(cm, mid, cm_dflt);            // [µF/cm²]
+                    // Length constant [µm] at frequency_.
+                    double lambda = 1e5*std::sqrt(diam/(4*math::pi<double>*frequency_*r*m));
+                    if (lambda>0) {
+                        electrotonic_length += embed.integrate_length(mlocation{c.branch, cuts[i-1]}, mlocation{c.branch, cuts[i]})/lambda;
+                    }
+                }
+
+                // As in NEURON, use an odd number of CVs such that each is at
+                // most d_lambda length constants long.
+                unsigned ncv = 2*unsigned((electrotonic_length/d_lambda_+0.9)/2)+1;
+                double scale = (c.dist_pos-c.prox_pos)/ncv;
+
+                if (has_flag(flags_, cv_policy_flag::interior_forks)) {
+                    for (unsigned i = 0; i<ncv; ++i) {
+                        points.push_back({c.branch, c.prox_pos+(1+2*i)*scale/2});
+                    }
+                }
+                else {
+                    for (unsigned i = 0; i<ncv; ++i) {
+                        points.push_back({c.branch, c.prox_pos+i*scale});
+                    }
+                    points.push_back({c.branch, c.dist_pos});
+                }
+            }
+        }
+
+        util::sort(points);
+        return unique_sum(locset(std::move(points)), ls::cboundary(domain_));
+    }
+
+    region domain() const { return domain_; }
+};
+
+ARB_ARBOR_API cv_policy cv_policy_d_lambda(double frequency, double d_lambda, region reg, cv_policy_flag flag) {
+    if (!(frequency>0) || !std::isfinite(frequency)) throw std::domain_error("d-lambda CV policy: frequency must be positive and finite.");
+    if (!(d_lambda>0) || !std::isfinite(d_lambda)) throw std::domain_error("d-lambda CV policy: d_lambda must be positive and finite.");
+    return cv_policy{cvp_cv_policy_d_lambda{frequency, d_lambda, std::move(reg), flag}};
+}
+
+ARB_ARBOR_API cv_policy cv_policy_d_lambda(double frequency, double d_lambda, cv_policy_flag flag) {
+    return cv_policy_d_lambda(frequency, d_lambda, reg::all(), flag);
+}
+
 struct cvp_cv_policy_explicit {
     locset locs_;
     region domain_;
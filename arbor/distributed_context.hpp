@@ -4,6 +4,7 @@
 #include <string>
 #include <cstring>
 
+#include <arbor/arb_types.hpp>
 #include <arbor/export.hpp>
 #include <arbor/context.hpp>
 #include <arbor/spike.hpp>
@@ -101,6 +102,23 @@ public:
         return impl_->gather_gids(local_gids);
     }
 
+    gathered_vector<arb_value_type> gather_values(const std::vector<arb_value_type>& local_values) const {
+        return impl_->gather_values(local_values);
+    }
+
+    gathered_vector<cell_member_type> gather_cell_members(const std::vector<cell_member_type>& local_members) const {
+        return impl_->gather_cell_members(local_members);
+    }
+
+    // Element-wise maximum and sum over all ranks of vectors of equal length.
+    std::vector<arb_value_type> max_values(const std::vector<arb_value_type>& local_values) const {
+        return impl_->max_values(local_values);
+    }
+
+    std::vector<arb_value_type> sum_values(const std::vector<arb_value_type>& local_values) const {
+        return impl_->sum_values(local_values);
+    }
+
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const {
         return impl_->gather_cell_label_range(local_ranges);
     }
@@ -163,6 +181,14 @@ private:
         remote_gather_spikes(const spike_vector& local_spikes) const = 0;
         virtual gathered_vector<cell_gid_type>
         gather_gids(const gid_vector& local_gids) const = 0;
+        virtual gathered_vector<arb_value_type>
+        gather_values(const std::vector<arb_value_type>& local_values) const = 0;
+        virtual gathered_vector<cell_member_type>
+        gather_cell_members(const std::vector<cell_member_type>& local_members) const = 0;
+        virtual std::vector<arb_value_type>
+        max_values(const std::vector<arb_value_type>& local_values) const = 0;
+        virtual std::vector<arb_value_type>
+        sum_values(const std::vector<arb_value_type>& local_values) const = 0;
         virtual cell_label_range
         gather_cell_label_range(const cell_label_range& local_ranges) const = 0;
         virtual cell_labels_and_gids
@@ -205,6 +231,22 @@ private:
         gather_gids(const gid_vector& local_gids) const override {
             return wrapped.gather_gids(local_gids);
         }
+        gathered_vector<arb_value_type>
+        gather_values(const std::vector<arb_value_type>& local_values) const override {
+            return wrapped.gather_values(local_values);
+        }
+        gathered_vector<cell_member_type>
+        gather_cell_members(const std::vector<cell_member_type>& local_members) const override {
+            return wrapped.gather_cell_members(local_members);
+        }
+        std::vector<arb_value_type>
+        max_values(const std::vector<arb_value_type>& local_values) const override {
+            return wrapped.max_values(local_values);
+        }
+        std::vector<arb_value_type>
+        sum_values(const std::vector<arb_value_type>& local_values) const override {
+            return wrapped.sum_values(local_values);
+        }
         cell_label_range
         gather_cell_label_range(const cell_label_range& local_ranges) const override {
             return wrapped.gather_cell_label_range(local_ranges);
@@ -272,6 +314,30 @@ struct local_context {
                 {0u, static_cast<count_type>(local_gids.size())}
         );
     }
+    gathered_vector<arb_value_type>
+    gather_values(const std::vector<arb_value_type>& local_values) const {
+        using count_type = typename gathered_vector<arb_value_type>::count_type;
+        return gathered_vector<arb_value_type>(
+                std::vector<arb_value_type>(local_values),
+                {0u, static_cast<count_type>(local_values.size())}
+        );
+    }
+    gathered_vector<cell_member_type>
+    gather_cell_members(const std::vector<cell_member_type>& local_members) const {
+        using count_type = typename gathered_vector<cell_member_type>::count_type;
+        return gathered_vector<cell_member_type>(
+                std::vector<cell_member_type>(local_members),
+                {0u, static_cast<count_type>(local_members.size())}
+        );
+    }
+    std::vector<arb_value_type>
+    max_values(const std::vector<arb_value_type>& local_values) const {
+        return local_values;
+    }
+    std::vector<arb_value_type>
+    sum_values(const std::vector<arb_value_type>& local_values) const {
+        return local_values;
+    }
     void remote_ctrl_send_continue(const epoch&) const {}
     void remote_ctrl_send_done() const {}
     cell_label_range
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <arbor/domdecexcept.hpp>
 #include <arbor/recipe.hpp>
 
+#include "communication/gap_junction_exchange.hpp"
 #include "execution_context.hpp"
 #include "util/partition.hpp"
 #include "util/rangeutil.hpp"
@@ -22,6 +24,7 @@ domain_decomposition::domain_decomposition(const recipe& rec,
     int domain_id = dist->id();
     cell_size_type num_global_cells = rec.num_cells();
     const bool has_gpu = ctx->gpu->has_gpu();
+    const bool gj_coupled = gap_junction_coupling_interval(rec).has_value();
 
     std::vector<cell_gid_type> local_gids;
     for (const auto& g: groups) {
@@ -31,6 +34,7 @@ domain_decomposition::domain_decomposition(const recipe& rec,
         std::unordered_set<cell_gid_type> gid_set(g.gids.begin(), g.gids.end());
         for (const auto& gid: g.gids) {
             if (gid >= num_global_cells) throw out_of_bounds(gid, num_global_cells);
+            if (gj_coupled) continue;
             for (const auto& gj: rec.gap_junctions_on(gid)) {
                 if (!gid_set.count(gj.peer.gid)) throw invalid_gj_cell_group(gid, gj.peer.gid);
             }
@@ -39,13 +43,45 @@ domain_decomposition::domain_decomposition(const recipe& rec,
     }
     cell_size_type num_local_cells = local_gids.size();
 
-    auto global_gids = dist->gather_gids(local_gids);
-    if (global_gids.size() != num_global_cells) throw invalid_sum_local_cells(global_gids.size(), num_global_cells);
+    // Exchange the local gids as runs [first, last) of consecutive gids in
+    // the order of the groups, rather than the gids themselves.
+    std::vector<cell_gid_type> local_runs;
+    for (auto gid: local_gids) {
+        if (!local_runs.empty() && gid == local_runs.back()) {
+            ++local_runs.back();
+        }
+        else {
+            local_runs.push_back(gid);
+            local_runs.push_back(gid + 1);
+        }
+    }
+    auto global_runs = dist->gather_gids(local_runs);
+
+    // write tables gid -> (rank, offset) as runs
+    struct run { cell_gid_type start; int domain; cell_size_type index; cell_size_type size; };
+    std::vector<run> runs;
+    std::size_t num_cells = 0;
+    auto rank_part = util::partition_view(global_runs.partition());
+    for (auto rank: count_along(rank_part)) {
+        cell_size_type index_on_domain = 0;
+        auto rank_runs = util::subrange_view(global_runs.values(), rank_part[rank]);
+        for (std::size_t i = 0; i + 1 < rank_runs.size(); i += 2) {
+            auto size = rank_runs[i+1] - rank_runs[i];
+            runs.push_back({rank_runs[i], (int)rank, index_on_domain, size});
+            index_on_domain += size;
+        }
+        num_cells += index_on_domain;
+    }
+    if (num_cells != num_global_cells) throw invalid_sum_local_cells(num_cells, num_global_cells);
 
-    auto global_gid_vals = global_gids.values();
-    util::sort(global_gid_vals);
-    for (unsigned i = 1; i < global_gid_vals.size(); ++i) {
-        if (global_gid_vals[i] == global_gid_vals[i-1]) throw duplicate_gid(global_gid_vals[i]);
+    util::sort_by(runs, [](const auto& r) { return r.start; });
+
+    // Runs must not overlap; together with the count above, they then cover
+    // [0, num_global_cells) exactly.
+    cell_gid_type covered = 0;
+    for (const auto& r: runs) {
+        if (r.start < covered) throw duplicate_gid(r.start);
+        covered = std::max<cell_gid_type>(covered, r.start + r.size);
     }
 
     num_domains_ = num_domains;
@@ -54,18 +90,43 @@ domain_decomposition::domain_decomposition(const recipe& rec,
     num_global_cells_ = num_global_cells;
     groups_ = groups;
 
-    // write tables gid -> (rank, offset)
-    gid_domain_.resize(global_gids.size());
-    gid_index_.resize(global_gids.size());
-    auto rank_part = util::partition_view(global_gids.partition());
-    for (auto rank: count_along(rank_part)) {
-        cell_size_type index_on_domain = 0;
-        for (auto gid: util::subrange_view(global_gids.values(), rank_part[rank])) {
-            gid_domain_[gid] = rank;
-            gid_index_[gid] = index_on_domain;
-            ++index_on_domain;
+    // Join runs continued on the same domain by another run.
+    std::size_t n_run = 0;
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        if (n_run) {
+            const auto& prev = runs[n_run-1];
+            const auto& cur = runs[i];
+            if (prev.domain == cur.domain && cur.index - prev.index == cur.start - prev.start) continue;
         }
+        runs[n_run++] = runs[i];
+    }
+    runs.resize(n_run);
+
+    for (const auto& r: runs) {
+        run_start_.push_back(r.start);
+        run_domain_.push_back(r.domain);
+        run_index_.push_back(r.index);
+    }
+
+    // The runs cover [0, num_global_cells); check for regular blocks.
+    if (n_run) {
+        run_size_ = num_global_cells/n_run;
+        run_extra_ = num_global_cells - n_run*run_size_;
+        regular_runs_ = true;
+        for (cell_size_type i = 0; i < n_run; ++i) {
+            auto start = i*run_size_ + std::min(i, run_extra_);
+            regular_runs_ &= run_start_[i] == start;
+        }
+    }
+}
+
+std::size_t domain_decomposition::run_of(cell_gid_type gid) const {
+    arb_assert(gid < num_global_cells_);
+    if (regular_runs_) {
+        auto large = run_extra_*(run_size_ + 1);
+        return gid < large? gid/(run_size_ + 1): run_extra_ + (gid - large)/run_size_;
     }
+    return std::upper_bound(run_start_.begin(), run_start_.end(), gid) - run_start_.begin() - 1;
 }
 
 int domain_decomposition::num_domains() const { return num_domains_; }
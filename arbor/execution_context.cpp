@@ -17,7 +17,8 @@ execution_context::execution_context(const proc_allocation& resources):
     distributed(make_local_context()),
     thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
     gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
-                           : std::make_shared<gpu_context>())
+                           : std::make_shared<gpu_context>()),
+    huge_pages(resources.huge_pages)
 {}
 
 ARB_ARBOR_API context make_context(const proc_allocation& p) {
@@ -31,7 +32,8 @@ execution_context::execution_context(const proc_allocation& resources, MPI_Comm
     distributed(make_mpi_context(comm, resources.bind_procs)),
     thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
     gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
-                           : std::make_shared<gpu_context>())
+                           : std::make_shared<gpu_context>()),
+    huge_pages(resources.huge_pages)
 {}
 
 template <>
@@ -39,7 +41,8 @@ execution_context::execution_context(const proc_allocation& resources, MPI_Comm
     distributed(make_remote_context(comm, remote)),
     thread_pool(std::make_shared<threading::task_system>(resources.num_threads)),
     gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
-                           : std::make_shared<gpu_context>())
+                           : std::make_shared<gpu_context>()),
+    huge_pages(resources.huge_pages)
 {}
 
 template <>
@@ -60,7 +63,8 @@ execution_context::execution_context(
         distributed(make_dry_run_context(d.num_ranks, d.num_cells_per_rank)),
         thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
         gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
-                               : std::make_shared<gpu_context>())
+                               : std::make_shared<gpu_context>()),
+        huge_pages(resources.huge_pages)
 {}
 
 template <>
@@ -25,6 +25,9 @@ struct ARB_ARBOR_API execution_context {
     task_system_handle thread_pool;
     gpu_context_handle gpu;
 
+    // Back the arrays of each cell group with transparent huge pages.
+    bool huge_pages = false;
+
     execution_context(const proc_allocation& resources = proc_allocation{1,gpu_nil_id});
 
     // Use a template for constructing with a specific distributed context.
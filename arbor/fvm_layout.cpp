@@ -1,6 +1,9 @@
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -17,6 +20,7 @@
 #include <arbor/morph/morphology.hpp>
 
 #include "fvm_layout.hpp"
+#include "iexpr_program.hpp"
 #include "threading/threading.hpp"
 #include "util/maputil.hpp"
 #include "util/piecewise.hpp"
@@ -81,8 +85,120 @@ std::vector<V> unique_union(const std::vector<V>& a, const std::vector<V>& b) {
     return u;
 }
 
+// Writers for the layout signature of a cable cell; see fvm_layout_signature.
+// Floating point values are written in hexadecimal for an exact representation.
+struct signature_writer {
+    std::ostream& o;
+
+    void operator()(double v) { o << std::hexfloat << v << std::defaultfloat << ' '; }
+    void operator()(const std::string& s) { o << s.size() << ':' << s << ' '; }
+    void operator()(const iexpr& e) { o << e << ' '; }
+    void operator()(const region& r) { o << r << ' '; }
+    void operator()(const locset& l) { o << l << ' '; }
+
+    template <typename T>
+    void operator()(const std::optional<T>& v) {
+        if (v) (*this)(*v);
+        else o << "- ";
+    }
+
+    void operator()(const mechanism_desc& m) {
+        (*this)(m.name());
+        std::vector<std::pair<std::string, double>> values(m.values().begin(), m.values().end());
+        std::sort(values.begin(), values.end());
+        for (const auto& [k, v]: values) { (*this)(k); (*this)(v); }
+        o << "; ";
+    }
+
+    void operator()(const init_membrane_potential& p) { o << "Vm "; (*this)(p.value); (*this)(p.scale); }
+    void operator()(const axial_resistivity& p)       { o << "Ra "; (*this)(p.value); (*this)(p.scale); }
+    void operator()(const temperature& p)             { o << "T "; (*this)(p.value); (*this)(p.scale); }
+    void operator()(const membrane_capacitance& p)    { o << "Cm "; (*this)(p.value); (*this)(p.scale); }
+    void operator()(const ion_diffusivity& p)         { o << "D "; (*this)(p.ion); (*this)(p.value); (*this)(p.scale); }
+    void operator()(const init_int_concentration& p)  { o << "Xi "; (*this)(p.ion); (*this)(p.value); (*this)(p.scale); }
+    void operator()(const init_ext_concentration& p)  { o << "Xo "; (*this)(p.ion); (*this)(p.value); (*this)(p.scale); }
+    void operator()(const init_reversal_potential& p) { o << "eX "; (*this)(p.ion); (*this)(p.value); (*this)(p.scale); }
+    void operator()(const ion_reversal_potential_method& p) { o << "eX-method "; (*this)(p.ion); (*this)(p.method); }
+    void operator()(const density& p)                 { o << "density "; (*this)(p.mech); }
+    void operator()(const voltage_process& p)         { o << "voltage-process "; (*this)(p.mech); }
+    void operator()(const synapse& p)                 { o << "synapse "; (*this)(p.mech); }
+    void operator()(const junction& p)                { o << "junction "; (*this)(p.mech); }
+    void operator()(const threshold_detector& p)      { o << "detector "; (*this)(p.threshold); }
+
+    void operator()(const scaled_mechanism<density>& p) {
+        o << "scaled ";
+        (*this)(p.t_mech);
+        std::vector<std::pair<std::string, iexpr>> scales(p.scale_expr.begin(), p.scale_expr.end());
+        std::sort(scales.begin(), scales.end(), [](const auto& a, const auto& b) { return a.first<b.first; });
+        for (const auto& [k, e]: scales) { (*this)(k); (*this)(e); }
+    }
+
+    void operator()(const i_clamp& p) {
+        o << "iclamp ";
+        (*this)(p.frequency);
+        (*this)(p.phase);
+        for (const auto& [t, a]: p.envelope) { (*this)(t); (*this)(a); }
+    }
+
+    template <typename... Ts>
+    void operator()(const std::variant<Ts...>& v) { std::visit(*this, v); }
+};
+
 } // anonymous namespace
 
+// Layout signature
+// ----------------
+//
+// Cells with equal signatures have the same morphology, labels, decor,
+// parameter scaling and discretization, and thus identical CV discretizations
+// and mechanism layouts up to the offset of their CVs.
+
+ARB_ARBOR_API std::string fvm_layout_signature(const cable_cell& cell) {
+    std::ostringstream o;
+    // Regions, locsets, iexprs and the cv_policy are written by their
+    // printers; use enough digits that distinct values print differently.
+    o.precision(std::numeric_limits<double>::max_digits10);
+    signature_writer w{o};
+
+    const auto& m = cell.morphology();
+    o << "morphology ";
+    for (msize_t b = 0; b<m.num_branches(); ++b) {
+        o << m.branch_parent(b) << ' ';
+        for (const auto& seg: m.branch_segments(b)) {
+            for (const auto& p: {seg.prox, seg.dist}) {
+                w(p.x); w(p.y); w(p.z); w(p.radius);
+            }
+            o << seg.tag << ' ';
+        }
+        o << "; ";
+    }
+
+    const auto& labels = cell.labels();
+    o << "labels ";
+    for (const auto& [k, v]: std::map(labels.regions().begin(), labels.regions().end())) { w(k); w(v); }
+    for (const auto& [k, v]: std::map(labels.locsets().begin(), labels.locsets().end())) { w(k); w(v); }
+    for (const auto& [k, v]: std::map(labels.iexpressions().begin(), labels.iexpressions().end())) { w(k); w(v); }
+
+    const auto& decor = cell.decorations();
+    o << "paint ";
+    for (const auto& [r, p]: decor.paintings()) { w(r); w(p); }
+    o << "place ";
+    for (const auto& [l, p, t]: decor.placements()) { w(l); w(p); o << t << ' '; }
+    o << "defaults ";
+    for (const auto& d: decor.defaults().serialize()) w(d);
+
+    o << "scaling ";
+    for (const auto& [mech, factors]: std::map(cell.parameter_scales().begin(), cell.parameter_scales().end())) {
+        w(mech);
+        for (const auto& [k, v]: std::map(factors.begin(), factors.end())) { w(k); w(v); }
+        o << "; ";
+    }
+
+    o << "cv-policy ";
+    if (const auto& cvp = cell.discretization()) o << *cvp;
+    return o.str();
+}
+
 
 // Building CV geometry
 // --------------------
@@ -211,6 +327,16 @@ ARB_ARBOR_API cv_geometry& append(cv_geometry& geom, const cv_geometry& right) {
 
 ARB_ARBOR_API fvm_cv_discretization& append(fvm_cv_discretization& dczn, const fvm_cv_discretization& right) {
     using util::append;
+    using impl::append_offset;
+
+    // Layout sources are only meaningful if known for all cells on both sides.
+    const auto n_cell = dczn.n_cell();
+    if (dczn.cell_layout_source.size()==n_cell && right.cell_layout_source.size()==right.n_cell()) {
+        append_offset(dczn.cell_layout_source, n_cell, right.cell_layout_source);
+    }
+    else {
+        dczn.cell_layout_source.clear();
+    }
 
     // Merge diffusive ion data, scan ions in L and R, then...
     // ... those in L and R: append R's data to that of L
@@ -458,14 +584,46 @@ ARB_ARBOR_API fvm_cv_discretization fvm_cv_discretize(const std::vector<cable_ce
     const cable_cell_parameter_set& global_defaults,
     const arb::execution_context& ctx)
 {
+    // Cells sharing a layout signature are discretized only once. Copies of a
+    // cell share its description, and thus need no signature of their own.
+    std::vector<arb_size_type> described(cells.size());
+    std::vector<arb_size_type> descriptions;
+    {
+        std::unordered_map<const decor*, arb_size_type> first;
+        for (auto cell_idx: count_along(cells)) {
+            auto [it, inserted] = first.try_emplace(&cells[cell_idx].decorations(), cell_idx);
+            if (inserted) descriptions.push_back(cell_idx);
+            described[cell_idx] = it->second;
+        }
+    }
+
+    std::vector<std::string> signatures(cells.size());
+    threading::parallel_for::apply(0, descriptions.size(), ctx.thread_pool.get(),
+          [&] (int i) { signatures[descriptions[i]] = fvm_layout_signature(cells[descriptions[i]]);});
+
+    std::vector<arb_size_type> source(cells.size());
+    std::vector<arb_size_type> unique;
+    {
+        std::unordered_map<std::string, arb_size_type> first;
+        for (auto cell_idx: descriptions) {
+            auto [it, inserted] = first.try_emplace(std::move(signatures[cell_idx]), cell_idx);
+            if (inserted) unique.push_back(cell_idx);
+            source[cell_idx] = it->second;
+        }
+        for (auto cell_idx: count_along(cells)) {
+            source[cell_idx] = source[described[cell_idx]];
+        }
+    }
+
     std::vector<fvm_cv_discretization> cell_disc(cells.size());
-    threading::parallel_for::apply(0, cells.size(), ctx.thread_pool.get(),
-          [&] (int i) { cell_disc[i]=fvm_cv_discretize(cells[i], global_defaults);});
+    threading::parallel_for::apply(0, unique.size(), ctx.thread_pool.get(),
+          [&] (int i) { cell_disc[unique[i]]=fvm_cv_discretize(cells[unique[i]], global_defaults);});
 
     fvm_cv_discretization combined;
     for (auto cell_idx: count_along(cells)) {
-        append(combined, cell_disc[cell_idx]);
+        append(combined, cell_disc[source[cell_idx]]);
     }
+    combined.cell_layout_source = std::move(source);
     return combined;
 }
 
@@ -785,18 +943,30 @@ ARB_ARBOR_API std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>>
 fvm_resolve_gj_connections(const std::vector<cell_gid_type>& gids,
                            const cell_label_range& gj_data,
                            const std::unordered_map<cell_member_type, arb_size_type>& gj_cvs,
-                           const recipe& rec) {
+                           const recipe& rec,
+                           std::vector<cell_global_label_type>* remote_peers,
+                           arb_size_type n_cv) {
     // Construct and resolve all gj_connections.
     std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>> gj_conns;
     label_resolution_map resolution_map({gj_data, gids});
     auto gj_resolver = resolver(&resolution_map);
+    std::unordered_set<cell_gid_type> group_gids;
+    if (remote_peers) group_gids.insert(gids.begin(), gids.end());
     for (const auto& gid: gids) {
         std::vector<fvm_gap_junction> local_conns;
         for (const auto& conn: rec.gap_junctions_on(gid)) {
             auto local_idx = gj_resolver.resolve({gid, conn.local});
-            auto peer_idx  = gj_resolver.resolve(conn.peer);
-
             auto local_cv = gj_cvs.at({gid, local_idx});
+
+            // Peers outside the cell group get the next free slot.
+            if (remote_peers && !group_gids.count(conn.peer.gid)) {
+                auto peer_cv = n_cv + remote_peers->size();
+                remote_peers->push_back(conn.peer);
+                local_conns.push_back({local_idx, local_cv, peer_cv, conn.weight});
+                continue;
+            }
+
+            auto peer_idx = gj_resolver.resolve(conn.peer);
             auto peer_cv  = gj_cvs.at({conn.peer.gid, peer_idx});
 
             local_conns.push_back({local_idx, local_cv, peer_cv, conn.weight});
@@ -852,6 +1022,10 @@ struct cell_build_data {
     const iexpr_ptr unit_scale;
     const ion_species_map& ion_species;
     bool coalesce;
+    // Per-instance factors on density mechanism parameters.
+    const parameter_scaling& parameter_scales;
+    // Scale expressions of all mechanisms on the cell, sharing subexpressions.
+    mutable iexpr_program scales;
 
     cell_build_data(unsigned idx,
                     const fvm_cv_discretization& d,
@@ -863,7 +1037,8 @@ struct cell_build_data {
         catalogue{p.catalogue},
         unit_scale{thingify(iexpr::scalar(1.0), provider)},
         ion_species{p.ion_species},
-        coalesce{p.coalesce_synapses}
+        coalesce{p.coalesce_synapses},
+        parameter_scales{c.parameter_scales()}
     {}
 };
 
@@ -934,6 +1109,18 @@ fvm_build_mechanism_data(const cable_cell_global_properties& gprop,
                          const fvm_cv_discretization& D,
                          arb_size_type cell_idx);
 
+// Translate all CV indices in cell-wise mechanism data by `offset`.
+void shift_cvs(fvm_mechanism_data& data, arb_index_type offset) {
+    auto shift = [offset](auto& cvs) { for (auto& cv: cvs) cv += offset; };
+    for (auto& [name, config]: data.mechanisms) {
+        shift(config.cv);
+        shift(config.peer_cv);
+    }
+    for (auto& [name, config]: data.ions) shift(config.cv);
+    shift(data.stimuli.cv);
+    shift(data.stimuli.cv_unique);
+}
+
 ARB_ARBOR_API fvm_mechanism_data
 fvm_build_mechanism_data(const cable_cell_global_properties& gprop,
                          const std::vector<cable_cell>& cells,
@@ -941,9 +1128,25 @@ fvm_build_mechanism_data(const cable_cell_global_properties& gprop,
                          const std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>>& gj_conns,
                          const fvm_cv_discretization& D,
                          const execution_context& ctx) {
+    // Cells sharing their layout with an earlier cell copy its mechanism data,
+    // shifted to their own CVs; gap junctions are specific to each cell.
+    auto source = [&](arb_size_type i) -> arb_size_type {
+        if (D.cell_layout_source.size()!=cells.size()) return i;
+        auto j = D.cell_layout_source[i];
+        return gj_conns.at(gids[i]).empty() && gj_conns.at(gids[j]).empty()? j: i;
+    };
+
     std::vector<fvm_mechanism_data> cell_mech(cells.size());
     threading::parallel_for::apply(0, cells.size(), ctx.thread_pool.get(), [&] (int i) {
-        cell_mech[i] = fvm_build_mechanism_data(gprop, cells[i], gj_conns.at(gids[i]), D, i);
+        if (source(i)==arb_size_type(i)) {
+            cell_mech[i] = fvm_build_mechanism_data(gprop, cells[i], gj_conns.at(gids[i]), D, i);
+        }
+    });
+    threading::parallel_for::apply(0, cells.size(), ctx.thread_pool.get(), [&] (int i) {
+        if (auto j = source(i); j!=arb_size_type(i)) {
+            cell_mech[i] = cell_mech[j];
+            shift_cvs(cell_mech[i], D.geometry.cell_cv_divs[i] - D.geometry.cell_cv_divs[j]);
+        }
     });
 
     fvm_mechanism_data combined;
@@ -1103,11 +1306,37 @@ apply_parameters_on_cv(fvm_mechanism_config& config,
     auto n_param = param_maps.size();
     std::vector<double> param_on_cv(n_param);
     const auto& geometry = data.D.geometry;
+    auto& scales = data.scales;
+
+    // Gather the cables on which each scale is needed and evaluate all of
+    // them in one batch per scale, before integrating over the CVs.
+    std::vector<double> area_on_cables;
+    std::unordered_map<iexpr_program::reg_type, std::vector<mcable>> scale_cables;
+    for (auto cv: geometry.cell_cvs(data.cell_idx)) {
+        for (const mcable& cable: geometry.cables(cv)) {
+            double area_on_cable = data.embedding.integrate_area(cable, pw_over_cable(support, cable, 0.));
+            area_on_cables.push_back(area_on_cable);
+            if (!area_on_cable) continue;
+            for (std::size_t i = 0; i< n_param; ++i) {
+                pw_over_cable(param_maps[i],
+                              cable,
+                              0.,
+                              [&](const auto& c, const auto& x) {
+                                  auto r = scales.lower(x.second);
+                                  if (!scales.constant(r)) scale_cables[r].push_back(c);
+                                  return 0.;
+                              });
+            }
+        }
+    }
+    for (const auto& [r, cables]: scale_cables) scales.evaluate(r, cables, data.provider);
+
+    std::size_t cable_idx = 0;
     for (auto cv: geometry.cell_cvs(data.cell_idx)) {
         double area = 0;
         util::fill(param_on_cv, 0.);
         for (const mcable& cable: geometry.cables(cv)) {
-            double area_on_cable = data.embedding.integrate_area(cable, pw_over_cable(support, cable, 0.));
+            double area_on_cable = area_on_cables[cable_idx++];
             if (!area_on_cable) continue;
             area += area_on_cable;
             const auto branch = cable.branch;
@@ -1115,8 +1344,8 @@ apply_parameters_on_cv(fvm_mechanism_config& config,
                 auto pw = pw_over_cable(param_maps[i],
                                         cable,
                                         0.,
-                                        [&data](const auto &c, const auto& x) {
-                                            return x.first * x.second->eval(data.provider, c);
+                                        [&scales](const auto &c, const auto& x) {
+                                            return x.first * scales.value(scales.lower(x.second), c);
                                         });
                 param_on_cv[i] += data.embedding.integrate_area(branch, pw);
             }
@@ -1218,6 +1447,18 @@ make_density_mechanism_config(const region_assignment<density>& assignments,
             config.param_values.emplace_back(k, std::vector<arb_value_type>{});
         }
 
+        // Per-instance factors, applied on top of the painted values.
+        std::vector<double> factors(n_param, 1.);
+        if (auto it = data.parameter_scales.find(name); it!=data.parameter_scales.end()) {
+            for (const auto& [param, factor]: it->second) {
+                auto p = std::find_if(parameters.begin(), parameters.end(), [&](const auto& kv) { return kv.first==param; });
+                if (p==parameters.end()) {
+                    throw make_cc_error("Scaled parameter '{}' is not a parameter of mechanism '{}'", param, name);
+                }
+                factors[p - parameters.begin()] = factor;
+            }
+        }
+
         mcable_map<double> support;
         std::vector<mcable_map<std::pair<double, iexpr_ptr>>> param_maps(n_param);
 
@@ -1231,7 +1472,7 @@ make_density_mechanism_config(const region_assignment<density>& assignments,
             support.insert(cable, 1.);
             for (std::size_t i = 0; i<n_param; ++i) {
                 const auto& [name, dflt] = parameters[i];
-                auto value = util::value_by_key_or(set_params, name, dflt);
+                auto value = util::value_by_key_or(set_params, name, dflt)*factors[i];
                 auto scale = util::value_by_key_or(scale_expr, name, data.unit_scale);
                 param_maps[i].insert(cable, {value, scale});
             }
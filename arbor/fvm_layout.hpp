@@ -173,12 +173,23 @@ struct fvm_cv_discretization {
 
     // For each diffusive ion species, their properties
     std::unordered_map<std::string, fvm_diffusion_info> diffusive_ions;
+
+    // For each cell, the index of the first cell with the same layout
+    // signature, see fvm_layout_signature; empty if not determined.
+    std::vector<size_type> cell_layout_source;
 };
 
 // Combine two fvm_cv_geometry groups in-place.
 // (Returns reference to first argument.)
 ARB_ARBOR_API fvm_cv_discretization& append(fvm_cv_discretization&, const fvm_cv_discretization&);
 
+// Canonical description of everything determining the discretization and
+// mechanism layout of a cell: morphology, labels, decor, parameter scaling and
+// cv policy.
+// Cells with equal signatures share a single discretization and mechanism
+// layout when a group is built.
+ARB_ARBOR_API std::string fvm_layout_signature(const cable_cell& cell);
+
 // Construct fvm_cv_discretization from one or more cells.
 ARB_ARBOR_API fvm_cv_discretization fvm_cv_discretize(const cable_cell& cell, const cable_cell_parameter_set& global_dflt);
 ARB_ARBOR_API fvm_cv_discretization fvm_cv_discretize(const std::vector<cable_cell>& cells, const cable_cell_parameter_set& global_defaults, const arb::execution_context& ctx={});
@@ -294,11 +305,17 @@ ARB_ARBOR_API std::unordered_map<cell_member_type, arb_size_type> fvm_build_gap_
     const fvm_cv_discretization& D);
 
 // Resolves gj_connections into {gid, lid} pairs, then to CV indices and a weight.
+//
+// Peers on cells other than `gids` are only allowed if `remote_peers` is
+// given: each such peer is appended to it, and its peer CV is `n_cv` plus its
+// index there, that is, a slot past the CVs of the cells.
 ARB_ARBOR_API std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>> fvm_resolve_gj_connections(
     const std::vector<cell_gid_type>& gids,
     const cell_label_range& gj_data,
     const std::unordered_map<cell_member_type, arb_size_type>& gj_cv,
-    const recipe& rec);
+    const recipe& rec,
+    std::vector<cell_global_label_type>* remote_peers = nullptr,
+    arb_size_type n_cv = 0);
 
 struct fvm_mechanism_data {
     // Mechanism config, indexed by mechanism name.
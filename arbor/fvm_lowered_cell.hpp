@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
@@ -12,6 +13,7 @@
 #include <arbor/common_types.hpp>
 #include <arbor/cable_cell.hpp>
 #include <arbor/fvm_types.hpp>
+#include <arbor/mechanism_counters.hpp>
 #include <arbor/morph/primitives.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/serdes.hpp>
@@ -223,6 +225,15 @@ struct fvm_initialization_data {
     std::unordered_map<cell_gid_type, arb_size_type> num_sources;
     std::unordered_map<cell_gid_type, arb_size_type> num_targets;
 
+    // Adaptive time stepping settings from the global properties.
+    std::optional<adaptive_timestep_parameters> adaptive_timestep;
+
+    // Gap junctions coupled across cell groups, if enabled in the global
+    // properties: the CV of each gap junction site on the cells, and the
+    // peers on cells in other groups, one per remote peer voltage slot.
+    std::unordered_map<cell_member_type, arb_size_type> gap_junction_cvs;
+    std::vector<cell_global_label_type> remote_gap_junction_peers;
+
     void shrink_to_fit() {
         source_data.shrink_to_fit();
         target_data.shrink_to_fit();
@@ -244,6 +255,17 @@ struct fvm_lowered_cell {
 
     virtual arb_value_type time() const = 0;
 
+    // Runtime counters, one entry per mechanism instance.
+    virtual std::vector<mechanism_counters> get_mechanism_counters() const { return {}; }
+
+    // Set the CVs whose membrane voltages are read by gap junction peers in
+    // other cell groups, and return those voltages [mV].
+    virtual void export_voltages(const std::vector<arb_size_type>& cvs) = 0;
+    virtual std::vector<arb_value_type> exported_voltages() const = 0;
+
+    // Set the voltages [mV] of the gap junction peers in other cell groups.
+    virtual void set_remote_peer_voltages(const std::vector<arb_value_type>& values) = 0;
+
     virtual ~fvm_lowered_cell() {}
 
     virtual void t_serialize(serializer& ser, const std::string& k) const = 0;
@@ -7,6 +7,8 @@
 // implementation details may be tested in the unit tests.
 // It should otherwise only be used in `fvm_lowered_cell.cpp`.
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -24,6 +26,7 @@
 
 #include "fvm_lowered_cell.hpp"
 #include "label_resolution.hpp"
+#include "memory/memory.hpp"
 #include "profile/profiler_macro.hpp"
 #include "util/maputil.hpp"
 #include "util/meta.hpp"
@@ -55,6 +58,29 @@ struct fvm_lowered_cell_impl: public fvm_lowered_cell {
 
     value_type time() const override { return state_->time; }
 
+    std::vector<mechanism_counters> get_mechanism_counters() const override {
+        std::vector<mechanism_counters> result;
+        for (const auto* ms: {&voltage_mechanisms_, &revpot_mechanisms_, &mechanisms_}) {
+            for (const auto& m: *ms) result.push_back(m->counters());
+        }
+        return result;
+    }
+
+    void export_voltages(const std::vector<size_type>& cvs) override {
+        set_gpu();
+        state_->configure_exported_voltages({cvs.begin(), cvs.end()});
+    }
+
+    std::vector<value_type> exported_voltages() const override {
+        set_gpu();
+        return state_->exported_voltages();
+    }
+
+    void set_remote_peer_voltages(const std::vector<value_type>& values) override {
+        set_gpu();
+        state_->set_remote_peer_voltages(values);
+    }
+
     //Exposed for testing purposes
     std::vector<mechanism_ptr>& mechanisms() { return mechanisms_; }
 
@@ -83,6 +109,10 @@ struct fvm_lowered_cell_impl: public fvm_lowered_cell {
     // Optional non-physical voltage check threshold, tripped when |Um| > Ucrit
     std::optional<double> check_voltage_mV_;
 
+    // Tolerances for adaptive time stepping, if enabled.
+    std::optional<adaptive_timestep_parameters> adaptive_;
+    std::vector<arb_value_type> voltage_prev_;
+
     // random number generator seed value
     arb_seed_type seed_;
 
@@ -99,7 +129,7 @@ struct fvm_lowered_cell_impl: public fvm_lowered_cell {
     // The GPU will be the one in the execution context context_.
     // If not called, the thread may attempt to launch on a different GPU,
     // leading to crashes.
-    void set_gpu() { if (context_.gpu->has_gpu()) context_.gpu->set_gpu(); }
+    void set_gpu() const { if (context_.gpu->has_gpu()) context_.gpu->set_gpu(); }
 
     // Translate cell probe descriptions into probe handles etc.
     void resolve_probe_address(std::vector<fvm_probe_data>& probe_data, // out parameter
@@ -157,6 +187,8 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(const timestep_
     state_->begin_epoch(event_lanes, staged_samples, dts, target_handles_, target_handle_divisions_);
     PL();
 
+    arb_value_type voltage_rate = 0;
+
     // loop over timesteps
     for (const auto& ts : dts) {
         state_->update_time_to(ts);
@@ -198,10 +230,29 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(const timestep_
         state_->take_samples();
         PL();
 
-        // Integrate voltage and diffusion
+        // Integrate voltage and diffusion; for adaptive time stepping, measure the
+        // change in voltage over the step.
+        if (adaptive_) {
+            auto v = memory::on_host(state_->voltage);
+            voltage_prev_.assign(v.begin(), v.end());
+        }
         PE(advance:integrate:cable);
         state_->integrate_cable_state();
         PL();
+        // A step that changed the voltage by more than the tolerance is
+        // completed, but the remaining steps are dropped, such that the caller
+        // can plan them again with shorter steps.
+        bool replan = false;
+        if (adaptive_) {
+            auto v = memory::on_host(state_->voltage);
+            arb_value_type dv = 0;
+            for (size_type i = 0; i<voltage_prev_.size(); ++i) {
+                dv = std::max(dv, std::abs(v[i] - voltage_prev_[i]));
+            }
+            const auto h = ts.t_end() - ts.t_begin();
+            voltage_rate = dv/h;
+            replan = dv>adaptive_->dv_max && h>adaptive_->dt_min;
+        }
 
         // Integrate mechanism state for density
         for (auto& m: mechanisms_) {
@@ -242,9 +293,13 @@ fvm_integration_result fvm_lowered_cell_impl<Backend>::integrate(const timestep_
             assert_voltage_bounded(check_voltage_mV_.value());
             PL();
         }
+
+        if (replan) break;
     }
 
-    return state_->get_integration_result();
+    auto result = state_->get_integration_result();
+    result.voltage_rate = voltage_rate;
+    return result;
 }
 
 template <typename Backend>
@@ -385,13 +440,22 @@ fvm_lowered_cell_impl<Backend>::initialize(const std::vector<cell_gid_type>& gid
     // Check for physically reasonable membrane volages?
     check_voltage_mV_ = global_props.membrane_voltage_limit_mV;
 
+    // Adaptive time stepping is driven by the cell group.
+    fvm_info.adaptive_timestep = global_props.adaptive_timestep;
+    adaptive_ = global_props.adaptive_timestep;
+
     // Discretize cells, build matrix.
     fvm_cv_discretization D = fvm_cv_discretize(cells, global_props.default_parameters, context_);
     arb_assert(D.n_cell() == ncell);
 
-    // Discretize and build gap junction info.
+    // Discretize and build gap junction info; peers in other cell groups are
+    // given voltage slots past the CVs if gap junctions are coupled.
     auto gj_cvs = fvm_build_gap_junction_cv_map(cells, gids, D);
-    auto gj_conns = fvm_resolve_gj_connections(gids, fvm_info.gap_junction_data, gj_cvs, rec);
+    const bool gj_coupled = global_props.gap_junction_coupling_interval.has_value();
+    auto gj_conns = fvm_resolve_gj_connections(gids, fvm_info.gap_junction_data, gj_cvs, rec,
+                                               gj_coupled? &fvm_info.remote_gap_junction_peers: nullptr,
+                                               D.size());
+    if (gj_coupled) fvm_info.gap_junction_cvs = std::move(gj_cvs);
 
     // Discretize mechanism data.
     fvm_mechanism_data mech_data = fvm_build_mechanism_data(global_props, cells, gids, gj_conns, D, context_);
@@ -434,7 +498,9 @@ fvm_lowered_cell_impl<Backend>::initialize(const std::vector<cell_gid_type>& gid
                                             mech_data.ions,
                                             mech_data.stimuli,
                                             data_alignment,
-                                            seed_);
+                                            seed_,
+                                            context_.huge_pages,
+                                            fvm_info.remote_gap_junction_peers.size());
 
     // Keep track of mechanisms by name for probe lookup.
     std::unordered_map<std::string, mechanism*> mechptr_by_name;
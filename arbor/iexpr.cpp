@@ -17,6 +17,8 @@
 #include <arbor/util/any_visitor.hpp>
 #include <arbor/math.hpp>
 
+#include "iexpr_program.hpp"
+
 namespace arb {
 
 namespace iexpr_impl {
@@ -558,6 +560,192 @@ iexpr_ptr thingify(const iexpr& expr, const mprovider& m) {
     throw std::runtime_error("thingify iexpr: Unknown iexpr type");
 }
 
+// Lowering into iexpr_program
+
+namespace {
+std::string locations_key(const std::variant<mlocation_list, mextent>& locations) {
+    std::ostringstream o;
+    o.precision(17);
+    std::visit(util::overload(
+                   [&](const mlocation_list& l) { o << "locations " << l; },
+                   [&](const mextent& e) { o << "extent " << e.cables(); }),
+               locations);
+    return o.str();
+}
+
+std::string number_key(double x) {
+    std::ostringstream o;
+    o.precision(17);
+    o << x;
+    return o.str();
+}
+} // anonymous namespace
+
+iexpr_program::reg_type iexpr_program::emit(const std::string& key, instruction inst) {
+    auto [it, added] = by_key_.try_emplace(key, code_.size());
+    if (added) code_.push_back(std::move(inst));
+    return it->second;
+}
+
+iexpr_program::reg_type iexpr_program::emit_scalar(double value) {
+    instruction inst{opcode::scalar};
+    inst.value = value;
+    return emit("scalar "+number_key(value), std::move(inst));
+}
+
+iexpr_program::reg_type iexpr_program::emit_op(opcode op, reg_type lhs, reg_type rhs) {
+    auto a = constant(lhs), b = constant(rhs);
+    if (a && b) {
+        double x;
+        apply(op, 1, &*a, &*b, &x);
+        return emit_scalar(x);
+    }
+
+    instruction inst{op};
+    inst.lhs = lhs;
+    inst.rhs = rhs;
+    return emit("op "+std::to_string(int(op))+" "+std::to_string(lhs)+" "+std::to_string(rhs), std::move(inst));
+}
+
+iexpr_program::reg_type iexpr_program::lower(const iexpr_ptr& expr) {
+    if (auto it = by_node_.find(expr); it!=by_node_.end()) return it->second;
+
+    auto leaf = [&](const std::string& key, iexpr_ptr node) {
+        instruction inst{opcode::leaf};
+        inst.leaf = std::move(node);
+        return emit(key, std::move(inst));
+    };
+    // Scaled leaves share the unscaled value.
+    auto scaled = [&](double scale, reg_type r) {
+        return scale==1? r: emit_op(opcode::mul, emit_scalar(scale), r);
+    };
+    auto unary = [&](opcode op, const iexpr_ptr& v) {
+        auto a = lower(v);
+        return emit_op(op, a, a);
+    };
+
+    namespace I = iexpr_impl;
+    const auto* e = expr.get();
+    reg_type r;
+    if (auto x = dynamic_cast<const I::scalar*>(e)) {
+        r = emit_scalar(x->value);
+    }
+    else if (auto x = dynamic_cast<const I::radius*>(e)) {
+        r = scaled(x->scale, leaf("radius", std::make_shared<I::radius>(1.0)));
+    }
+    else if (auto x = dynamic_cast<const I::distance*>(e)) {
+        r = scaled(x->scale, leaf("distance "+locations_key(x->locations),
+                                  std::make_shared<I::distance>(1.0, x->locations)));
+    }
+    else if (auto x = dynamic_cast<const I::proximal_distance*>(e)) {
+        r = scaled(x->scale, leaf("proximal-distance "+locations_key(x->locations),
+                                  std::make_shared<I::proximal_distance>(1.0, x->locations)));
+    }
+    else if (auto x = dynamic_cast<const I::distal_distance*>(e)) {
+        r = scaled(x->scale, leaf("distal-distance "+locations_key(x->locations),
+                                  std::make_shared<I::distal_distance>(1.0, x->locations)));
+    }
+    else if (auto x = dynamic_cast<const I::interpolation*>(e)) {
+        r = leaf("interpolation "+number_key(x->prox_v)+" "+locations_key(x->prox_l)+" "
+                                 +number_key(x->dist_v)+" "+locations_key(x->dist_l), expr);
+    }
+    else if (auto x = dynamic_cast<const I::add*>(e)) r = emit_op(opcode::add, lower(x->left), lower(x->right));
+    else if (auto x = dynamic_cast<const I::sub*>(e)) r = emit_op(opcode::sub, lower(x->left), lower(x->right));
+    else if (auto x = dynamic_cast<const I::mul*>(e)) r = emit_op(opcode::mul, lower(x->left), lower(x->right));
+    else if (auto x = dynamic_cast<const I::div*>(e)) r = emit_op(opcode::div, lower(x->left), lower(x->right));
+    else if (auto x = dynamic_cast<const I::exp*>(e)) r = unary(opcode::exp, x->value);
+    else if (auto x = dynamic_cast<const I::log*>(e)) r = unary(opcode::log, x->value);
+    else if (auto x = dynamic_cast<const I::step_right*>(e)) r = unary(opcode::step_right, x->value);
+    else if (auto x = dynamic_cast<const I::step_left*>(e)) r = unary(opcode::step_left, x->value);
+    else if (auto x = dynamic_cast<const I::step*>(e)) r = unary(opcode::step, x->value);
+    else {
+        // Opaque expression: evaluated as is, and shared by identity only.
+        std::ostringstream o;
+        o << "node " << e;
+        r = leaf(o.str(), expr);
+    }
+
+    by_node_.emplace(expr, r);
+    return r;
+}
+
+std::optional<double> iexpr_program::constant(reg_type r) const {
+    const auto& inst = code_.at(r);
+    if (inst.op==opcode::scalar) return inst.value;
+    return std::nullopt;
+}
+
+void iexpr_program::apply(opcode op, std::size_t n, const double* a, const double* b, double* x) {
+    switch (op) {
+    case opcode::add:
+        for (std::size_t i = 0; i<n; ++i) x[i] = a[i] + b[i];
+        break;
+    case opcode::sub:
+        for (std::size_t i = 0; i<n; ++i) x[i] = a[i] - b[i];
+        break;
+    case opcode::mul:
+        for (std::size_t i = 0; i<n; ++i) x[i] = a[i] * b[i];
+        break;
+    case opcode::div:
+        for (std::size_t i = 0; i<n; ++i) x[i] = a[i] / b[i];
+        break;
+    case opcode::exp:
+        for (std::size_t i = 0; i<n; ++i) x[i] = std::exp(a[i]);
+        break;
+    case opcode::log:
+        for (std::size_t i = 0; i<n; ++i) x[i] = std::log(a[i]);
+        break;
+    case opcode::step_right:
+        for (std::size_t i = 0; i<n; ++i) x[i] = (a[i] >= 0.);
+        break;
+    case opcode::step_left:
+        for (std::size_t i = 0; i<n; ++i) x[i] = (a[i] > 0.);
+        break;
+    case opcode::step:
+        for (std::size_t i = 0; i<n; ++i) x[i] = 0.5*((0. < a[i]) - (a[i] < 0.) + 1);
+        break;
+    default:
+        throw arbor_internal_error("iexpr_program: not an operation");
+    }
+}
+
+std::vector<double> iexpr_program::evaluate(reg_type r, const std::vector<mcable>& cables, const mprovider& p) {
+    auto& inst = code_.at(r);
+    if (inst.op==opcode::scalar) return std::vector<double>(cables.size(), inst.value);
+
+    // Evaluate the arguments on the cables not seen before, then this instruction.
+    std::vector<mcable> missing;
+    for (const auto& c: cables) {
+        if (inst.values.try_emplace(c, 0.).second) missing.push_back(c);
+    }
+    if (!missing.empty()) {
+        const auto n = missing.size();
+        std::vector<double> x(n);
+        if (inst.op==opcode::leaf) {
+            for (std::size_t i = 0; i<n; ++i) x[i] = inst.leaf->eval(p, missing[i]);
+        }
+        else {
+            auto a = evaluate(inst.lhs, missing, p);
+            auto b = inst.rhs==inst.lhs? a: evaluate(inst.rhs, missing, p);
+            apply(inst.op, n, a.data(), b.data(), x.data());
+        }
+        for (std::size_t i = 0; i<n; ++i) inst.values[missing[i]] = x[i];
+    }
+
+    std::vector<double> result;
+    result.reserve(cables.size());
+    for (const auto& c: cables) result.push_back(inst.values[c]);
+    return result;
+}
+
+double iexpr_program::value(reg_type r, const mcable& c) const {
+    const auto& inst = code_.at(r);
+    if (inst.op==opcode::scalar) return inst.value;
+    auto it = inst.values.find(c);
+    if (it==inst.values.end()) throw arbor_internal_error("iexpr_program: register not evaluated on cable");
+    return it->second;
+}
+
 std::ostream& operator<<(std::ostream& o, const iexpr& e) {
     o << "(";
 
@@ -0,0 +1,71 @@
+#pragma once
+
+// Flat, batch evaluated form of thingified inhomogeneous expressions.
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arbor/export.hpp>
+#include <arbor/iexpr.hpp>
+#include <arbor/morph/mprovider.hpp>
+#include <arbor/morph/primitives.hpp>
+
+namespace arb {
+
+// An iexpr_program holds any number of lowered expressions as a single
+// sequence of instructions, each writing one register. Structurally equal
+// subexpressions, for example the distance to the same locset, are lowered
+// to the same register, whichever expression they were found in; constant
+// subexpressions are folded.
+//
+// Registers are evaluated over a batch of cables at once, one instruction
+// at a time, and values are kept per cable, so work shared between
+// expressions is done once per cable. The program refers to the morphology
+// of the mprovider used for evaluation through its cached values, and must
+// only ever be evaluated with the same one.
+class ARB_ARBOR_API iexpr_program {
+public:
+    using reg_type = std::size_t;
+
+    // Add an expression to the program, returning the register of its value.
+    reg_type lower(const iexpr_ptr& expr);
+
+    // Value of a register that is constant, if any.
+    std::optional<double> constant(reg_type r) const;
+
+    // Values of register r over the cables; reuses values of earlier calls.
+    std::vector<double> evaluate(reg_type r, const std::vector<mcable>& cables, const mprovider& p);
+
+    // Value of register r on a cable, which must have been evaluated before.
+    double value(reg_type r, const mcable& c) const;
+
+    // Number of instructions.
+    std::size_t size() const { return code_.size(); }
+
+private:
+    enum class opcode { scalar, leaf, add, sub, mul, div, exp, log, step_right, step_left, step };
+
+    struct instruction {
+        opcode op;
+        double value = 0;              // Scalars.
+        iexpr_ptr leaf;                // Leaves, evaluated per cable.
+        reg_type lhs = 0, rhs = 0;     // Arguments of operations.
+        std::unordered_map<mcable, double> values;
+    };
+
+    reg_type emit(const std::string& key, instruction inst);
+    reg_type emit_scalar(double value);
+    reg_type emit_op(opcode op, reg_type lhs, reg_type rhs = 0);
+
+    // Apply an operation elementwise, with one loop per operation.
+    static void apply(opcode op, std::size_t n, const double* a, const double* b, double* x);
+
+    std::vector<instruction> code_;
+    std::unordered_map<std::string, reg_type> by_key_;
+    std::unordered_map<iexpr_ptr, reg_type> by_node_;
+};
+
+} // namespace arb
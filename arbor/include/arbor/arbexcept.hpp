@@ -208,6 +208,12 @@ struct ARB_SYMBOL_VISIBLE bad_catalogue_error: arbor_exception {
     std::any platform_error;
 };
 
+struct ARB_SYMBOL_VISIBLE catalogue_compilation_error: arbor_exception {
+    catalogue_compilation_error(const std::string& name, const std::string& log);
+    std::string name;
+    std::string log;
+};
+
 // ABI errors
 
 struct ARB_SYMBOL_VISIBLE bad_alignment: arbor_exception {
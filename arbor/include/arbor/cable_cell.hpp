@@ -259,6 +259,12 @@ using location_assignment = std::conditional_t<std::is_same_v<T, synapse> || std
                                                std::unordered_map<std::string, mlocation_map<T>>,
                                                mlocation_map<T>>;
 
+// Per-instance factors on the parameters of painted density mechanisms, keyed
+// by mechanism name, then parameter name. The factors apply on top of the
+// painted values, including scale expressions, wherever the mechanism is
+// painted on the cell.
+using parameter_scaling = std::unordered_map<std::string, std::unordered_map<std::string, double>>;
+
 // High-level abstract representation of a cell.
 struct ARB_SYMBOL_VISIBLE cable_cell {
     using lid_range_map = std::unordered_multimap<hash_type, lid_range>;
@@ -269,19 +275,30 @@ struct ARB_SYMBOL_VISIBLE cable_cell {
     // Default constructor.
     cable_cell();
 
-    // Copy and move constructors.
-    cable_cell(const cable_cell& other);
+    // Copy and move constructors. Copies share the immutable description of
+    // the cell, so copying is cheap irrespective of the size of the cell.
+    cable_cell(const cable_cell& other) = default;
     cable_cell(cable_cell&& other) = default;
 
     // Copy and move assignment operators.
     cable_cell& operator=(cable_cell&&) = default;
-    cable_cell& operator=(const cable_cell& other) { return *this = cable_cell(other); }
+    cable_cell& operator=(const cable_cell& other) = default;
 
     /// Construct from morphology, label and decoration descriptions.
+    /// Regions and locsets are concretised through `cache`, if given, which
+    /// may be shared by cells with the same morphology.
     cable_cell(const class morphology& m,
                const decor& d,
                const label_dict& l={},
-               const std::optional<cv_policy>& = {});
+               const std::optional<cv_policy>& = {},
+               std::shared_ptr<thingify_cache> cache = {});
+
+    /// Construct from a template cell and per-instance decorations, which are
+    /// added to those of the template, and factors on the parameters of
+    /// density mechanisms painted on the template or in `delta`, which
+    /// multiply those of the template. Morphology, labels and their
+    /// concretisation are shared with the template.
+    cable_cell(const cable_cell& tmpl, const decor& delta, const parameter_scaling& scaling={});
 
     /// Access to labels
     const label_dict& labels() const;
@@ -324,13 +341,16 @@ struct ARB_SYMBOL_VISIBLE cable_cell {
     // The default parameter and ion settings on the cell.
     const cable_cell_parameter_set& default_parameters() const;
 
+    // The factors on density mechanism parameters of this instance.
+    const parameter_scaling& parameter_scales() const;
+
     // The labeled lid_ranges of sources, targets and gap_junctions on the cell;
     const lid_range_map& detector_ranges() const;
     const lid_range_map& synapse_ranges() const;
     const lid_range_map& junction_ranges() const;
 
 private:
-    std::unique_ptr<cable_cell_impl, void (*)(cable_cell_impl*)> impl_;
+    std::shared_ptr<cable_cell_impl> impl_;
 };
 
 } // namespace arb
@@ -427,6 +427,20 @@ public:
 
 ARB_ARBOR_API extern cable_cell_parameter_set neuron_parameter_defaults;
 
+// Adaptive time stepping for cable cell groups.
+//
+// The step size is chosen per epoch such that the membrane voltage changes by
+// about `dv_max` per step, bounded above by the `dt` passed to the simulation.
+// Steps are split at event and sample times; after each event the step size
+// restarts at `dt_min` and grows by a factor of `growth` per step. The voltage
+// change is estimated from the last step taken; after a step that changed the
+// voltage by more than `dv_max`, the rest of the epoch is planned again.
+struct ARB_SYMBOL_VISIBLE adaptive_timestep_parameters {
+    double dv_max = 1.0;  // [mV]
+    double dt_min = 1e-3; // [ms]
+    double growth = 2.0;
+};
+
 // Global cable cell data.
 
 struct ARB_SYMBOL_VISIBLE cable_cell_global_properties {
@@ -436,9 +450,19 @@ struct ARB_SYMBOL_VISIBLE cable_cell_global_properties {
     // during integration.
     std::optional<double> membrane_voltage_limit_mV;
 
+    // Optional adaptive time stepping; if unset, steps of fixed size dt are taken.
+    std::optional<adaptive_timestep_parameters> adaptive_timestep;
+
     // True => combine linear synapses for performance.
     bool coalesce_synapses = true;
 
+    // Optional coupling of gap junctions between cells in different cell
+    // groups, which then no longer have to share a group, or a rank. Peer
+    // voltages are exchanged between groups at least every this many [ms], and
+    // are held constant in between; if unset, the peers of a gap junction are
+    // always placed in the same group.
+    std::optional<double> gap_junction_coupling_interval;
+
     // Available ion species, together with charge.
     std::unordered_map<std::string, int> ion_species = {
         {"na", 1},
@@ -33,6 +33,10 @@ struct proc_allocation {
     bool bind_procs = false;
     bool bind_threads = false;
 
+    // Back the per cell group arrays of the multicore backend with
+    // transparent huge pages, where supported.
+    bool huge_pages = false;
+
     proc_allocation() = default;
 
     proc_allocation(unsigned long threads, int gpu, bool bind_proc=false, bool bind_thread=false):
@@ -16,8 +16,7 @@
 //
 // The cv_policy class is a value-like wrapper for actual policies that derive
 // from `cv_policy_base`. At present, there are only a handful of policies
-// implemented, described below. The intent is to provide more sophisticated
-// policies in the near future, specifically one based on the 'd-lambda' rule.
+// implemented, described below.
 //
 //   cv_policy_explicit:
 //       Simply use the provided locset.
@@ -32,6 +31,11 @@
 //       Use as many CVs as required to ensure that no CV has
 //       a length longer than a given value.
 //
+//   cv_policy_d_lambda:
+//       Use an odd number of CVs per branch such that no CV is longer than
+//       a given fraction of the length constant at a given frequency, as
+//       determined by diameter, axial resistivity and membrane capacitance.
+//
 // The policies above can be restricted to apply only to a given region of a
 // cell morphology. If a region is supplied, the CV policy is applied to the
 // completion of each connected component of the morphology within the region,
@@ -136,6 +140,11 @@ ARB_ARBOR_API cv_policy cv_policy_max_extent(double, cv_policy_flag = cv_policy_
 ARB_ARBOR_API cv_policy cv_policy_fixed_per_branch(unsigned, region, cv_policy_flag = cv_policy_flag::none);
 ARB_ARBOR_API cv_policy cv_policy_fixed_per_branch(unsigned, cv_policy_flag = cv_policy_flag::none);
 
+// Frequency [Hz], maximum CV length as fraction of the length constant; both
+// must be positive and finite, else std::domain_error is thrown.
+ARB_ARBOR_API cv_policy cv_policy_d_lambda(double frequency, double d_lambda, region, cv_policy_flag = cv_policy_flag::none);
+ARB_ARBOR_API cv_policy cv_policy_d_lambda(double frequency = 100, double d_lambda = 0.1, cv_policy_flag = cv_policy_flag::none);
+
 ARB_ARBOR_API cv_policy cv_policy_single(region domain = reg::all());
 
 ARB_ARBOR_API cv_policy cv_policy_every_segment(region domain = reg::all());
@@ -42,8 +42,11 @@ struct ARB_ARBOR_API domain_decomposition {
     domain_decomposition(const domain_decomposition&) = default;
     domain_decomposition& operator=(const domain_decomposition&) = default;
 
-    int gid_domain(cell_gid_type gid) const { return gid_domain_[gid]; }
-    cell_size_type index_on_domain(cell_gid_type gid) const { return gid_index_[gid]; }
+    int gid_domain(cell_gid_type gid) const { return run_domain_[run_of(gid)]; }
+    cell_size_type index_on_domain(cell_gid_type gid) const {
+        auto run = run_of(gid);
+        return run_index_[run] + (gid - run_start_[run]);
+    }
     int num_domains() const;
     int domain_id() const;
     cell_size_type num_local_cells() const;
@@ -53,9 +56,20 @@ struct ARB_ARBOR_API domain_decomposition {
     const group_description& group(unsigned) const;
 
 private:
-    /// Return the domain id and index on domain of cell with gid.
-    std::vector<int> gid_domain_;
-    std::vector<cell_size_type> gid_index_;
+    /// Domain id and index on domain of cells, stored as runs of consecutive
+    /// gids with consecutive indices on the same domain, sorted by first gid.
+    std::vector<cell_gid_type> run_start_;
+    std::vector<int> run_domain_;
+    std::vector<cell_size_type> run_index_;
+
+    /// Set if the runs are blocks as made by partition_load_balance: the
+    /// first run_extra_ runs have run_size_+1 cells, the others run_size_.
+    bool regular_runs_ = false;
+    cell_size_type run_size_ = 0;
+    cell_size_type run_extra_ = 0;
+
+    /// Index of the run holding gid.
+    std::size_t run_of(cell_gid_type gid) const;
 
     /// Number of distributed domains
     int num_domains_;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include <arbor/common_types.hpp>
+
+namespace arb {
+
+// Timings and counts of one integration epoch of a simulation. Times are
+// wall-clock seconds on this rank unless stated otherwise.
+//
+// The update of epoch k runs concurrently with the exchange of the spikes of
+// epoch k-1 and the enqueueing of the events of epoch k+1. `exchange`,
+// `gather` and `enqueue` refer to the work serving epoch k itself, that is
+// the exchange of its spikes, done during the update of k+1 (after the update
+// for the last epoch of a run), and the enqueueing of its events, done during
+// the update of k-1 (before the update for the first epoch of a run).
+// `communication` is the time of the exchange and enqueueing concurrent with
+// the update of epoch k, and `step` the time until both were done.
+struct epoch_metrics {
+    // Epoch index and integration interval [ms].
+    std::uint64_t id = 0;
+    time_type t0 = 0;
+    time_type t1 = 0;
+
+    // Advance of the slowest and the mean cell group.
+    double advance_max = 0;
+    double advance_mean = 0;
+
+    // Advance of all cell groups.
+    double update = 0;
+
+    // Exchange of the spikes of this epoch, of which spent in the collective
+    // gather of spikes, and enqueueing of the events of this epoch.
+    double exchange = 0;
+    double gather = 0;
+    double enqueue = 0;
+
+    // Communication serving the neighbouring epochs, concurrent with the update.
+    double communication = 0;
+
+    // Update and concurrent communication.
+    double step = 0;
+
+    // Spikes generated, and events delivered, on this rank.
+    std::uint64_t num_spikes = 0;
+    std::uint64_t num_events = 0;
+
+    // Update time of the slowest and the mean rank.
+    double rank_update_max = 0;
+    double rank_update_mean = 0;
+
+    // True if the update, rather than the communication, bounded the step.
+    bool update_critical() const { return update>=communication; }
+
+    // Ratio of the slowest to the mean rank and cell group; 1 if balanced.
+    double rank_imbalance() const { return rank_update_mean>0? rank_update_max/rank_update_mean: 1.; }
+    double group_imbalance() const { return advance_mean>0? advance_max/advance_mean: 1.; }
+};
+
+} // namespace arb
@@ -103,6 +103,27 @@ inline event_generator poisson_generator(cell_local_label_type target,
     return event_generator(std::move(target), weight, poisson_schedule(tstart, rate_kHz, seed, tstop));
 }
 
+// Generate the events of many independent Poisson sources onto the same target
+// and with the same weight as one Poisson process with the summed rate, instead
+// of one generator per source.
+inline event_generator poisson_superposition_generator(cell_local_label_type target,
+                                                       float weight,
+                                                       const std::vector<poisson_source>& sources,
+                                                       seed_type seed = default_seed) {
+    return event_generator(std::move(target), weight, poisson_superposition_schedule(sources, seed));
+}
+
+// As above, for `n` sources of rate `rate_kHz` each, all active in [tstart, tstop).
+inline event_generator poisson_superposition_generator(cell_local_label_type target,
+                                                       float weight,
+                                                       std::size_t n,
+                                                       const units::quantity& tstart,
+                                                       const units::quantity& rate_kHz,
+                                                       seed_type seed = default_seed,
+                                                       const units::quantity& tstop=terminal_time*units::ms) {
+    return poisson_superposition_generator(std::move(target), weight, {{double(n)*rate_kHz, tstart, tstop}}, seed);
+}
+
 
 // Generate events from a predefined sorted event sequence.
 template<typename S> inline
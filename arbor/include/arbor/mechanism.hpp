@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <arbor/arbexcept.hpp>
 #include <arbor/fvm_types.hpp>
 #include <arbor/mechanism_abi.h>
+#include <arbor/mechanism_counters.hpp>
 #include <arbor/mechinfo.hpp>
 #include <arbor/profile/profiler.hpp>
 #include <arbor/version.hpp>
@@ -63,35 +65,45 @@ public:
     // Forward to interface methods
 
     void initialize() {
-        iface_.init_mechanism(&ppack_);
+        timed(counters_.init, [&] { iface_.init_mechanism(&ppack_); });
     }
 
     void update_current() {
         prof_enter(current_prof_id);
-        iface_.compute_currents(&ppack_);
+        timed(counters_.current, [&] { iface_.compute_currents(&ppack_); });
         prof_exit();
     }
 
     void update_state() {
         prof_enter(state_prof_id);
-        iface_.advance_state(&ppack_);
+        timed(counters_.state, [&] { iface_.advance_state(&ppack_); });
         prof_exit();
     }
 
     void update_ions() {
-        iface_.write_ions(&ppack_);
+        timed(counters_.ions, [&] { iface_.write_ions(&ppack_); });
     }
 
     void post_event() {
-        iface_.post_event(&ppack_);
+        timed(counters_.post, [&] { iface_.post_event(&ppack_); });
     }
 
     void deliver_events(arb_deliverable_event_stream& stream) {
         prof_enter(deliver_prof_id);
-        iface_.apply_events(&ppack_, &stream);
+        counters_.events_applied += stream.end - stream.begin;
+        timed(counters_.events, [&] { iface_.apply_events(&ppack_, &stream); });
         prof_exit();
     }
 
+    // Cumulative kernel counters of this instance. On GPU back-ends, times
+    // cover the asynchronous kernel launch only.
+    mechanism_counters counters() const {
+        auto c = counters_;
+        c.name = internal_name();
+        c.width = ppack_.width;
+        return c;
+    }
+
     // Per-cell group identifier for an instantiated mechanism.
     unsigned mechanism_id() const { return ppack_.mechanism_id; }
 
@@ -100,6 +112,15 @@ public:
     arb_mechanism_ppack ppack_;
 
 private:
+    template <typename F>
+    static void timed(mechanism_kernel_counter& c, F&& f) {
+        using clock = std::chrono::steady_clock;
+        auto t0 = clock::now();
+        f();
+        c.time += std::chrono::duration<double>(clock::now() - t0).count();
+        ++c.calls;
+    }
+
 #ifdef ARB_PROFILE_ENABLED
     void prof_enter(profile::region_id_type id) {
         profile::profiler_enter(id);
@@ -114,6 +135,7 @@ private:
     profile::region_id_type state_prof_id;
     profile::region_id_type current_prof_id;
     profile::region_id_type deliver_prof_id;
+    mechanism_counters counters_;
 };
 
 struct mechanism_layout {
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <arbor/common_types.hpp>
+
+namespace arb {
+
+// Cumulative number of invocations and wall-clock time [s] of one mechanism kernel.
+struct mechanism_kernel_counter {
+    std::uint64_t calls = 0;
+    double time = 0;
+
+    double mean_time() const { return calls? time/calls: 0.; }
+};
+
+// Runtime counters of a mechanism instance, i.e. one mechanism in one cell group.
+// Counters accumulate over the lifetime of the instance; they are not cleared by
+// a simulation reset.
+struct mechanism_counters {
+    // Mechanism name as given in the NMODL source.
+    std::string name;
+    // Index of the cell group on this rank holding the instance.
+    cell_size_type group = 0;
+    // Number of CVs (density) or point processes (point) in the instance.
+    cell_size_type width = 0;
+    // Total number of events passed to the event kernel.
+    std::uint64_t events_applied = 0;
+
+    mechanism_kernel_counter init;
+    mechanism_kernel_counter current;
+    mechanism_kernel_counter state;
+    mechanism_kernel_counter events;
+    mechanism_kernel_counter ions;
+    mechanism_kernel_counter post;
+};
+
+} // namespace arb
@@ -118,4 +118,28 @@ ARB_ARBOR_API const mechanism_catalogue& global_stochastic_catalogue();
 // Load catalogue from disk.
 ARB_ARBOR_API const mechanism_catalogue load_catalogue(const std::filesystem::path&);
 
+// Options for building a catalogue from NMODL sources at runtime.
+struct catalogue_compile_options {
+    // SIMD ABI of the generated code, as for `modcc -S`, eg 'native' or
+    // 'avx2'. Empty disables explicit vectorization.
+    std::string simd;
+    // C++ compiler; empty selects $CXX or else the compiler used for Arbor.
+    std::string cxx;
+    // Flags passed to the compiler after the default flags.
+    std::vector<std::string> cxx_flags;
+    // Directories to search for Arbor's headers; empty selects the include
+    // directory of the installation holding the loaded library.
+    std::vector<std::filesystem::path> include_dirs;
+    // Where to keep compiled catalogues; empty selects $ARB_CATALOGUE_CACHE,
+    // then $XDG_CACHE_HOME/arbor, then $HOME/.cache/arbor.
+    std::filesystem::path cache_dir;
+};
+
+// Generate code for the mechanisms in `mod_files`, compile and load it as
+// catalogue `name`. Shared objects are cached, keyed by the sources and
+// options, so that later calls with the same input skip straight to loading.
+ARB_ARBOR_API const mechanism_catalogue compile_catalogue(const std::string& name,
+                                                          const std::vector<std::filesystem::path>& mod_files,
+                                                          const catalogue_compile_options& options = {});
+
 } // namespace arb
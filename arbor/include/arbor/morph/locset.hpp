@@ -52,9 +52,7 @@ struct ARB_SYMBOL_VISIBLE locset {
         return *this;
     }
 
-    friend mlocation_list thingify(const locset& p, const mprovider& m) {
-        return p.impl_->thingify(m);
-    }
+    friend mlocation_list thingify(const locset& p, const mprovider& m);
     
     friend std::ostream& operator<<(std::ostream& o, const locset& p) {
         return p.impl_->print(o);
@@ -107,6 +105,9 @@ private:
     };
 };
 
+// Concrete locations of a locset, shared via the provider's thingify cache if any.
+ARB_ARBOR_API mlocation_list thingify(const locset&, const mprovider&);
+
 struct region;
 
 namespace ls {
@@ -11,11 +11,15 @@
 namespace arb {
 
 struct morphology_impl;
+class thingify_cache;
 
 class ARB_ARBOR_API morphology {
     // Hold an immutable copy of the morphology implementation.
     std::shared_ptr<const morphology_impl> impl_;
 
+    // Identifies morphologies by their implementation.
+    friend class thingify_cache;
+
 public:
     morphology(segment_tree m);
     morphology();
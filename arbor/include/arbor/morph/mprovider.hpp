@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -13,9 +18,47 @@ namespace arb {
 
 using concrete_embedding = embed_pwlin;
 
+struct region;
+struct locset;
+
+// Concrete regions and locsets shared between the providers of cells with
+// the same morphology, in addition to the per-provider cache of labels.
+//
+// Morphologies are identified by object: providers share results if they
+// are built from copies of the same arb::morphology. Results are keyed on
+// the printed expression, and only expressions that do not refer to labels
+// are shared, as the label dictionaries of cells may differ. The embedding
+// of each morphology is shared as well.
+//
+// Morphologies are kept alive for the lifetime of the cache. Safe for use
+// from multiple threads.
+class ARB_ARBOR_API thingify_cache {
+public:
+    thingify_cache();
+    ~thingify_cache();
+
+    // Number of cached regions and locsets.
+    std::size_t size() const;
+
+    // Number of evaluations served from the cache.
+    std::size_t hits() const;
+
+    void clear();
+
+private:
+    friend struct mprovider;
+    static const void* identity(const arb::morphology&);
+    struct impl;
+    std::unique_ptr<impl> impl_;
+};
+
 struct ARB_ARBOR_API mprovider {
     mprovider(const arb::morphology& m, const label_dict& dict): morphology_(m), embedding_(m), dict_(&dict) {}
     mprovider(const arb::morphology& m): morphology_(m), embedding_(m) {}
+    mprovider(const arb::morphology& m, const label_dict& dict, std::shared_ptr<thingify_cache> cache);
+
+    mprovider(const mprovider&);
+    mprovider& operator=(const mprovider&);
 
     // Throw exception on missing or recursive definition.
     const mextent& region(const std::string& name) const;
@@ -26,7 +69,19 @@ struct ARB_ARBOR_API mprovider {
     const auto& morphology() const { return morphology_; }
     const auto& embedding() const { return embedding_; }
 
+    const std::shared_ptr<thingify_cache>& cache() const { return cache_; }
+
 private:
+    template <typename Lock>
+    mprovider(const mprovider&, const Lock&);
+
+    // Anonymous expressions are evaluated through the shared cache.
+    friend mextent thingify(const arb::region&, const mprovider&);
+    friend mlocation_list thingify(const arb::locset&, const mprovider&);
+
+    mextent memoize(const arb::region&, const std::function<mextent()>&) const;
+    mlocation_list memoize(const arb::locset&, const std::function<mlocation_list()>&) const;
+
     arb::morphology morphology_;
     concrete_embedding embedding_;
     const label_dict* dict_ = nullptr;
@@ -37,6 +92,13 @@ private:
     mutable map<mextent> regions_;
     mutable map<mlocation_list> locsets_;
     mutable map<iexpr_ptr> iexpressions_;
+    // Guards the caches, as a provider may be shared between threads.
+    // Recursive, since named expressions are evaluated by recursion.
+    mutable std::recursive_mutex mutex_;
+
+    std::shared_ptr<thingify_cache> cache_;
+    // Count of label lookups, to tell whether an expression refers to labels.
+    mutable std::atomic<std::uint64_t> label_lookups_ = 0;
 };
 
 } // namespace arb
@@ -58,7 +58,7 @@ public:
     region(mextent);
     region(mcable_list);
 
-    friend mextent thingify(const region& r, const mprovider& m) { return r.impl_->thingify(m); }
+    friend mextent thingify(const region& r, const mprovider& m);
 
     friend std::ostream& operator<<(std::ostream& o, const region& p) { return p.impl_->print(o); }
 
@@ -96,6 +96,9 @@ private:
     };
 };
 
+// Concrete extent of a region, shared via the provider's thingify cache if any.
+ARB_ARBOR_API mextent thingify(const region&, const mprovider&);
+
 struct locset;
 
 namespace reg {
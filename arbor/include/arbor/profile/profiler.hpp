@@ -43,6 +43,17 @@ ARB_ARBOR_API std::size_t profiler_region_id(const std::string& name);
 
 ARB_ARBOR_API std::ostream& operator<<(std::ostream&, const profile&);
 
+// Trace mode: in addition to the summary, record a timeline of the most
+// recent `capacity` region visits on each thread. Call after initialization;
+// a capacity of zero disables tracing.
+ARB_ARBOR_API void profiler_enable_trace(std::size_t capacity=1<<16);
+
+// Write the recorded timeline in Chrome trace-event JSON format, as read by
+// chrome://tracing and Perfetto, with the MPI rank as process id and the
+// thread index as thread id. Timestamps are relative to initialization,
+// which is collective and starts the clocks of all ranks after a barrier.
+ARB_ARBOR_API std::ostream& profiler_write_trace(std::ostream&);
+
 } // namespace profile
 } // namespace arb
 
@@ -218,8 +218,7 @@ struct ARB_ARBOR_API s_expr {
         s_expr(token{{0,0}, tok::string, std::move(s)}) {}
     explicit s_expr(const char* s):
         s_expr(token{{0,0}, tok::string, s}) {}
-    s_expr(double x):
-        s_expr(token{{0,0}, tok::real, std::to_string(x)}) {}
+    s_expr(double x);
     s_expr(int x):
         s_expr(token{{0,0}, tok::integer, std::to_string(x)}) {}
     s_expr(symbol s):
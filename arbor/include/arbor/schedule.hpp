@@ -120,4 +120,17 @@ schedule ARB_ARBOR_API poisson_schedule(const units::quantity& rate,
                                         seed_type seed = default_seed,
                                         const units::quantity& tstop=terminal_time*units::ms);
 
+/// A source of a Poisson superposition, active with constant `rate` in [`tstart`, `tstop`).
+struct poisson_source {
+    units::quantity rate;
+    units::quantity tstart = 0*units::ms;
+    units::quantity tstop = terminal_time*units::ms;
+};
+
+/// Superposition of independent Poisson sources, drawn as a single Poisson
+/// point process whose rate at any time is the sum of the rates of the
+/// sources active then.
+schedule ARB_ARBOR_API poisson_superposition_schedule(const std::vector<poisson_source>& sources,
+                                                      seed_type seed = default_seed);
+
 } // namespace arb
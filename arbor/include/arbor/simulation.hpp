@@ -9,7 +9,9 @@
 #include <arbor/common_types.hpp>
 #include <arbor/context.hpp>
 #include <arbor/domain_decomposition.hpp>
+#include <arbor/epoch_metrics.hpp>
 #include <arbor/load_balance.hpp>
+#include <arbor/mechanism_counters.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/sampling.hpp>
 #include <arbor/schedule.hpp>
@@ -71,6 +73,16 @@ struct ARB_ARBOR_API simulation {
     // or an empty vector if no local match for probe id.
     std::vector<probe_metadata> get_probe_metadata(const cell_address_type& probeset_id) const;
 
+    // Return runtime counters of all mechanism instances in the local cell groups.
+    // Must not be called concurrently with `run`.
+    std::vector<mechanism_counters> get_mechanism_counters() const;
+
+    // Return timings and counts of each of the most recent 16384 epochs run
+    // since construction or the last reset, oldest first, with update times
+    // reduced across ranks. Collective: must be called on all ranks, and not
+    // concurrently with `run`.
+    std::vector<epoch_metrics> get_epoch_metrics() const;
+
     std::size_t num_spikes() const;
 
     // Register a callback that will perform a export of the global
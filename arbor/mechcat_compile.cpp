@@ -0,0 +1,202 @@
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/mechcat.hpp>
+#include <arbor/version.hpp>
+#include <arbor/util/hash_def.hpp>
+#include <arbor/util/scope_exit.hpp>
+
+#include "util/strprintf.hpp"
+
+// modcc code generation
+#include "module.hpp"
+#include "parser.hpp"
+#include "printer/catalogueprinter.hpp"
+#include "printer/cprinter.hpp"
+#include "printer/infoprinter.hpp"
+#include "printer/printeropt.hpp"
+#include "printer/simd.hpp"
+
+// Defaults recorded at configure time; see arbor/CMakeLists.txt.
+#ifndef ARB_CXX_COMPILER
+#define ARB_CXX_COMPILER "c++"
+#endif
+#ifndef ARB_INCLUDE_PATH
+#define ARB_INCLUDE_PATH ""
+#endif
+#ifndef ARB_INCLUDE_PATH_FROM_LIB
+#define ARB_INCLUDE_PATH_FROM_LIB "../include"
+#endif
+#ifndef ARB_CXX_FLAGS_ARCH
+#define ARB_CXX_FLAGS_ARCH ""
+#endif
+
+namespace fs = std::filesystem;
+
+namespace arb {
+
+namespace {
+std::string read_file(const fs::path& fn) {
+    std::ifstream fd{fn};
+    if (!fd.good()) throw file_not_found_error{fn.string()};
+    std::stringstream ss;
+    ss << fd.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::string& text, const fs::path& fn) {
+    std::ofstream fd{fn};
+    fd << text;
+    if (!fd.good()) throw bad_catalogue_error{util::pprintf("Could not write '{}'", fn.string())};
+}
+
+// Quote for use as a single argument in a POSIX shell command line.
+std::string shell_quote(const std::string& s) {
+    std::string r = "'";
+    for (auto c: s) {
+        if (c=='\'') r += "'\\''";
+        else r += c;
+    }
+    return r + "'";
+}
+
+fs::path default_cache_dir() {
+    if (auto p = std::getenv("ARB_CATALOGUE_CACHE"); p && *p) return p;
+    if (auto p = std::getenv("XDG_CACHE_HOME"); p && *p) return fs::path(p)/"arbor";
+    if (auto p = std::getenv("HOME"); p && *p) return fs::path(p)/".cache"/"arbor";
+    return fs::temp_directory_path()/"arbor";
+}
+
+std::string default_cxx() {
+    if (auto p = std::getenv("CXX"); p && *p) return p;
+    return ARB_CXX_COMPILER;
+}
+
+// Arbor's headers, relative to the library holding this code such that moved
+// installations and Python wheels work; else where they were installed.
+fs::path default_include_dir() {
+    Dl_info info;
+    if (dladdr((void*)&default_include_dir, &info) && info.dli_fname) {
+        std::error_code ec;
+        auto lib = fs::canonical(info.dli_fname, ec);
+        if (!ec) {
+            auto dir = (lib.parent_path()/ARB_INCLUDE_PATH_FROM_LIB).lexically_normal();
+            if (fs::exists(dir/"arbor"/"mechanism_abi.h", ec)) return dir;
+        }
+    }
+    return ARB_INCLUDE_PATH;
+}
+
+bool is_identifier(const std::string& s) {
+    if (s.empty() || std::isdigit((unsigned char)s.front())) return false;
+    for (auto c: s) {
+        if (!std::isalnum((unsigned char)c) && c!='_') return false;
+    }
+    return true;
+}
+} // anonymous namespace
+
+ARB_ARBOR_API const mechanism_catalogue compile_catalogue(const std::string& name,
+                                                          const std::vector<fs::path>& mod_files,
+                                                          const catalogue_compile_options& options) {
+    if (!is_identifier(name)) {
+        throw bad_catalogue_error{util::pprintf("Catalogue name '{}' is not a valid identifier", name)};
+    }
+    if (mod_files.empty()) {
+        throw bad_catalogue_error{util::pprintf("No NMODL sources given for catalogue '{}'", name)};
+    }
+
+    printer_options popt;
+    popt.cpp_namespace = "arb::" + name + "_catalogue";
+    if (!options.simd.empty()) {
+        try {
+            popt.simd = parse_simd_spec(options.simd);
+        }
+        catch (std::exception&) {
+            throw bad_catalogue_error{util::pprintf("Unknown SIMD ABI '{}'", options.simd)};
+        }
+    }
+
+    auto cxx = options.cxx.empty()? default_cxx(): options.cxx;
+    auto include_dirs = options.include_dirs;
+    if (include_dirs.empty()) include_dirs.push_back(default_include_dir());
+
+    std::vector<std::string> flags = {"-std=c++20", "-O3", "-fPIC", "-shared", "-DSTANDALONE"};
+    {
+        std::istringstream arch_flags{ARB_CXX_FLAGS_ARCH};
+        for (std::string f; arch_flags >> f;) flags.push_back(f);
+    }
+    for (const auto& dir: include_dirs) flags.push_back("-I" + dir.string());
+    flags.insert(flags.end(), options.cxx_flags.begin(), options.cxx_flags.end());
+
+    // The cache key covers everything that goes into the shared object.
+    std::vector<std::string> sources;
+    std::size_t key = hash_value(std::string{ARB_VERSION}, name, options.simd, cxx);
+    for (const auto& f: flags) key = detail::hash_value_combine(key, f);
+    for (const auto& fn: mod_files) {
+        sources.push_back(read_file(fn));
+        key = detail::hash_value_combine(key, fn.filename().string(), sources.back());
+    }
+
+    auto cache_dir = options.cache_dir.empty()? default_cache_dir(): options.cache_dir;
+    auto stem = util::strprintf("%s-%016zx", name, key);
+    auto target = cache_dir/(stem + ".so");
+    if (fs::exists(target)) return load_catalogue(target);
+
+    // Build in a private directory and move the result into place, such that
+    // concurrent processes sharing the cache never observe a partial file.
+    auto work_dir = cache_dir/util::pprintf("{}.build-{}", stem, ::getpid());
+    fs::create_directories(work_dir);
+    auto cleanup = util::on_scope_exit([&] { std::error_code ec; fs::remove_all(work_dir, ec); });
+
+    std::vector<std::string> names;
+    std::vector<fs::path> outputs;
+    for (std::size_t ix = 0; ix<mod_files.size(); ++ix) {
+        const auto& fn = mod_files[ix];
+        try {
+            Module m(sources[ix], fn.string());
+            Parser p(m, false);
+            if (!p.parse()) throw catalogue_compilation_error{name, p.error_message()};
+            m.semantic();
+            if (m.has_error()) throw catalogue_compilation_error{name, m.error_string()};
+
+            auto mod = m.module_name();
+            write_file(build_info_header(m, popt, true, false), work_dir/(mod + ".hpp"));
+            write_file(emit_cpp_source(m, popt), work_dir/(mod + "_cpu.cpp"));
+            outputs.push_back(work_dir/(mod + "_cpu.cpp"));
+            names.push_back(mod);
+        }
+        catch (compiler_exception& e) {
+            throw catalogue_compilation_error{name, util::pprintf("{}: {}", fn.string(), e.what())};
+        }
+    }
+    write_file(build_catalogue_source(name, names, popt), work_dir/(name + "_catalogue.cpp"));
+    outputs.push_back(work_dir/(name + "_catalogue.cpp"));
+
+    auto partial = work_dir/(stem + ".so");
+    auto log = work_dir/"build.log";
+    std::string cmd = shell_quote(cxx);
+    for (const auto& f: flags) cmd += " " + shell_quote(f);
+    cmd += " -I" + shell_quote(work_dir.string());
+    for (const auto& src: outputs) cmd += " " + shell_quote(src.string());
+    cmd += " -o " + shell_quote(partial.string()) + " > " + shell_quote(log.string()) + " 2>&1";
+
+    if (std::system(cmd.c_str())!=0) {
+        throw catalogue_compilation_error{name, cmd + "\n" + read_file(log)};
+    }
+    fs::rename(partial, target);
+
+    return load_catalogue(target);
+}
+
+} // namespace arb
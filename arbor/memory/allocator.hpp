@@ -54,6 +54,8 @@ namespace impl {
 
     // allocate memory with alignment specified as a template parameter
     // returns nullptr on failure
+    // the memory is not touched, so that its pages are placed on the NUMA
+    // node of the thread that first writes to them
     template <typename T, size_type alignment=minimum_possible_alignment<T>()>
     T* aligned_malloc(size_type size) {
         // double check that alignment is a multiple of sizeof(void*),
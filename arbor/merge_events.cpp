@@ -69,11 +69,11 @@ void ARB_ARBOR_API pqueue_merge_events(std::vector<event_span>& sources, pse_vec
 void ARB_ARBOR_API merge_events(std::vector<event_span>& sources, pse_vector &out, std::size_t n_evts) {
     out.reserve(out.size() + n_evts);
     auto n_queues = sources.size();
-    if (n_queues < 20) { // NOTE: MAGIC NUMBER, found by ubench/merge
+    if (n_queues < 8) { // NOTE: MAGIC NUMBER, found by ubench/merge
         linear_merge_events(sources, out);
     }
     else {
-        pqueue_merge_events(sources, out);
+        tree_merge_events(sources, out);
     }
 }
 
@@ -718,6 +718,10 @@ locset::locset() {
     *this = ls::nil();
 }
 
+ARB_ARBOR_API mlocation_list thingify(const locset& l, const mprovider& m) {
+    return m.memoize(l, [&] { return l.impl_->thingify(m); });
+}
+
 locset::locset(mlocation loc) {
     *this = ls::location(loc.branch, loc.pos);
 }
@@ -1,4 +1,7 @@
+#include <limits>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include <arbor/morph/label_dict.hpp>
 #include <arbor/morph/locset.hpp>
@@ -42,15 +45,149 @@ static const auto& try_lookup(const mprovider& provider,
 }
 
 
+struct thingify_cache::impl {
+    struct entry {
+        // Holds on to the morphology, so that its identity is not reused.
+        arb::morphology morphology;
+        concrete_embedding embedding;
+        std::unordered_map<std::string, mextent> regions;
+        std::unordered_map<std::string, mlocation_list> locsets;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<const void*, entry> entries;
+    std::size_t hits = 0;
+
+    entry& get(const arb::morphology& m) {
+        auto it = entries.find(identity(m));
+        if (it==entries.end()) {
+            it = entries.emplace(identity(m), entry{m, concrete_embedding(m), {}, {}}).first;
+        }
+        return it->second;
+    }
+
+    concrete_embedding embedding(const arb::morphology& m) {
+        std::lock_guard lock(mutex);
+        return get(m).embedding;
+    }
+
+    template <typename T, typename Expr>
+    T memoize(std::unordered_map<std::string, T> entry::* results,
+              const arb::morphology& m,
+              const Expr& expr,
+              const std::atomic<std::uint64_t>& label_lookups,
+              const std::function<T()>& eval)
+    {
+        // Expressions are keyed by their printed form, with enough digits that
+        // distinct locations and distances print differently.
+        std::ostringstream os;
+        os.precision(std::numeric_limits<double>::max_digits10);
+        os << expr;
+        auto key = os.str();
+        {
+            std::lock_guard lock(mutex);
+            auto& cached = get(m).*results;
+            if (auto it = cached.find(key); it!=cached.end()) {
+                ++hits;
+                return it->second;
+            }
+        }
+        // Evaluate outside the lock, since evaluation may recurse.
+        auto lookups = label_lookups.load();
+        T result = eval();
+        if (label_lookups.load()==lookups) {
+            std::lock_guard lock(mutex);
+            (get(m).*results).emplace(std::move(key), result);
+        }
+        return result;
+    }
+};
+
+thingify_cache::thingify_cache(): impl_(new impl) {}
+thingify_cache::~thingify_cache() = default;
+
+const void* thingify_cache::identity(const arb::morphology& m) {
+    return m.impl_.get();
+}
+
+std::size_t thingify_cache::size() const {
+    std::lock_guard lock(impl_->mutex);
+    std::size_t n = 0;
+    for (const auto& [_, e]: impl_->entries) n += e.regions.size() + e.locsets.size();
+    return n;
+}
+
+std::size_t thingify_cache::hits() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->hits;
+}
+
+void thingify_cache::clear() {
+    std::lock_guard lock(impl_->mutex);
+    impl_->entries.clear();
+    impl_->hits = 0;
+}
+
+mprovider::mprovider(const arb::morphology& m, const label_dict& dict, std::shared_ptr<thingify_cache> cache):
+    morphology_(m),
+    embedding_(cache? cache->impl_->embedding(m): concrete_embedding(m)),
+    dict_(&dict),
+    cache_(std::move(cache))
+{}
+
+template <typename Lock>
+mprovider::mprovider(const mprovider& other, const Lock&):
+    morphology_(other.morphology_),
+    embedding_(other.embedding_),
+    dict_(other.dict_),
+    regions_(other.regions_),
+    locsets_(other.locsets_),
+    iexpressions_(other.iexpressions_),
+    cache_(other.cache_)
+{}
+
+mprovider::mprovider(const mprovider& other):
+    mprovider(other, std::lock_guard{other.mutex_})
+{}
+
+mprovider& mprovider::operator=(const mprovider& other) {
+    if (this==&other) return *this;
+    std::scoped_lock lock(mutex_, other.mutex_);
+    morphology_ = other.morphology_;
+    embedding_ = other.embedding_;
+    dict_ = other.dict_;
+    regions_ = other.regions_;
+    locsets_ = other.locsets_;
+    iexpressions_ = other.iexpressions_;
+    cache_ = other.cache_;
+    return *this;
+}
+
+mextent mprovider::memoize(const arb::region& r, const std::function<mextent()>& eval) const {
+    if (!cache_) return eval();
+    return cache_->impl_->memoize(&thingify_cache::impl::entry::regions, morphology_, r, label_lookups_, eval);
+}
+
+mlocation_list mprovider::memoize(const arb::locset& l, const std::function<mlocation_list()>& eval) const {
+    if (!cache_) return eval();
+    return cache_->impl_->memoize(&thingify_cache::impl::entry::locsets, morphology_, l, label_lookups_, eval);
+}
+
 const mextent& mprovider::region(const std::string& name) const {
+    std::lock_guard lock(mutex_);
+    ++label_lookups_;
     if (dict_) try_build(*this, name, regions_, dict_->regions());
     return try_lookup(*this, name, regions_);
 }
 const mlocation_list& mprovider::locset(const std::string& name) const {
+    std::lock_guard lock(mutex_);
+    ++label_lookups_;
     if (dict_) try_build(*this, name, locsets_, dict_->locsets());
     return try_lookup(*this, name, locsets_);
 }
 const iexpr_ptr& mprovider::iexpr(const std::string& name) const {
+    std::lock_guard lock(mutex_);
+    ++label_lookups_;
     if (dict_) try_build(*this, name, iexpressions_, dict_->iexpressions());
     return try_lookup(*this, name, iexpressions_);
 }
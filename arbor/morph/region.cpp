@@ -751,6 +751,10 @@ region::region() {
     *this = reg::nil();
 }
 
+ARB_ARBOR_API mextent thingify(const region& r, const mprovider& m) {
+    return m.memoize(r, [&] { return r.impl_->thingify(m); });
+}
+
 // Implicit constructors/converters.
 
 region::region(mcable c) {
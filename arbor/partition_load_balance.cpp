@@ -1,7 +1,9 @@
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
-#include <algorithm>
 
 #include <arbor/domdecexcept.hpp>
 #include <arbor/domain_decomposition.hpp>
@@ -10,8 +12,10 @@
 #include <arbor/context.hpp>
 
 #include "cell_group_factory.hpp"
+#include "communication/gap_junction_exchange.hpp"
 #include "execution_context.hpp"
 #include "util/maputil.hpp"
+#include "util/rangeutil.hpp"
 #include "util/partition.hpp"
 #include "util/span.hpp"
 #include "util/strprintf.hpp"
@@ -19,33 +23,34 @@
 namespace arb {
 
 namespace {
-using gj_connection_set   = std::unordered_set<cell_gid_type>;
-using gj_connection_table = std::unordered_map<cell_gid_type, gj_connection_set>;
 using gid_range           = std::pair<cell_gid_type, cell_gid_type>;
 using super_cell          = std::vector<cell_gid_type>;
 
-// Build global GJ connectivity table such that
-// * table[gid] is the set of all gids connected to gid via a GJ
-// * iff A in table[B], then B in table[A]
-auto build_global_gj_connection_table(const recipe& rec) {
-    gj_connection_table res;
-    // Collect all explicit GJ connections and make them bi-directional
-    for (cell_gid_type gid = 0; gid < rec.num_cells(); ++gid) {
-        for (const auto& gj: rec.gap_junctions_on(gid)) {
-            auto peer = gj.peer.gid;
-            res[gid].insert(peer);
-            res[peer].insert(gid);
-        }
+// Disjoint sets of gids, each represented by its smallest gid.
+struct gid_sets {
+    std::unordered_map<cell_gid_type, cell_gid_type> parent;
+
+    cell_gid_type find(cell_gid_type x) {
+        auto root = x;
+        for (auto p = parent.try_emplace(root, root).first->second; p != root; p = parent[root]) root = p;
+        // path compression
+        while (x != root) x = std::exchange(parent[x], root);
+        return root;
     }
-    return res;
-}
 
-// compute range of gids for the local domain, such that the first (= num_cells
+    void join(cell_gid_type a, cell_gid_type b) {
+        a = find(a);
+        b = find(b);
+        if (a < b) parent[b] = a;
+        if (b < a) parent[a] = b;
+    }
+
+    bool contains(cell_gid_type x) const { return parent.count(x); }
+};
+
+// compute range of gids for a domain, such that the first (= num_cells
 // % num_dom) domains get an extra element.
-auto make_local_gid_range(context ctx, cell_gid_type num_global_cells) {
-    const auto& dist = ctx->distributed;
-    unsigned num_domains = dist->size();
-    unsigned domain_id = dist->id();
+gid_range make_gid_range(unsigned num_domains, unsigned domain_id, cell_gid_type num_global_cells) {
     // normal block size
     auto block = num_global_cells/num_domains;
     // domains that need an extra element
@@ -68,53 +73,92 @@ auto make_local_gid_range(context ctx, cell_gid_type num_global_cells) {
 
 // build the list of components for the local domain, where a component is a list of
 // cell gids such that
-// * the smallest gid in the list is in the local_gid_range
+// * the smallest gid in the list is in the local gid range
 // * all gids that are connected to the smallest gid are also in the list
 // * all gids w/o GJ connections come first (for historical reasons!?)
-auto build_components(const gj_connection_table& global_gj_connection_table,
-                      gid_range local_gid_range) {
-    // cells connected by gj
-    std::vector<super_cell> super_cells;
-    // singular cells
-    std::vector<super_cell> res;
-    // track visited cells (cells that already belong to a group)
-    gj_connection_set visited;
-    // Connected components via BFS
-    std::vector<cell_gid_type> q;
-    for (auto gid: util::make_span(local_gid_range)) {
-        if (global_gj_connection_table.count(gid)) {
-            // If cell hasn't been visited yet, must belong to new component
-            if (visited.insert(gid).second) {
-                // pivot gid: the smallest found in this group; must be at
-                // smaller or equal to `gid`.
-                auto min_gid = gid;
-                q.push_back(gid);
-                super_cell sc;
-                while (!q.empty()) {
-                    auto element = q.back();
-                    q.pop_back();
-                    sc.push_back(element);
-                    min_gid = std::min(element, min_gid);
-                    // queue up conjoined cells
-                    for (const auto& peer: global_gj_connection_table.at(element)) {
-                        if (visited.insert(peer).second) q.push_back(peer);
-                    }
-                }
-                // if the pivot gid belongs to our domain, this group will be part
-                // of our domain, keep it and sort.
-                if (min_gid >= local_gid_range.first) {
-                    std::sort(sc.begin(), sc.end());
-                    super_cells.emplace_back(std::move(sc));
-                }
-            }
+//
+// Each domain queries the gap junctions of its own gid range only. Components
+// are found locally with union-find, where peers may lie in other domains, and
+// then merged across domains by exchanging links between the local sets and
+// the remote gids they contain. Only those links, and the members of components
+// spanning domains, are shared between all domains.
+auto build_local_components(const recipe& rec, context ctx) {
+    const auto& dist = ctx->distributed;
+    const auto local_gid_range = make_gid_range(dist->size(), dist->id(), rec.num_cells());
+    auto is_local = [&](cell_gid_type gid) { return gid >= local_gid_range.first && gid < local_gid_range.second; };
+
+    // GJ connected sets of the local cells and their peers; gap junctions
+    // coupled across cell groups do not join their cells.
+    gid_sets local_sets;
+    if (!gap_junction_coupling_interval(rec)) {
+        for (auto gid: util::make_span(local_gid_range)) {
+            for (const auto& gj: rec.gap_junctions_on(gid)) local_sets.join(gid, gj.peer.gid);
+        }
+    }
+
+    // Link each local set to its members in other domains, ...
+    std::vector<cell_gid_type> links;
+    for (const auto& [gid, _]: local_sets.parent) {
+        if (!is_local(gid)) {
+            links.push_back(local_sets.find(gid));
+            links.push_back(gid);
         }
-        else {
-            res.push_back({gid});
+    }
+    const auto remote_links = dist->gather_gids(links).values();
+
+    // ... and local cells named in other domains to their local set.
+    links.clear();
+    for (std::size_t i = 0; i < remote_links.size(); i += 2) {
+        auto gid = remote_links[i+1];
+        if (is_local(gid)) {
+            links.push_back(gid);
+            links.push_back(local_sets.find(gid));
         }
     }
-    // append super cells to result
-    res.reserve(res.size() + super_cells.size());
-    std::move(super_cells.begin(), super_cells.end(), std::back_inserter(res));
+    const auto back_links = dist->gather_gids(links).values();
+
+    // Sets spanning domains; these are the same on all domains.
+    gid_sets global_sets;
+    for (const auto& ls: {std::cref(remote_links), std::cref(back_links)}) {
+        const auto& l = ls.get();
+        for (std::size_t i = 0; i < l.size(); i += 2) global_sets.join(l[i], l[i+1]);
+    }
+    auto component_of = [&](cell_gid_type gid) {
+        auto root = local_sets.find(gid);
+        return global_sets.contains(root)? global_sets.find(root): root;
+    };
+
+    // Send the members of components spanning domains to the owner of the
+    // component, the domain of its smallest gid.
+    links.clear();
+    for (const auto& [gid, _]: local_sets.parent) {
+        auto root = component_of(gid);
+        if (!is_local(root) && global_sets.contains(root)) {
+            links.push_back(root);
+            links.push_back(gid);
+        }
+    }
+    const auto members = dist->gather_gids(links).values();
+
+    std::map<cell_gid_type, std::vector<cell_gid_type>> owned;
+    for (const auto& [gid, _]: local_sets.parent) {
+        auto root = component_of(gid);
+        if (is_local(root)) owned[root].push_back(gid);
+    }
+    for (std::size_t i = 0; i < members.size(); i += 2) {
+        if (is_local(members[i])) owned[members[i]].push_back(members[i+1]);
+    }
+
+    std::vector<super_cell> res;
+    for (auto gid: util::make_span(local_gid_range)) {
+        if (!local_sets.contains(gid)) res.push_back({gid});
+    }
+    res.reserve(res.size() + owned.size());
+    for (auto& [_, sc]: owned) {
+        util::sort(sc);
+        sc.erase(std::unique(sc.begin(), sc.end()), sc.end());
+        res.push_back(std::move(sc));
+    }
     return res;
 }
 
@@ -161,14 +205,6 @@ auto build_group_parameters(context ctx,
     return res;
 }
 
-// Build the list of GJ-connected cells local to this domain.
-// NOTE We put this into its own function to avoid increasing RSS.
-auto build_local_components(const recipe& rec, context ctx) {
-    const auto global_gj_connection_table = build_global_gj_connection_table(rec);
-    const auto local_gid_range = make_local_gid_range(ctx, rec.num_cells());
-    return build_components(global_gj_connection_table, local_gid_range);
-}
-
 } // namespace
 
 ARB_ARBOR_API domain_decomposition_ptr partition_load_balance(const recipe& rec,
@@ -5,6 +5,7 @@
 
 #include "hardware/memory.hpp"
 #include "memory_meter.hpp"
+#include "util/arena.hpp"
 
 namespace arb {
 namespace profile {
@@ -66,5 +67,23 @@ meter_ptr make_gpu_memory_meter() {
     return meter_ptr(new gpu_memory_meter());
 }
 
+// The arena memory meter reports the memory held by the arenas of all cell
+// groups, which is also included in the basic memory_meter.
+
+class arena_memory_meter: public memory_meter {
+public:
+    std::string name() override {
+        return "memory-arena";
+    }
+
+    void take_reading() override {
+        readings_.push_back(util::arena::total_reserved());
+    }
+};
+
+meter_ptr make_arena_memory_meter() {
+    return meter_ptr(new arena_memory_meter());
+}
+
 } // namespace profile
 } // namespace arb
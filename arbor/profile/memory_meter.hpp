@@ -7,6 +7,7 @@ namespace profile {
 
 meter_ptr make_memory_meter();
 meter_ptr make_gpu_memory_meter();
+meter_ptr make_arena_memory_meter();
 
 } // namespace profile
 } // namespace arb
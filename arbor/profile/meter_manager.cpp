@@ -47,6 +47,9 @@ meter_manager::meter_manager() {
     if (auto m = make_gpu_memory_meter()) {
         meters_.push_back(std::move(m));
     }
+    if (auto m = make_arena_memory_meter()) {
+        meters_.push_back(std::move(m));
+    }
 };
 
 void meter_manager::start(context ctx) {
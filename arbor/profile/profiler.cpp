@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstdio>
 #include <mutex>
 #include <iostream>
@@ -50,6 +51,13 @@ struct profile_accumulator {
     double time=0.;
 };
 
+// One visit of a region, as recorded in trace mode.
+struct trace_event {
+    tick_type start;
+    std::int64_t duration_ns;
+    region_id_type index;
+};
+
 // Records the accumulated time spent in profiler regions on one thread.
 // There is one recorder for each thread.
 class recorder {
@@ -65,10 +73,21 @@ class recorder {
     // One accumulator for call count and wall time for each region.
     std::vector<profile_accumulator> accumulators_;
 
+    // Ring buffer holding the most recent region visits in trace mode, and
+    // the total number of visits recorded; empty if not tracing.
+    std::vector<trace_event> trace_;
+    std::size_t trace_count_ = 0;
+
 public:
     // Return a list of the accumulated call count and wall times for each region.
     const std::vector<profile_accumulator>& accumulators() const;
 
+    // Record up to capacity of the most recent region visits; 0 disables tracing.
+    void set_trace_capacity(std::size_t capacity);
+
+    // Return the recorded region visits in order of completion.
+    std::vector<trace_event> trace() const;
+
     // Start timing the region with index.
     // Throws std::runtime_error if already timing a region.
     void enter(region_id_type index);
@@ -77,7 +96,7 @@ public:
     // Throws std::runtime_error if not currently timing a region.
     void leave();
 
-    // Reset all of the accumulated call counts and times to zero.
+    // Reset all of the accumulated call counts and times to zero, and drop the trace.
     void clear();
 };
 
@@ -87,6 +106,21 @@ class profiler {
 
     std::unordered_map<std::thread::id, std::size_t> thread_ids_;
 
+    // Each thread caches the index of its recorder, which is valid while the
+    // generation matches that of the profiler, i.e. until re-initialization.
+    struct thread_slot {
+        std::size_t generation = 0;
+        std::size_t index = 0;
+    };
+    static thread_local thread_slot slot_;
+    std::size_t generation_ = 0;
+
+    // Rank of this process, used as the process id in exported traces.
+    int rank_ = 0;
+
+    // Start of the timeline of exported traces.
+    tick_type trace_origin_;
+
     // Hash table that maps region names to a unique index.
     // The regions are assigned consecutive indexes in the order that they are
     // added to the profiler with calls to `region_index()`, with the first
@@ -103,10 +137,17 @@ class profiler {
     // Flag to indicate whether the profiler has been initialized with the task_system
     bool init_ = false;
 
+    recorder& current_recorder() {
+        if (slot_.generation!=generation_) {
+            slot_ = {generation_, thread_ids_.at(std::this_thread::get_id())};
+        }
+        return recorders_[slot_.index];
+    }
+
 public:
     profiler();
 
-    void initialize(task_system_handle& ts);
+    void initialize(task_system_handle& ts, int rank);
     void enter(region_id_type index);
     void enter(const std::string& name);
     void leave();
@@ -114,6 +155,9 @@ public:
     region_id_type region_index(const std::string& name);
     profile results() const;
 
+    void enable_trace(std::size_t capacity);
+    void write_trace(std::ostream& os) const;
+
     static profiler& get_global_profiler() {
         static profiler p;
         return p;
@@ -169,38 +213,125 @@ void recorder::leave() {
     }
     accumulators_[index_].count++;
     accumulators_[index_].time += delta;
+    if (auto n = trace_.size()) {
+        trace_[trace_count_++%n] = {start_time_, std::int64_t(delta/timer::scale), index_};
+    }
     index_ = npos;
 }
 
 void recorder::clear() {
     index_ = npos;
     accumulators_.resize(0);
+    trace_count_ = 0;
+}
+
+void recorder::set_trace_capacity(std::size_t capacity) {
+    trace_.assign(capacity, trace_event{});
+    trace_count_ = 0;
+}
+
+std::vector<trace_event> recorder::trace() const {
+    const auto n = trace_.size();
+    if (trace_count_<=n) return {trace_.begin(), trace_.begin()+trace_count_};
+
+    // The buffer has wrapped around: the oldest event follows the newest.
+    const auto head = trace_.begin()+trace_count_%n;
+    std::vector<trace_event> events(head, trace_.end());
+    events.insert(events.end(), trace_.begin(), head);
+    return events;
 }
 
 // profiler implementation
 
+thread_local profiler::thread_slot profiler::slot_;
+
 profiler::profiler() {}
 
-void profiler::initialize(task_system_handle& ts) {
+void profiler::initialize(task_system_handle& ts, int rank) {
     recorders_.resize(ts.get()->get_num_threads());
     thread_ids_ = ts.get()->get_thread_ids();
+    rank_ = rank;
+    trace_origin_ = timer::tic();
+    ++generation_;
     init_ = true;
 }
 
 void profiler::enter(region_id_type index) {
     if (!init_) return;
-    recorders_[thread_ids_.at(std::this_thread::get_id())].enter(index);
+    current_recorder().enter(index);
 }
 
 void profiler::enter(const std::string& name) {
     if (!init_) return;
     const auto index = region_index(name);
-    recorders_[thread_ids_.at(std::this_thread::get_id())].enter(index);
+    current_recorder().enter(index);
 }
 
 void profiler::leave() {
     if (!init_) return;
-    recorders_[thread_ids_.at(std::this_thread::get_id())].leave();
+    current_recorder().leave();
+}
+
+void profiler::enable_trace(std::size_t capacity) {
+    for (auto& r: recorders_) r.set_trace_capacity(capacity);
+}
+
+// Write nanoseconds as microseconds with three decimals, exactly.
+static void write_us(std::ostream& os, std::int64_t ns) {
+    if (ns<0) {
+        os << '-';
+        ns = -ns;
+    }
+    auto frac = ns%1000;
+    os << ns/1000 << '.' << char('0'+frac/100) << char('0'+frac/10%10) << char('0'+frac%10);
+}
+
+// Write a string as a JSON string literal.
+static void write_json_string(std::ostream& os, const std::string& s) {
+    static const char* hex = "0123456789abcdef";
+    os << '"';
+    for (unsigned char c: s) {
+        switch (c) {
+        case '"':  os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (c<0x20) os << "\\u00" << hex[c>>4] << hex[c&15];
+            else os << c;
+        }
+    }
+    os << '"';
+}
+
+// Write the traces of all threads as Chrome trace-event JSON, with one
+// complete event per region visit and metadata naming ranks and threads.
+void profiler::write_trace(std::ostream& os) const {
+    auto ns = [this](tick_type t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t - trace_origin_).count();
+    };
+
+    os << "{\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank_
+       << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank_ << "\"}}";
+    for (auto tid: make_span(recorders_.size())) {
+        os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank_
+           << ",\"tid\":" << tid << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+    }
+    for (auto tid: make_span(recorders_.size())) {
+        for (const auto& e: recorders_[tid].trace()) {
+            os << ",\n{\"name\":";
+            write_json_string(os, region_names_[e.index]);
+            os << ",\"cat\":\"arbor\",\"ph\":\"X\",\"pid\":" << rank_
+               << ",\"tid\":" << tid
+               << ",\"ts\":";
+            write_us(os, ns(e.start));
+            os << ",\"dur\":";
+            write_us(os, e.duration_ns);
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
 }
 
 region_id_type profiler::region_index(const std::string& name) {
@@ -407,7 +538,18 @@ ARB_ARBOR_API void profiler_enter(region_id_type region_id) {
 }
 
 ARB_ARBOR_API void profiler_initialize(context ctx) {
-    profiler::get_global_profiler().initialize(ctx->thread_pool);
+    // Start the trace clocks of all ranks together.
+    ctx->distributed->barrier();
+    profiler::get_global_profiler().initialize(ctx->thread_pool, ctx->distributed->id());
+}
+
+ARB_ARBOR_API void profiler_enable_trace(std::size_t capacity) {
+    profiler::get_global_profiler().enable_trace(capacity);
+}
+
+ARB_ARBOR_API std::ostream& profiler_write_trace(std::ostream& os) {
+    profiler::get_global_profiler().write_trace(os);
+    return os;
 }
 
 // Print profiler statistics to an ostream
@@ -438,6 +580,8 @@ ARB_ARBOR_API profile profiler_summary() {return profile();}
 ARB_ARBOR_API region_id_type profiler_region_id(const std::string&) {return 0;}
 ARB_ARBOR_API std::ostream& operator<<(std::ostream& o, const profile&) {return o;}
 ARB_ARBOR_API std::ostream& profiler_print_summary(std::ostream& os, double limit) { return os; }
+ARB_ARBOR_API void profiler_enable_trace(std::size_t) {}
+ARB_ARBOR_API std::ostream& profiler_write_trace(std::ostream& os) { return os; }
 
 
 #endif // ARB_HAVE_PROFILING
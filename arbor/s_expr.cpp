@@ -1,5 +1,8 @@
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -374,6 +377,24 @@ private:
 // s expression members
 //
 
+// Spell reals as std::to_string does, unless that loses precision, as it
+// does for small values; then use the fewest significant digits that do not.
+static std::string real_spelling(double x) {
+    auto s = std::to_string(x);
+    if (x!=x || std::strtod(s.c_str(), nullptr)==x) return s;
+
+    char buf[32];
+    for (int p = 7; p<=std::numeric_limits<double>::max_digits10; ++p) {
+        std::snprintf(buf, sizeof buf, "%.*g", p, x);
+        if (std::strtod(buf, nullptr)==x) break;
+    }
+    return buf;
+}
+
+s_expr::s_expr(double x):
+    s_expr(token{{0,0}, tok::real, real_spelling(x)})
+{}
+
 bool s_expr::is_atom() const {
     return state.index()==0;
 }
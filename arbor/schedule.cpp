@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 #include <arbor/common_types.hpp>
@@ -6,36 +9,49 @@
 
 namespace arb {
 
-// Schedule at Poisson point process with rate 1/mean_dt,
-// restricted to non-negative times.
+// Schedule at a Poisson point process with piecewise constant rate: rates_[k]
+// in [bounds_[k], bounds_[k+1]), no events outside [bounds_.front(), bounds_.back()).
+//
+// Events are drawn by time rescaling: exponential intervals of unit mean are
+// mapped through the rate integrated from the last event. The intervals are
+// drawn in batches, one engine draw each, such that the transform to the
+// exponential distribution runs as a loop over the batch. With a single
+// rate, this gives the sequence of std::exponential_distribution.
 struct poisson_schedule_impl {
+    static constexpr std::size_t batch_size = 64;
+    static constexpr time_type max_uniform = 1 - 0x1p-53;
+
+    poisson_schedule_impl(std::vector<time_type> bounds, std::vector<time_type> rates, seed_type seed):
+        bounds_(std::move(bounds)), rates_(std::move(rates)), rng_(seed), seed_(seed) {
+        arb_assert(bounds_.empty() || bounds_.size()==rates_.size()+1);
+        reset();
+    }
+
     poisson_schedule_impl(time_type tstart, time_type rate_kHz, seed_type seed, time_type tstop):
-        tstart_(tstart), rate_(rate_kHz), exp_(rate_kHz), rng_(seed), seed_(seed), next_(tstart), tstop_(tstop) {
-        if (!std::isfinite(tstart_))  throw std::domain_error("Poisson schedule: start must be finite and in [ms]");
-        if (!std::isfinite(tstop_))   throw std::domain_error("Poisson schedule: stop must be finite and in [ms]");
+        poisson_schedule_impl(check(tstart, rate_kHz, tstop), {rate_kHz}, seed) {}
+
+    static std::vector<time_type> check(time_type tstart, time_type rate_kHz, time_type tstop) {
+        if (!std::isfinite(tstart))  throw std::domain_error("Poisson schedule: start must be finite and in [ms]");
+        if (!std::isfinite(tstop))   throw std::domain_error("Poisson schedule: stop must be finite and in [ms]");
         if (!std::isfinite(rate_kHz)) throw std::domain_error("Poisson schedule: rate must be finite and in [kHz]");
-        if (!std::isfinite(tstart_) || tstart_ < 0) throw std::domain_error("Poisson schedule: start must be >= 0 and finite.");
-        if (!std::isfinite(tstop_)  || tstop_ < tstart_) throw std::domain_error("Poisson schedule: stop must be >= start and finite.");
-        step();
+        if (tstart < 0) throw std::domain_error("Poisson schedule: start must be >= 0 and finite.");
+        if (tstop < tstart) throw std::domain_error("Poisson schedule: stop must be >= start and finite.");
+        if (rate_kHz < 0) throw std::domain_error("Poisson schedule: rate must be >= 0 and finite.");
+        return {tstart, tstop};
     }
 
     void reset() {
         rng_ = engine_type{seed_};
         if (discard_ > 0) rng_.discard(discard_);
-        exp_ = std::exponential_distribution<time_type>{rate_};
-        next_ = tstart_;
+        pos_ = batch_size;
+        segment_ = 0;
+        next_ = bounds_.empty()? terminal_time: bounds_.front();
         step();
     }
 
     void discard(std::size_t n) { discard_ = n; reset(); }
 
     time_event_span events(time_type t0, time_type t1) {
-        // if we start after the maximal allowed time, we have nothing to do
-        if (t0 >= tstop_) return {};
-
-        // restrict by maximal allowed time
-        t1 = std::min(t1, tstop_);
-
         times_.clear();
 
         while (next_ < t0) { step(); }
@@ -48,14 +64,38 @@ struct poisson_schedule_impl {
         return as_time_event_span(times_);
     }
 
-    void step() { next_ += exp_(rng_); }
+    void step() {
+        if (pos_ == batch_size) draw_batch();
+        auto x = batch_[pos_++];
+        for (; segment_ < rates_.size(); next_ = bounds_[++segment_]) {
+            auto r = rates_[segment_];
+            auto mass = r*(bounds_[segment_+1] - next_);
+            if (r > 0 && x < mass) {
+                next_ += x/r;
+                return;
+            }
+            x -= mass;
+        }
+        next_ = terminal_time;
+    }
+
+    void draw_batch() {
+        std::array<std::uint64_t, batch_size> bits;
+        for (auto& b: bits) b = rng_();
+        // Uniform in [0, 1), as std::generate_canonical, then exponential.
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            auto u = std::min(time_type(bits[i])*0x1p-64, max_uniform);
+            batch_[i] = -std::log(1 - u);
+        }
+        pos_ = 0;
+    }
 
     template<typename K>
     void t_serialize(::arb::serializer& ser, const K& k) const {
         const auto& t = *this;
         ser.begin_write_map(arb::to_serdes_key(k));
-        ARB_SERDES_WRITE(tstart_);
-        ARB_SERDES_WRITE(tstop_);
+        ARB_SERDES_WRITE(bounds_);
+        ARB_SERDES_WRITE(rates_);
         ser.end_write_map();
     }
 
@@ -63,21 +103,23 @@ struct poisson_schedule_impl {
     void t_deserialize(::arb::serializer& ser, const K& k) {
         auto& t = *this;
         ser.begin_read_map(arb::to_serdes_key(k));
-        ARB_SERDES_READ(tstart_);
-        ARB_SERDES_READ(tstop_);
+        ARB_SERDES_READ(bounds_);
+        ARB_SERDES_READ(rates_);
         ser.end_read_map();
         t.reset();
     }
 
-    time_type tstart_;
-    time_type rate_;
-    std::exponential_distribution<time_type> exp_;
+    std::vector<time_type> bounds_;
+    std::vector<time_type> rates_;
     engine_type rng_;
     seed_type seed_;
-    time_type next_;
-    std::vector<time_type> times_;
-    time_type tstop_;
     std::size_t discard_ = 0;
+
+    std::array<time_type, batch_size> batch_;
+    std::size_t pos_ = batch_size;
+    std::size_t segment_ = 0;
+    time_type next_ = terminal_time;
+    std::vector<time_type> times_;
 };
 
 schedule poisson_schedule(const units::quantity& tstart,
@@ -96,6 +138,35 @@ schedule poisson_schedule(const units::quantity& rate,
     return poisson_schedule(0.*units::ms, rate, seed, tstop);
 }
 
+schedule poisson_superposition_schedule(const std::vector<poisson_source>& sources, seed_type seed) {
+    // Sweep over the starts and stops of the sources, summing the rates.
+    struct edge { time_type t; time_type rate; int count; };
+    std::vector<edge> edges;
+    for (const auto& src: sources) {
+        auto rate = src.rate.value_as(units::kHz);
+        auto b = poisson_schedule_impl::check(src.tstart.value_as(units::ms), rate, src.tstop.value_as(units::ms));
+        if (b[0] == b[1] || rate == 0) continue;
+        edges.push_back({b[0], rate, 1});
+        edges.push_back({b[1], -rate, -1});
+    }
+    std::sort(edges.begin(), edges.end(), [](const auto& l, const auto& r) { return l.t < r.t; });
+
+    std::vector<time_type> bounds, rates;
+    time_type rate = 0;
+    int active = 0;
+    for (std::size_t i = 0; i < edges.size();) {
+        auto t = edges[i].t;
+        for (; i < edges.size() && edges[i].t == t; ++i) {
+            rate += edges[i].rate;
+            active += edges[i].count;
+        }
+        // Rates of sources that have stopped must not linger as round-off.
+        if (!active) rate = 0;
+        bounds.push_back(t);
+        if (i < edges.size()) rates.push_back(std::max(rate, 0.));
+    }
+    return schedule(poisson_schedule_impl(std::move(bounds), std::move(rates), seed));
+}
 
 struct empty_schedule_impl {
     void reset() {}
@@ -1,10 +1,12 @@
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <arbor/arbexcept.hpp>
 #include <arbor/context.hpp>
 #include <arbor/domain_decomposition.hpp>
 #include <arbor/export.hpp>
+#include <arbor/profile/timer.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/schedule.hpp>
 #include <arbor/simple_sampler.hpp>
@@ -14,6 +16,7 @@
 #include "cell_group.hpp"
 #include "cell_group_factory.hpp"
 #include "communication/communicator.hpp"
+#include "communication/gap_junction_exchange.hpp"
 #include "merge_events.hpp"
 #include "thread_private_spike_store.hpp"
 #include "threading/threading.hpp"
@@ -84,6 +87,10 @@ struct simulation_state {
 
     std::vector<probe_metadata> get_probe_metadata(const cell_address_type&) const;
 
+    std::vector<mechanism_counters> get_mechanism_counters() const;
+
+    std::vector<epoch_metrics> get_epoch_metrics() const;
+
     std::size_t num_spikes() const {
         return communicator_.num_spikes();
     }
@@ -175,6 +182,11 @@ private:
     task_system_handle task_system_;
     communicator communicator_;
 
+    // Gap junctions coupled across cell groups, if enabled: the maximum
+    // interval between exchanges of peer voltages, and the exchange.
+    std::optional<time_type> gj_coupling_interval_;
+    gap_junction_exchange gj_exchange_;
+
     // Pending events to be delivered.
     std::vector<pse_vector> pending_events_;
     std::array<std::vector<pse_vector>, 2> event_lanes_;
@@ -185,14 +197,27 @@ private:
     // Sampler associations handles are managed by a helper class.
     util::handle_set<sampler_association_handle> sassoc_handles_;
 
+    // Metrics of the most recent epochs run since the last reset, a ring
+    // buffer with the oldest at metrics_begin_, and per group advance times
+    // and counts of the epoch being updated.
+    static constexpr std::size_t max_epoch_metrics = 1<<14;
+    std::vector<epoch_metrics> metrics_;
+    std::size_t metrics_begin_ = 0;
+    std::vector<double> group_advance_time_;
+    std::vector<std::uint64_t> group_spikes_;
+    std::vector<std::uint64_t> group_events_;
+
     // Accessors to events
     std::vector<pse_vector>& event_lanes(std::ptrdiff_t epoch_id) { return event_lanes_[epoch_id&1]; }
     thread_private_spike_store& local_spikes(std::ptrdiff_t epoch_id) { return local_spikes_[epoch_id&1]; }
 
-    // Apply a functional to each cell group in parallel.
+    // Apply a functional to each cell group in parallel. Each group is
+    // preferably handled by the same thread each time, in particular the one
+    // that constructed it, such that its state was first touched, and hence
+    // placed, on the NUMA node of the thread that advances it.
     template <typename L>
     void foreach_group(L&& fn) {
-        threading::parallel_for::apply(0, cell_groups_.size(), task_system_.get(),
+        threading::parallel_for::apply_pinned(0, cell_groups_.size(), task_system_.get(),
             [&, fn = std::forward<L>(fn)](int i) { fn(cell_groups_[i]); });
     }
 
@@ -200,7 +225,7 @@ private:
     // the cell group pointer reference and index.
     template <typename L>
     void foreach_group_index(L&& fn) {
-        threading::parallel_for::apply(0, cell_groups_.size(), task_system_.get(),
+        threading::parallel_for::apply_pinned(0, cell_groups_.size(), task_system_.get(),
             [&, fn = std::forward<L>(fn)](int i) { fn(cell_groups_[i], i); });
     }
 
@@ -253,14 +278,21 @@ simulation_state::simulation_state(const recipe& rec,
     for(auto gidx: util::make_span(num_groups)) local_targets.append(std::move(cg_targets[gidx]));
     target_resolution_map_ = label_resolution_map(std::move(local_targets));
     PL();
+
+    PE(init:simulation:gapjunctions);
+    gj_coupling_interval_ = gap_junction_coupling_interval(rec);
+    if (gj_coupling_interval_) gj_exchange_ = gap_junction_exchange(*ddc_, cell_groups_, ctx_);
+    PL();
     update(rec);
     epoch_.reset();
 }
 
 void simulation_state::update(const recipe& rec) {
     communicator_.update_connections(rec, ddc_, source_resolution_map_, target_resolution_map_);
-    // Use half minimum delay of the network for max integration interval.
+    // Use half minimum delay of the network for max integration interval, and
+    // exchange the voltages of gap junction peers in other groups after each.
     t_interval_ = min_delay()/2;
+    if (gj_exchange_.num_sites()) t_interval_ = std::min(t_interval_, *gj_coupling_interval_);
 
     const auto num_local_cells = communicator_.num_local_cells();
     // Initialize empty buffers for pending events for each local cell
@@ -316,6 +348,9 @@ void simulation_state::reset() {
     for (auto& lane: pending_events_) lane.clear();
     for (auto& spikes: local_spikes_) spikes.clear();
 
+    metrics_.clear();
+    metrics_begin_ = 0;
+
     communicator_.reset();
     epoch_.reset();
 }
@@ -384,31 +419,65 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
         return next;
     };
 
+    // Couple task: exchange voltages between gap junction sites in different cell groups,
+    // once all groups are at the end of an epoch; peer voltages are then held constant
+    // throughout the next.
+    auto couple = [this]() {
+        gj_exchange_.exchange(cell_groups_);
+    };
+
+    using profile::timer;
+    const auto n_group = cell_groups_.size();
+    group_advance_time_.assign(n_group, 0);
+    group_spikes_.assign(n_group, 0);
+    group_events_.assign(n_group, 0);
+
     // Update task: advance cell groups to end of current epoch and store spikes in local_spikes_.
-    auto update = [this, dt](epoch current) {
+    auto update = [this, dt, n_group](epoch current, epoch_metrics& m) {
+        auto t_update = timer::tic();
         local_spikes(current.id).clear();
         foreach_group_index(
             [&](cell_group_ptr& group, int i) {
+                auto t_group = timer::tic();
                 auto queues = util::subrange_view(event_lanes(current.id), communicator_.group_queue_range(i));
+                std::uint64_t n_event = 0;
+                for (const auto& lane: queues) {
+                    n_event += std::lower_bound(lane.begin(), lane.end(), current.t1,
+                                                [](auto const& l, auto r) noexcept { return l.time < r; }) - lane.begin();
+                }
                 group->advance(current, dt, queues);
 
                 PE(advance:spikes);
+                group_spikes_[i] = group->spikes().size();
                 local_spikes(current.id).insert(group->spikes());
                 group->clear_spikes();
                 PL();
+                group_events_[i] = n_event;
+                group_advance_time_[i] = timer::toc(t_group);
             });
+        m.update = timer::toc(t_update);
+        for (auto i: util::make_span(n_group)) {
+            m.advance_max = std::max(m.advance_max, group_advance_time_[i]);
+            m.advance_mean += group_advance_time_[i];
+            m.num_spikes += group_spikes_[i];
+            m.num_events += group_events_[i];
+        }
+        if (n_group) m.advance_mean /= n_group;
     };
 
     // Exchange task: gather previous locally generated spikes, distribute across all ranks, and deliver
     // post-synaptic spike events to per-cell pending event vectors.
-    auto exchange = [this](epoch prev) {
+    auto exchange = [this](epoch prev, epoch_metrics& m) -> double {
+        auto t_exchange = timer::tic();
         // Collate locally generated spikes.
         PE(communication:exchange:gatherlocal);
         auto all_local_spikes = local_spikes(prev.id).gather();
         PL();
         communicator_.remote_ctrl_send_continue(prev);
         // Gather generated spikes across all ranks.
+        auto t_gather = timer::tic();
         auto spikes = communicator_.exchange(all_local_spikes);
+        m.gather = timer::toc(t_gather);
 
         // Present spikes to user-supplied callbacks.
         PE(communication:spikeio);
@@ -420,11 +489,14 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
         PE(communication:walkspikes);
         communicator_.make_event_queues(spikes, pending_events_);
         PL();
+        m.exchange = timer::toc(t_exchange);
+        return m.exchange;
     };
 
     // Enqueue task: build event_lanes for next epoch from pending events, event-generator events for the
     // next epoch, and with any unprocessed events from the current event_lanes.
-    auto enqueue = [this](epoch next) {
+    auto enqueue = [this](epoch next, epoch_metrics& m) -> double {
+        auto t_enqueue = timer::tic();
         foreach_cell(
             [&](cell_size_type i) {
                 // NOTE Despite the superficial optics, we need to sort by the
@@ -461,6 +533,31 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
                                   event_lanes(next.id)[i]);                              // out: merged events
                 pending_events_[i].clear();
             });
+        m.enqueue = timer::toc(t_enqueue);
+        return m.enqueue;
+    };
+
+    // Start the metrics of an epoch, replacing the oldest if the buffer is
+    // full. The exchange and enqueue serving an epoch are recorded with it,
+    // though they run concurrently with the update of its neighbours.
+    auto record = [this](epoch e) {
+        epoch_metrics m;
+        m.id = e.id;
+        m.t0 = e.t0;
+        m.t1 = e.t1;
+        if (metrics_.size()<max_epoch_metrics) {
+            metrics_.push_back(m);
+        }
+        else {
+            metrics_[metrics_begin_] = m;
+            metrics_begin_ = (metrics_begin_+1)%max_epoch_metrics;
+        }
+    };
+
+    // Metrics of the k-th most recently recorded epoch.
+    auto recent = [this](std::size_t k) -> epoch_metrics& {
+        auto n = metrics_.size();
+        return metrics_[(metrics_begin_+n-1-k)%n];
     };
 
     epoch prev = epoch_;
@@ -469,18 +566,31 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
 
     if (epoch_callback_) epoch_callback_(current.t0, tfinal);
 
+    couple();
     if (next.empty()) {
-        enqueue(current);
-        update(current);
-        exchange(current);
+        record(current);
+        auto& m = recent(0);
+        enqueue(current, m);
+        auto t_step = timer::tic();
+        update(current, m);
+        m.step = timer::toc(t_step);
+        exchange(current, m);
+        couple();
         if (epoch_callback_) epoch_callback_(current.t1, tfinal);
     }
     else {
-        enqueue(current);
+        record(current);
+        enqueue(current, recent(0));
+        record(next);
+        auto* m_current = &recent(1);
+        auto* m_next = &recent(0);
         threading::task_group g(task_system_.get());
-        g.run([&]() { enqueue(next); });
-        g.run([&]() { update(current); });
+        auto t_step = timer::tic();
+        g.run([&]() { m_current->communication = enqueue(next, *m_next); });
+        g.run([&]() { update(current, *m_current); });
         g.wait();
+        m_current->step = timer::toc(t_step);
+        couple();
         if (epoch_callback_) epoch_callback_(current.t1, tfinal);
 
         for (;;) {
@@ -489,17 +599,30 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
             next = next_epoch(next, t_interval_);
             if (next.empty()) break;
 
-            g.run([&]() { exchange(prev); enqueue(next); });
-            g.run([&]() { update(current); });
+            record(next);
+            auto* m_prev = &recent(2);
+            m_current = &recent(1);
+            m_next = &recent(0);
+            t_step = timer::tic();
+            g.run([&]() { m_current->communication = exchange(prev, *m_prev) + enqueue(next, *m_next); });
+            g.run([&]() { update(current, *m_current); });
             g.wait();
+            m_current->step = timer::toc(t_step);
+            couple();
             if (epoch_callback_) epoch_callback_(current.t1, tfinal);
         }
 
-        g.run([&]() { exchange(prev); });
-        g.run([&]() { update(current); });
+        auto* m_prev = &recent(1);
+        m_current = &recent(0);
+        t_step = timer::tic();
+        g.run([&]() { m_current->communication = exchange(prev, *m_prev); });
+        g.run([&]() { update(current, *m_current); });
         g.wait();
+        m_current->step = timer::toc(t_step);
+        couple();
 
-        exchange(current);
+        // The exchange of the last epoch is not overlapped with any update.
+        exchange(current, *m_current);
         if (epoch_callback_) epoch_callback_(current.t1, tfinal);
     }
 
@@ -539,6 +662,44 @@ std::vector<probe_metadata> simulation_state::get_probe_metadata(const cell_addr
     }
 }
 
+std::vector<mechanism_counters> simulation_state::get_mechanism_counters() const {
+    std::vector<mechanism_counters> result;
+    for (cell_size_type ix = 0; ix<cell_groups_.size(); ++ix) {
+        for (auto& c: cell_groups_[ix]->get_mechanism_counters()) {
+            c.group = ix;
+            result.push_back(std::move(c));
+        }
+    }
+    return result;
+}
+
+std::vector<epoch_metrics> simulation_state::get_epoch_metrics() const {
+    // Reduce the update time of each epoch across ranks; all ranks run, and
+    // keep the metrics of, the same epochs. Gathering the times of all ranks
+    // would grow with the number of ranks, so the maximum and sum are taken
+    // element-wise in one collective each.
+    const auto& dist = ctx_->distributed;
+    const auto n_rank = dist->size();
+    const auto n = metrics_.size();
+
+    std::vector<epoch_metrics> result;
+    result.reserve(n);
+    std::vector<double> update;
+    update.reserve(n);
+    for (auto i: util::make_span(n)) {
+        result.push_back(metrics_[(metrics_begin_+i)%n]);
+        update.push_back(result.back().update);
+    }
+
+    auto update_max = dist->max_values(update);
+    auto update_sum = dist->sum_values(update);
+    for (auto i: util::make_span(n)) {
+        result[i].rank_update_max = update_max[i];
+        result[i].rank_update_mean = update_sum[i]/n_rank;
+    }
+    return result;
+}
+
 // Simulation class implementations forward to implementation class.
 
 simulation_builder simulation::create(recipe const & rec) { return {rec}; };
@@ -584,6 +745,14 @@ std::vector<probe_metadata> simulation::get_probe_metadata(const cell_address_ty
     return impl_->get_probe_metadata(probeset_id);
 }
 
+std::vector<mechanism_counters> simulation::get_mechanism_counters() const {
+    return impl_->get_mechanism_counters();
+}
+
+std::vector<epoch_metrics> simulation::get_epoch_metrics() const {
+    return impl_->get_epoch_metrics();
+}
+
 std::size_t simulation::num_spikes() const {
     return impl_->num_spikes();
 }
@@ -183,6 +183,15 @@ void task_system::async(priority_task ptsk) {
     }
 }
 
+void task_system::async(priority_task ptsk, unsigned index) {
+    if (ptsk.priority>=n_priority) {
+        run(std::move(ptsk));
+    }
+    else {
+        q_[index % count_].push(std::move(ptsk));
+    }
+}
+
 std::unordered_map<std::thread::id, std::size_t> task_system::get_thread_ids() const {
     return thread_ids_;
 };
@@ -184,6 +184,11 @@ public:
     // else equivalent to task_system::run(priority_task) below.
     void async(priority_task ptsk);
 
+    // Public interface: as above, but push the task onto the notification queue
+    // of the thread with the given index (modulo the number of threads), which
+    // will run it unless it is taken first by an otherwise idle thread.
+    void async(priority_task ptsk, unsigned index);
+
     // Public interface: run task synchronously with current task priority set.
     void run(priority_task ptsk);
 
@@ -358,6 +363,15 @@ public:
         task_system_->async(priority_task{make_wrapped_function(std::forward<F>(f), in_flight_, exception_status_), priority});
     }
 
+    // Adds a new task with a given priority to be executed, preferably by the
+    // thread with the given index; see task_system::async.
+    template<typename F>
+    void run(F&& f, int priority, unsigned index) {
+        running_ = true;
+        ++in_flight_;
+        task_system_->async(priority_task{make_wrapped_function(std::forward<F>(f), in_flight_, exception_status_), priority}, index);
+    }
+
     // Wait till all tasks in this group are done.
     // While waiting the thread will participate in executing the tasks.
     // It's necessary that the waiting thread participate in execution:
@@ -407,6 +421,21 @@ struct parallel_for {
     static void apply(int left, int right, task_system* ts, F f) {
         apply(left, right, 1, ts, std::move(f));
     }
+
+    // As apply with a batch size of 1, but the task for index i is queued for
+    // the thread i modulo the number of threads. Repeated loops over the same
+    // range then run each index on the same thread, unless an idle thread
+    // steals it, such that data allocated and first touched for index i in
+    // one loop are local to the thread, and its NUMA node, in the next.
+    template <typename F>
+    static void apply_pinned(int left, int right, task_system* ts, F f) {
+        task_group g(ts);
+        int priority = task_system::get_task_priority()+1;
+        for (int i = left; i < right; ++i) {
+            g.run([=] { f(i); }, priority, i);
+        }
+        g.wait();
+    }
 };
 } // namespace threading
 
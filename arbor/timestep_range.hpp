@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iosfwd>
 #include <limits>
+#include <vector>
 
 #include <arbor/assert.hpp>
 #include <util/iterutil.hpp>
@@ -15,6 +16,8 @@ namespace arb {
 // length dt. The last timestep is adjusted to match t1 and is either shorter or minimally longer
 // than the specified dt. The range can be iterated over and the iterators derefernce to objects of
 // type `timestep` which can be queried for start and end times, as well as dt and midpoint.
+// Alternatively, a timestep_range can be built from an explicit, strictly increasing sequence of
+// step boundaries, yielding time steps of varying length.
 class timestep_range {
 public: // member types
     // Representation of a time step
@@ -35,10 +38,13 @@ private: // members
     time_type t1_;
     time_type dt_;
     size_type n_;
+    // Step boundaries t0_, ..., t1_ if not equally spaced, empty otherwise.
+    std::vector<time_type> bounds_;
 
 public: // access
     timestep operator[](size_type i) const noexcept {
         arb_assert(i < n_);
+        if (!bounds_.empty()) return {bounds_[i], bounds_[i+1]};
         return { t0_+ i*dt_, i+1 >= n_ ? t1_ : t0_ + (i+1)*dt_};
     }
 
@@ -70,6 +76,7 @@ public: // ctors, assignment, reset
     timestep_range(time_type t1, time_type dt) { reset(t1, dt); }
     timestep_range(const epoch& ep, time_type dt) { reset(ep, dt); }
     timestep_range(time_type t0, time_type t1, time_type dt) { reset(t0, t1, dt); }
+    explicit timestep_range(std::vector<time_type> bounds) { reset(std::move(bounds)); }
 
     timestep_range(timestep_range&&) noexcept = default;
     timestep_range(const timestep_range&) = default;
@@ -90,6 +97,7 @@ public: // ctors, assignment, reset
     }
 
     timestep_range& reset(time_type t0, time_type t1, time_type dt) {
+        bounds_.clear();
         t0_ = t0;
         t1_ = t1;
         dt = dt < 0 ? (t1-t0) : dt;
@@ -104,6 +112,21 @@ public: // ctors, assignment, reset
         return *this;
     }
 
+    // Steps between consecutive entries of `bounds`, which must be strictly increasing.
+    timestep_range& reset(std::vector<time_type> bounds) {
+        if (bounds.size() < 2) {
+            const time_type t = bounds.empty()? 0: bounds.front();
+            return reset(t, t, 1);
+        }
+        arb_assert(std::is_sorted(bounds.begin(), bounds.end()));
+        t0_ = bounds.front();
+        t1_ = bounds.back();
+        n_ = bounds.size() - 1;
+        dt_ = (t1_ - t0_)/n_;
+        bounds_ = std::move(bounds);
+        return *this;
+    }
+
 public: // access and queries
     time_type t_begin() const noexcept { return t0_; }
     time_type t_end() const noexcept { return t1_; }
@@ -116,6 +139,10 @@ public: // access and queries
 
     const_iterator find(time_type t) const noexcept {
         if (!n_ || t < t0_ || t >= t1_) return end();
+        if (!bounds_.empty()) {
+            const size_type n = std::upper_bound(bounds_.begin(), bounds_.end(), t) - bounds_.begin();
+            return {this, n - 1};
+        }
         const auto n = std::min((size_type)((t-t0_)/dt_), n_-1);
         const auto [t0,t1] = this->operator[](n);
         if (t>=t0 && t<t1) return {this, n};
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <system_error>
+
+#include "arena.hpp"
+
+#ifdef __linux__
+extern "C" {
+    #include <sys/mman.h>
+}
+#endif
+
+namespace arb {
+namespace util {
+
+static std::atomic<std::int64_t> total_reserved_{0};
+
+// Chunks start small, so that groups of a few cells do not hold a huge page
+// each, and double up to the huge page size.
+static constexpr std::size_t min_chunk_size = std::size_t(1)<<16;
+
+static std::size_t round_up(std::size_t v, std::size_t b) {
+    return (v+b-1)/b*b;
+}
+
+arena::arena(bool huge_pages): huge_pages_(huge_pages) {}
+
+arena::~arena() {
+    for (auto& c: chunks_) std::free(c.data);
+    total_reserved_ -= reserved_;
+}
+
+void* arena::allocate(std::size_t size, std::size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto p = (char*)round_up((std::uintptr_t)head_, alignment);
+    if (!head_ || p+size>end_) {
+        add_chunk(size+alignment);
+        p = (char*)round_up((std::uintptr_t)head_, alignment);
+    }
+    last_ = p;
+    head_ = p+size;
+    used_ += size;
+    return p;
+}
+
+void arena::deallocate(void* p, std::size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    used_ -= size;
+    if (p && p==last_ && (char*)p+size==head_) {
+        head_ = last_;
+        last_ = nullptr;
+    }
+}
+
+void arena::add_chunk(std::size_t min_size) {
+    auto size = std::clamp(reserved_, min_chunk_size, huge_page_size);
+    size = round_up(std::max(size, min_size), huge_pages_? huge_page_size: min_chunk_size);
+    auto align = huge_pages_? huge_page_size: min_chunk_size;
+
+    void* data = nullptr;
+    if (auto err = posix_memalign(&data, align, size)) {
+        throw std::system_error(err, std::generic_category(), "posix_memalign");
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Advisory only: ignore failure, e.g. if transparent huge pages are disabled.
+    if (huge_pages_) madvise(data, size, MADV_HUGEPAGE);
+#endif
+
+    chunks_.push_back({data, size});
+    head_ = (char*)data;
+    end_ = head_+size;
+    last_ = nullptr;
+    reserved_ += size;
+    total_reserved_ += size;
+}
+
+std::size_t arena::reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reserved_;
+}
+
+std::size_t arena::used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_;
+}
+
+std::int64_t arena::total_reserved() {
+    return total_reserved_;
+}
+
+} // namespace util
+} // namespace arb
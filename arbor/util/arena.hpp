@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <arbor/export.hpp>
+
+namespace arb {
+namespace util {
+
+// Bump allocator for the long-lived arrays of one cell group.
+//
+// Memory is handed out in order from chunks that grow geometrically up to the
+// size of a huge page, such that the arrays of a group lie next to each other
+// in as few pages as possible. With huge pages enabled, chunks are multiples
+// of 2 MiB, aligned to 2 MiB, and advised for transparent huge pages where
+// the OS supports it.
+//
+// Memory is returned to the OS only when the arena is destroyed; deallocating
+// the most recent allocation makes its space available again, deallocating
+// any other only updates the count of bytes in use.
+class ARB_ARBOR_API arena {
+public:
+    static constexpr std::size_t huge_page_size = std::size_t(1)<<21;
+
+    explicit arena(bool huge_pages = false);
+    ~arena();
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    // Return size bytes aligned to alignment, a power of two.
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate(void* p, std::size_t size);
+
+    bool huge_pages() const { return huge_pages_; }
+
+    // Bytes held in chunks, and in allocations not yet deallocated.
+    std::size_t reserved() const;
+    std::size_t used() const;
+
+    // Bytes held in chunks by all arenas.
+    static std::int64_t total_reserved();
+
+private:
+    struct chunk {
+        void* data;
+        std::size_t size;
+    };
+
+    void add_chunk(std::size_t min_size);
+
+    mutable std::mutex mutex_;
+    bool huge_pages_;
+    std::vector<chunk> chunks_;
+    char* head_ = nullptr;      // Start of free space in the current chunk.
+    char* end_ = nullptr;       // End of the current chunk.
+    char* last_ = nullptr;      // Start of the most recent allocation.
+    std::size_t reserved_ = 0;
+    std::size_t used_ = 0;
+};
+
+} // namespace util
+} // namespace arb
@@ -6,6 +6,8 @@
 
 #include <iostream>
 
+#include "util/arena.hpp"
+
 // Allocator with run-time alignment and padding guarantees.
 //
 // With an alignment value of `n`, any allocations will be
@@ -15,16 +17,29 @@
 //
 // Any alignment `n` specified must be a power of two.
 //
-// Assignment operations propagate the alignment/padding, so that
+// Move assignment and swap propagate the alignment/padding, so that
 // e.g.
 // ```
 //     std::vector<int, padded_allocator<int>> a(100, 32), b(50, 64);
-//     a = b;
+//     a = std::move(b);
 //     assert(a.get_allocator().alignment()==64);
 // ```
-// will pass, and the vector `a` will require reallocation.
-// Correspondingly, we have to return `false`
-// for the allocator equality test if the alignments differ.
+// will pass. Copy assignment does not: the target keeps its allocator, and
+// its storage if large enough, so that pointers into arrays that are
+// assigned new values stay valid; mechanisms hold such pointers into the
+// cell group state. Allocators with differing alignments or arenas compare
+// not-equal.
+//
+// The allocator does not touch the memory it returns. With the default
+// first-touch policy of Linux, the pages of an allocation are placed on the
+// NUMA node of the thread that first writes to them, typically the one that
+// constructs the container; cell group state relies on this, see
+// `threading::parallel_for::apply_pinned`.
+//
+// Optionally, allocations are taken from a shared `arena`, which is kept
+// alive by all allocators referring to it. Copy construction of a container
+// does not carry over the arena, so that copies of arena backed arrays are
+// allocated as usual.
 
 namespace arb {
 namespace util {
@@ -33,7 +48,7 @@ template <typename T = void>
 struct padded_allocator {
     using value_type = T;
     using pointer = T*;
-    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_copy_assignment = std::false_type;
     using propagate_on_container_move_assignment = std::true_type;
     using propagate_on_container_swap = std::true_type;
     using is_always_equal = std::false_type;
@@ -41,16 +56,18 @@ struct padded_allocator {
     padded_allocator() noexcept = default;
 
     template <typename U>
-    padded_allocator(const padded_allocator<U>& b) noexcept: alignment_(b.alignment()) {}
+    padded_allocator(const padded_allocator<U>& b) noexcept: alignment_(b.alignment()), arena_(b.arena()) {}
 
-    explicit padded_allocator(std::size_t alignment): alignment_(alignment) {
+    explicit padded_allocator(std::size_t alignment, std::shared_ptr<util::arena> arena = nullptr):
+        alignment_(alignment), arena_(std::move(arena))
+    {
         if (!alignment_ || (alignment_&(alignment_-1))) {
             throw std::range_error("alignment must be positive power of two");
         }
     }
 
     padded_allocator select_on_container_copy_construction() const noexcept {
-        return *this;
+        return padded_allocator(alignment_);
     }
 
     pointer allocate(std::size_t n) {
@@ -62,6 +79,9 @@ struct padded_allocator {
         std::size_t size = round_up(n*sizeof(T), alignment_);
         std::size_t pm_align = std::max(alignment_, sizeof(void*));
 
+        if (arena_) {
+            return static_cast<pointer>(arena_->allocate(size, std::max(pm_align, alignof(T))));
+        }
         if (auto err = posix_memalign(&mem, pm_align, size)) {
             throw std::system_error(err, std::generic_category(), "posix_memalign");
         }
@@ -69,18 +89,26 @@ struct padded_allocator {
     }
 
     void deallocate(pointer p, std::size_t n) {
+        if (arena_) {
+            arena_->deallocate(p, round_up(n*sizeof(T), alignment_));
+            return;
+        }
         std::free(p);
     }
 
-    bool operator==(const padded_allocator& a) const { return alignment_==a.alignment_; }
+    bool operator==(const padded_allocator& a) const { return alignment_==a.alignment_ && arena_==a.arena_; }
     bool operator!=(const padded_allocator& a) const { return !(*this==a); }
 
     std::size_t alignment() const { return alignment_; }
+    const std::shared_ptr<util::arena>& arena() const { return arena_; }
 
 private:
     // Start address and one-past-the-end address a multiple of alignment:
     std::size_t alignment_ = 1;
 
+    // Arena to allocate from, if any.
+    std::shared_ptr<util::arena> arena_;
+
     static std::size_t round_up(std::size_t v, std::size_t b) {
         std::size_t m = v%b;
         return v-m+(m? b: 0);
@@ -1,7 +1,8 @@
 #include "tourney_tree.hpp"
 
+#include <bit>
 #include <iostream>
-#include <numeric>
+#include <limits>
 
 #include <arbor/math.hpp>
 #include <arbor/assert.hpp>
@@ -9,22 +10,32 @@
 namespace arb {
 
 using event_span = util::range<const spike_event*>;
+using key_type = tourney_tree::key_type;
 
-static constexpr spike_event terminal_pse{0, terminal_time, 0};
+static constexpr key_type terminal_key{terminal_time, std::numeric_limits<std::uint64_t>::max()};
 
 // The tournament tree data structure is used to merge k sorted lists of events.
 // See online for high-level information about tournament trees.
 //
-// This implementation maintains a heap-like data structure, with entries of type:
-//      std::pair<unsigned, post_synaptic_event>
-// where the unsigned ∈ [0, k-1] is the id of the list from which the event was
-// drawn. The id is stored so that the operation of removing the most recent event
-// knows which leaf node needs to be updated (i.e. the leaf node of the list from
-// which the most recent event was drawn).
+// This implementation is a loser tree over the lanes padded to a power of two:
+// each internal node holds the lane that lost the match played there, and the
+// overall winner is kept aside. Removing the head of the winning lane replays
+// only the matches on the path from its leaf to the root, against the losers
+// stored there, with one comparison per level and no access to sibling nodes.
 //
-// unsigned is used for storing the index, because if drawing events from more
-// event generators than can be counted using an unsigned a complete redesign
-// will be needed.
+// The heads of the lanes are kept as packed keys, which compare without
+// branches; an empty lane has a key greater than that of any event.
+
+static key_type pack(const spike_event& e) {
+    // Map the float weight to an unsigned integer of the same order.
+    auto w = std::bit_cast<std::uint32_t>(e.weight);
+    w = (w>>31)? ~w: w|0x80000000u;
+    return {e.time, (std::uint64_t(e.target)<<32) | w};
+}
+
+static bool less(const key_type& a, const key_type& b) {
+    return (a.time<b.time) | ((a.time==b.time) & (a.tie<b.tie));
+}
 
 tourney_tree::tourney_tree(std::vector<event_span>& input):
     input_(input),
@@ -37,110 +48,105 @@ tourney_tree::tourney_tree(std::vector<event_span>& input):
 
     // Must be able to fit leaves in unsigned count.
     arb_assert(leaves_>=n_lanes_);
-    nodes_ = 2*leaves_-1;
-
-    // Allocate space for the tree nodes
-    heap_.resize(nodes_);
-    // Set the leaf nodes
-    for (auto i=0u; i<leaves_; ++i) {
-        heap_[leaf(i)] = i<n_lanes_?
-            key_val(i, input[i].empty()? terminal_pse: input[i].front()):
-            key_val(i, terminal_pse); // null leaf node
+
+    // Set the leaves, padding with empty lanes.
+    keys_.resize(leaves_);
+    for (auto i=0u; i<leaves_; ++i) keys_[i] = key(i);
+
+    // Play all matches bottom up, with the winners of the matches at
+    // node n in winners[n] and the lanes at the leaves in winners[leaves_+i].
+    loser_.resize(leaves_);
+    std::vector<unsigned> winners(2*leaves_);
+    for (auto i=0u; i<leaves_; ++i) winners[leaves_+i] = i;
+    for (auto n=leaves_-1; n>0; --n) {
+        auto l = winners[2*n], r = winners[2*n+1];
+        bool right_wins = less(keys_[r], keys_[l]);
+        winners[n] = right_wins? r: l;
+        loser_[n] = right_wins? l: r;
     }
-    // Walk the tree to initialize the non-leaf nodes
-    setup(0);
+    winner_ = winners[1];
 }
 
 std::ostream& operator<<(std::ostream& out, const tourney_tree& tt) {
-    unsigned nxt = 1;
-    for (unsigned i = 0; i<tt.nodes_; ++i) {
-        if (i==nxt-1) {
+    out << "{winner " << tt.winner_ << "}\n";
+    unsigned nxt = 2;
+    for (unsigned n = 1; n<tt.leaves_; ++n) {
+        if (n==nxt) {
             nxt*=2;
             out << "\n";
         }
-        out << "{" << tt.heap_[i].first << "," << tt.heap_[i].second << "}\n";
+        auto l = tt.loser_[n];
+        out << "{" << l << "," << tt.keys_[l].time << "}\n";
     }
     return out;
 }
 
 bool tourney_tree::empty() const {
-    return event(0).time == terminal_time;
+    return keys_[winner_].time == terminal_time;
 }
 
 spike_event tourney_tree::head() const {
-    return event(0);
+    return input_[winner_].front();
 }
 
 // Remove the smallest (most recent) event from the tree, then update the
 // tree so that head() returns the next event.
 void tourney_tree::pop() {
-    unsigned lane = id(0);
-    unsigned i = leaf(lane);
-
-    // draw the next event from the input lane
+    auto lane = winner_;
     auto& in = input_[lane];
+    if (!in.empty()) ++in.left;
+    keys_[lane] = key(lane);
+    replay(lane);
+}
 
-    if (!in.empty()) {
-        ++in.left;
+// Take the head, and if its lane wins again, take the events of the lane up
+// to the smallest head of the other lanes at once. That is the smallest loser
+// on the path from the lane to the root: every other lane lost, directly or
+// not, against one of those.
+void tourney_tree::pop_run(pse_vector& out) {
+    auto lane = winner_;
+    auto& in = input_[lane];
+    out.push_back(*in.left++);
+    keys_[lane] = key(lane);
+    replay(lane);
+    if (winner_!=lane || in.empty()) return;
+
+    auto bound = terminal_key;
+    for (auto n = (lane+leaves_)>>1; n>0; n>>=1) {
+        const auto& k = keys_[loser_[n]];
+        if (less(k, bound)) bound = k;
     }
-
-    event(i) = in.empty()? terminal_pse: in.front();
-
-    // re-heapify the tree with a single walk from leaf to root
-    while ((i=parent(i))) {
-        merge_up(i);
+    auto first = in.left;
+    auto last = first+1;
+    while (last!=in.right && !less(bound, pack(*last))) ++last;
+    out.insert(out.end(), first, last);
+    in.left = last;
+    keys_[lane] = key(lane);
+    replay(lane);
+}
+
+// Head of a lane, or the terminal key for empty and padding lanes.
+key_type tourney_tree::key(unsigned lane) const {
+    if (lane>=n_lanes_ || input_[lane].empty()) return terminal_key;
+    return pack(input_[lane].front());
+}
+
+// Replay the matches from the leaf of lane to the root; the lane is the
+// winner of the match at its leaf.
+void tourney_tree::replay(unsigned lane) {
+    auto w = lane;
+    for (auto n = (lane+leaves_)>>1; n>0; n>>=1) {
+        auto l = loser_[n];
+        bool swap = less(keys_[l], keys_[w]);
+        loser_[n] = swap? w: l;
+        w = swap? l: w;
     }
-    merge_up(0); // handle the root
-}
-
-void tourney_tree::setup(unsigned i) {
-    if (is_leaf(i)) return;
-    setup(left(i));
-    setup(right(i));
-    merge_up(i);
-};
-
-// Update the value at node i of the tree to be the smallest
-// of its left and right children.
-// The result is undefined for leaf nodes.
-void tourney_tree::merge_up(unsigned i) {
-    const auto l = left(i);
-    const auto r = right(i);
-    heap_[i] = event(l)<event(r)? heap_[l]: heap_[r];
-}
-
-// The tree is stored using the standard heap indexing scheme.
-
-unsigned tourney_tree::parent(unsigned i) const {
-    return (i-1)>>1;
-}
-unsigned tourney_tree::left(unsigned i) const {
-    return (i<<1) + 1;
-}
-unsigned tourney_tree::right(unsigned i) const {
-    return left(i)+1;
-}
-unsigned tourney_tree::leaf(unsigned i) const {
-    return i+leaves_-1;
-}
-bool tourney_tree::is_leaf(unsigned i) const {
-    return i>=leaves_-1;
-}
-const unsigned& tourney_tree::id(unsigned i) const {
-    return heap_[i].first;
-}
-spike_event& tourney_tree::event(unsigned i) {
-    return heap_[i].second;
-}
-const spike_event& tourney_tree::event(unsigned i) const {
-    return heap_[i].second;
+    winner_ = w;
 }
 
 void ARB_ARBOR_API tree_merge_events(std::vector<event_span>& sources, pse_vector& out) {
+    if (sources.empty()) return;
     tourney_tree tree(sources);
-    while (!tree.empty()) {
-        out.push_back(tree.head());
-        tree.pop();
-    }
+    while (!tree.empty()) tree.pop_run(out);
 }
 }
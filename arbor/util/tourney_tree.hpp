@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include <arbor/export.hpp>
 #include <arbor/spike_event.hpp>
 
@@ -13,31 +16,34 @@ using event_span = util::range<const spike_event*>;
 // it is not intended for use elsewhere. It is exposed here for unit testing
 // of its functionality.
 class ARB_ARBOR_API tourney_tree {
-    using key_val = std::pair<unsigned, spike_event>;
-
 public:
     tourney_tree(std::vector<event_span>& input);
     bool empty() const;
     spike_event head() const;
     void pop();
+
+    // Append the head and all following events of its lane that precede the
+    // heads of all other lanes to out, and remove them from the tree.
+    void pop_run(pse_vector& out);
+
     friend std::ostream& operator<<(std::ostream&, const tourney_tree&);
 
+    // Events packed for comparison: time, then target and weight as one
+    // integer ordered as (target, weight).
+    struct key_type {
+        time_type time;
+        std::uint64_t tie;
+    };
+
 private:
-    void setup(unsigned i);
-    void merge_up(unsigned i);
-    unsigned parent(unsigned i) const;
-    unsigned left(unsigned i) const;
-    unsigned right(unsigned i) const;
-    unsigned leaf(unsigned i) const;
-    bool is_leaf(unsigned i) const;
-    const unsigned& id(unsigned i) const;
-    spike_event& event(unsigned i);
-    const spike_event& event(unsigned i) const;
-
-    std::vector<key_val> heap_;
+    key_type key(unsigned lane) const;
+    void replay(unsigned lane);
+
+    std::vector<key_type> keys_;   // Current head of each lane.
+    std::vector<unsigned> loser_;  // Loser at each internal node, root at 1.
     std::vector<event_span>& input_;
+    unsigned winner_ = 0;
     unsigned leaves_;
-    unsigned nodes_;
     unsigned n_lanes_;
 };
 
@@ -284,29 +284,17 @@ private:
     token symbol() {
         using namespace std::string_literals;
         auto start = loc();
-        std::string symbol;
-        char c = *stream_;
+        const char* first = stream_;
 
         // Assert that current position is at the start of an identifier
-        if( !(std::isalpha(c)) ) {
+        if( !(std::isalpha(*stream_)) ) {
             return {start, tok::error, "Internal error: lexer attempting to read identifier when none is available '.'"s};
         }
 
-        symbol += c;
         ++stream_;
-        while(1) {
-            c = *stream_;
+        while (is_valid_symbol_char(*stream_)) ++stream_;
 
-            if(is_valid_symbol_char(c)) {
-                symbol += c;
-                ++stream_;
-            }
-            else {
-                break;
-            }
-        }
-
-        return {start, tok::symbol, std::move(symbol)};
+        return {start, tok::symbol, std::string(first, stream_)};
     }
 
     token string() {
@@ -316,35 +304,30 @@ private:
         }
 
         auto start = loc();
-        ++stream_;
-        std::string str;
-        while (!empty() && *stream_!='"') {
-            str.push_back(*stream_);
-            ++stream_;
-        }
+        const char* first = ++stream_;
+        while (!empty() && *stream_!='"') ++stream_;
         if (empty()) return {start, tok::error, "string missing closing \""};
+        std::string str(first, stream_);
         ++stream_; // gobble the closing "
 
-        return {start, tok::string, str};
+        return {start, tok::string, std::move(str)};
     }
 
     token number() {
         using namespace std::string_literals;
 
         auto start = loc();
-        std::string str;
+        const char* first = stream_;
         char c = *stream_;
 
         // Start counting the number of points in the number.
         auto num_point = (c=='.' ? 1 : 0);
         auto uses_scientific_notation = 0;
 
-        str += c;
         ++stream_;
         while(1) {
             c = *stream_;
             if (std::isdigit(c)) {
-                str += c;
                 ++stream_;
             }
             else if (c=='.') {
@@ -352,7 +335,6 @@ private:
                     // Can't have more than one '.' in a number
                     return {start, tok::error, "unexpected '.'"s};
                 }
-                str += c;
                 ++stream_;
                 if (uses_scientific_notation) {
                     // Can't have a '.' in the mantissa
@@ -364,11 +346,10 @@ private:
                     (is_plusminus(peek_char(1)) && std::isdigit(peek_char(2))))
                 {
                     uses_scientific_notation++;
-                    str += c;
                     stream_++;
                     // Consume the next char if +/-
                     if (is_plusminus(*stream_)) {
-                        str += *stream_++;
+                        stream_++;
                     }
                 }
                 else {
@@ -382,7 +363,7 @@ private:
         }
 
         const bool is_real = uses_scientific_notation || num_point>0;
-        return {start, (is_real? tok::real: tok::integer), std::move(str)};
+        return {start, (is_real? tok::real: tok::integer), std::string(first, stream_)};
     }
 
     char character() {
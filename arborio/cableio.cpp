@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 #include <unordered_map>
 
@@ -37,11 +39,31 @@ cableio_version_error::cableio_version_error(const std::string& version):
 {}
 
 
+// Numbers in `a`, replaced by those of `b` where they differ in value.
+static s_expr merge_numbers(const s_expr& a, const s_expr& b) {
+    if (a.is_atom()) {
+        const auto& t = a.atom();
+        if (t.kind!=tok::real && t.kind!=tok::integer) return a;
+        auto value = [](const token& t) { return std::strtod(t.spelling.c_str(), nullptr); };
+        return value(t)==value(b.atom())? a: b;
+    }
+    return {merge_numbers(a.head(), b.head()), merge_numbers(a.tail(), b.tail())};
+}
+
+// Print `x` and parse it back, keeping numbers as printed at the stream's
+// default precision unless that loses precision.
+template <typename T>
+static s_expr round_trip(const T& x) {
+    std::stringstream s, exact;
+    s << x;
+    exact.precision(std::numeric_limits<double>::max_digits10);
+    exact << x;
+    return merge_numbers(parse_s_expr(s.str()), parse_s_expr(exact.str()));
+}
+
 // Define s-expr makers for various types
 s_expr mksexp(const iexpr& j) {
-    std::stringstream s;
-    s << j;
-    return parse_s_expr(s.str());
+    return round_trip(j);
 }
 s_expr mksexp(const init_membrane_potential& p) {
     return slist("membrane-potential"_symbol, p.value, mksexp(p.scale));
@@ -117,11 +139,6 @@ s_expr mksexp(const msegment& seg) {
     return slist("segment"_symbol, (int)seg.id, mksexp(seg.prox), mksexp(seg.dist), seg.tag);
 }
 s_expr mksexp(const decor& d) {
-    auto round_trip = [](auto& x) {
-        std::stringstream s;
-        s << x;
-        return parse_s_expr(s.str());
-    };
     std::vector<s_expr> decorations;
     for (const auto& p: d.defaults().serialize()) {
         decorations.push_back(std::visit([&](auto& x)
@@ -140,16 +157,9 @@ s_expr mksexp(const decor& d) {
     return {"decor"_symbol, slist_range(decorations)};
 }
 s_expr mksexp(const cv_policy& c) {
-    std::stringstream s;
-    s << c;
-    return slist("cv-policy"_symbol, parse_s_expr(s.str()));
+    return slist("cv-policy"_symbol, round_trip(c));
 }
 s_expr mksexp(const label_dict& dict) {
-    auto round_trip = [](auto& x) {
-        std::stringstream s;
-        s << x;
-        return parse_s_expr(s.str());
-    };
     auto defs = slist();
     for (auto& r: dict.locsets()) {
         defs = s_expr(slist("locset-def"_symbol, s_expr(r.first), round_trip(r.second)), std::move(defs));
@@ -52,6 +52,15 @@ eval_map {{"default",
           {"max-extent",
            make_call<double, region, cv_policy_flag>([] (double i, const region& r, cv_policy_flag f) { return arb::cv_policy_max_extent(i, r, f); },
                                                      "'max-extent' with three arguments (max-extent (length:double) (reg:region) (flags:flag))")},
+          {"d-lambda",
+           make_call<double, double>([] (double f, double d) { return arb::cv_policy_d_lambda(f, d); },
+                                     "'d-lambda' with two arguments (d-lambda (frequency:double) (d-lambda:double))")},
+          {"d-lambda",
+           make_call<double, double, region>([] (double f, double d, const region& r) { return arb::cv_policy_d_lambda(f, d, r); },
+                                             "'d-lambda' with three arguments (d-lambda (frequency:double) (d-lambda:double) (reg:region))")},
+          {"d-lambda",
+           make_call<double, double, region, cv_policy_flag>([] (double f, double d, const region& r, cv_policy_flag fl) { return arb::cv_policy_d_lambda(f, d, r, fl); },
+                                                             "'d-lambda' with four arguments (d-lambda (frequency:double) (d-lambda:double) (reg:region) (flags:flag))")},
           {"single",
            make_call<>([] () { return arb::cv_policy_single(); },
                        "'single' with no arguments")},
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace arborio {
+
+// std::from_chars for integers and doubles.
+//
+// Floating point std::from_chars is missing from some standard libraries we
+// support, e.g. the libc++ of Clang 13 and Apple Clang 15, which do not define
+// __cpp_lib_to_chars. There, doubles are parsed with std::strtod on a
+// NUL-terminated copy of the input.
+template <typename T>
+std::from_chars_result from_chars(const char* first, const char* last, T& value) {
+#if !defined(__cpp_lib_to_chars)
+    if constexpr (std::is_floating_point_v<T>) {
+        // strtod would skip leading whitespace, which from_chars rejects.
+        if (first==last || std::isspace((unsigned char)*first)) return {first, std::errc::invalid_argument};
+
+        // Copy only up to the next blank: a number never spans one, and the
+        // input may be the rest of a large file.
+        const char* stop = first;
+        while (stop!=last && !std::isspace((unsigned char)*stop)) ++stop;
+        std::string copy(first, stop);
+        char* end = nullptr;
+        errno = 0;
+        double v = std::strtod(copy.c_str(), &end);
+        const char* ptr = first + (end-copy.c_str());
+        if (ptr==first) return {first, std::errc::invalid_argument};
+        if (errno==ERANGE) return {ptr, std::errc::result_out_of_range};
+        value = v;
+        return {ptr, std::errc{}};
+    }
+    else
+#endif
+    return std::from_chars(first, last, value);
+}
+
+} // namespace arborio
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/cable_cell_param.hpp>
+#include <arbor/morph/label_dict.hpp>
+#include <arbor/morph/morphology.hpp>
+#include <arbor/morph/segment_tree.hpp>
+
+#include <arborio/export.hpp>
+
+namespace arborio {
+
+// Binary cache of converted morphologies, written once and loaded quickly.
+//
+// A cache holds a sequence of entries, each a segment tree with optional
+// labels and decor. Segment trees are stored as flat arrays and restored
+// without any parsing; labels and decor are stored in the cable cell format
+// (see cableio.hpp) and parsed on demand only.
+//
+// The format is versioned and in native byte order; caches are meant to be
+// rebuilt from the original files, not exchanged between platforms.
+
+ARB_ARBORIO_API std::uint32_t morphology_cache_version();
+
+struct ARB_SYMBOL_VISIBLE morphology_cache_error: arb::arbor_exception {
+    explicit morphology_cache_error(const std::string& msg);
+};
+
+struct ARB_ARBORIO_API morphology_cache_entry {
+    arb::segment_tree segment_tree;
+    arb::label_dict labels;
+    std::optional<arb::decor> decor;
+};
+
+ARB_ARBORIO_API void write_morphology_cache(std::ostream&, const std::vector<morphology_cache_entry>&);
+ARB_ARBORIO_API void write_morphology_cache(const std::filesystem::path&, const std::vector<morphology_cache_entry>&);
+
+// Read access to a cache file, which is memory mapped on construction;
+// entries are decoded lazily on access.
+//
+// Throws arb::file_not_found_error if the file cannot be read, and
+// morphology_cache_error if it is not a cache of the current version.
+class ARB_ARBORIO_API morphology_cache {
+public:
+    explicit morphology_cache(const std::filesystem::path&);
+    morphology_cache(morphology_cache&&);
+    ~morphology_cache();
+
+    std::size_t size() const;
+
+    arb::segment_tree segment_tree(std::size_t i) const;
+    arb::morphology morphology(std::size_t i) const;
+    arb::label_dict labels(std::size_t i) const;
+    std::optional<arb::decor> decor(std::size_t i) const;
+
+    morphology_cache_entry operator[](std::size_t i) const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+};
+
+} // namespace arborio
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include <arbor/context.hpp>
+
+#include <arborio/loaded_morphology.hpp>
+#include <arborio/export.hpp>
+
+namespace arborio {
+
+enum class ARB_ARBORIO_API morphology_format {
+    automatic,   // From the file extension: .swc as swc_arbor, .asc as asc.
+    swc_arbor,   // As load_swc_arbor.
+    swc_neuron,  // As load_swc_neuron.
+    asc,         // As load_asc.
+};
+
+// Load many morphologies at once, returning them in the order of `paths`.
+//
+// Files are parsed in parallel on the thread pool of `ctx`. Files with
+// identical contents, as judged by size and hash, are parsed only once.
+//
+// Throws arb::file_not_found_error if any file cannot be read, the loader's
+// exception if any file cannot be parsed, and arb::arbor_exception if the
+// format of a file cannot be determined.
+ARB_ARBORIO_API std::vector<loaded_morphology> load_morphologies(
+    const std::vector<std::filesystem::path>& paths,
+    const arb::context& ctx,
+    morphology_format format = morphology_format::automatic);
+
+} // namespace arborio
@@ -116,8 +116,10 @@ public:
 // conditions above are encountered.
 //
 // SWC records are returned in id order.
+//
+// Parsing text, including files loaded by path, avoids the overhead of streams.
 ARB_ARBORIO_API swc_data parse_swc(std::istream&);
-ARB_ARBORIO_API swc_data parse_swc(const std::string&);
+ARB_ARBORIO_API swc_data parse_swc(std::string_view);
 
 // Convert a valid, ordered sequence of SWC records into a morphology.
 //
@@ -0,0 +1,49 @@
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/util/scope_exit.hpp>
+
+#include "mapped_file.hpp"
+
+namespace arborio {
+
+mapped_file::mapped_file(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd<0) throw arb::file_not_found_error(path.string());
+    auto close_fd = arb::util::on_scope_exit([fd] { ::close(fd); });
+
+    struct stat st;
+    if (::fstat(fd, &st)!=0 || !S_ISREG(st.st_mode)) throw arb::file_not_found_error(path.string());
+    size_ = st.st_size;
+    if (!size_) return;
+
+    if (size_ % ::sysconf(_SC_PAGESIZE)) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p!=MAP_FAILED) {
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+            mapping_ = p;
+            data_ = static_cast<const char*>(p);
+            return;
+        }
+    }
+
+    // No room for the terminating zero in the mapping, or mapping failed.
+    std::ifstream fid(path, std::ios::binary);
+    if (!fid) throw arb::file_not_found_error(path.string());
+    buffer_.reserve(size_);
+    buffer_.assign(std::istreambuf_iterator<char>(fid), std::istreambuf_iterator<char>());
+    size_ = buffer_.size();
+    data_ = buffer_.c_str();
+}
+
+mapped_file::~mapped_file() {
+    if (mapping_) ::munmap(mapping_, size_);
+}
+
+} // namespace arborio
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace arborio {
+
+// Read-only view of the contents of a file, memory mapped where possible.
+//
+// The contents are followed by a terminating zero, as required by parsers
+// working on C strings: mapped files rely on the zero fill of their last
+// page, files ending on a page boundary are read into a buffer instead.
+//
+// Throws arb::file_not_found_error if the file cannot be opened.
+struct mapped_file {
+    explicit mapped_file(const std::filesystem::path&);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    std::string_view view() const { return {data_, size_}; }
+    const char* c_str() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = "";
+    std::size_t size_ = 0;
+    void* mapping_ = nullptr;
+    std::string buffer_;
+};
+
+} // namespace arborio
@@ -0,0 +1,242 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+#include <arborio/cableio.hpp>
+#include <arborio/morphology_cache.hpp>
+
+#include "mapped_file.hpp"
+
+namespace arborio {
+
+// Layout, all integers in native byte order:
+//
+//   header   magic "ARBMCACH", u32 version, u32 byte order mark, u64 entry count
+//   index    u64 offset of each entry from the start of the file, and of the end
+//   entries  u64 segment count, u64 label text length, u64 decor text length,
+//            u64 flags; then per segment u32 parent and i32 tag; padding to
+//            8 bytes; per segment 8 doubles, proximal and distal x, y, z, r;
+//            then the label and decor texts, padded to 8 bytes.
+
+namespace {
+constexpr char magic[8] = {'A', 'R', 'B', 'M', 'C', 'A', 'C', 'H'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+constexpr std::uint64_t has_decor = 1;
+
+struct header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint64_t count;
+};
+
+struct entry_header {
+    std::uint64_t num_segments;
+    std::uint64_t labels_size;
+    std::uint64_t decor_size;
+    std::uint64_t flags;
+};
+
+std::size_t padded(std::size_t n) {
+    return (n+7)&~std::size_t(7);
+}
+
+template <typename T>
+void put(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void pad(std::string& out) {
+    out.resize(padded(out.size()), '\0');
+}
+
+std::string to_text(const arb::label_dict& labels) {
+    std::ostringstream os;
+    write_component(os, labels);
+    return os.str();
+}
+
+std::string to_text(const arb::decor& decor) {
+    std::ostringstream os;
+    write_component(os, decor);
+    return os.str();
+}
+
+std::string encode(const morphology_cache_entry& e) {
+    const auto& segments = e.segment_tree.segments();
+    const auto& parents = e.segment_tree.parents();
+    auto labels = to_text(e.labels);
+    auto decor = e.decor? to_text(*e.decor): std::string{};
+
+    std::string out;
+    put(out, entry_header{segments.size(), labels.size(), decor.size(), e.decor? has_decor: 0});
+    for (auto p: parents) put(out, std::uint32_t(p));
+    for (auto& s: segments) put(out, std::int32_t(s.tag));
+    pad(out);
+    for (auto& s: segments) {
+        for (auto& p: {s.prox, s.dist}) {
+            put(out, p.x);
+            put(out, p.y);
+            put(out, p.z);
+            put(out, p.radius);
+        }
+    }
+    out += labels;
+    out += decor;
+    pad(out);
+    return out;
+}
+
+template <typename T>
+T component_from_text(std::string_view text) {
+    auto c = parse_component(std::string(text));
+    if (!c) throw morphology_cache_error("invalid component: "+std::string(c.error().what()));
+    if (auto p = std::get_if<T>(&c->component)) return std::move(*p);
+    throw morphology_cache_error("unexpected component type");
+}
+} // anonymous namespace
+
+ARB_ARBORIO_API std::uint32_t morphology_cache_version() {
+    return version;
+}
+
+morphology_cache_error::morphology_cache_error(const std::string& msg):
+    arb::arbor_exception("morphology cache: "+msg)
+{}
+
+ARB_ARBORIO_API void write_morphology_cache(std::ostream& os, const std::vector<morphology_cache_entry>& entries) {
+    std::vector<std::string> encoded;
+    encoded.reserve(entries.size());
+    for (auto& e: entries) encoded.push_back(encode(e));
+
+    std::string out;
+    header h;
+    std::memcpy(h.magic, magic, sizeof magic);
+    h.version = version;
+    h.byte_order_mark = byte_order_mark;
+    h.count = entries.size();
+    put(out, h);
+
+    std::uint64_t offset = sizeof(header) + (entries.size()+1)*sizeof(std::uint64_t);
+    put(out, offset);
+    for (auto& e: encoded) {
+        offset += e.size();
+        put(out, offset);
+    }
+    os.write(out.data(), out.size());
+    for (auto& e: encoded) os.write(e.data(), e.size());
+}
+
+ARB_ARBORIO_API void write_morphology_cache(const std::filesystem::path& path, const std::vector<morphology_cache_entry>& entries) {
+    std::ofstream fid(path, std::ios::binary);
+    if (!fid) throw arb::file_not_found_error("unable to write morphology cache: "+path.string());
+    write_morphology_cache(fid, entries);
+    if (!fid) throw morphology_cache_error("failed to write "+path.string());
+}
+
+struct morphology_cache::impl {
+    mapped_file file;
+    std::uint64_t count = 0;
+
+    explicit impl(const std::filesystem::path& path): file(path) {
+        header h;
+        if (file.size()<sizeof h) throw morphology_cache_error("not a cache file: "+path.string());
+        std::memcpy(&h, file.c_str(), sizeof h);
+        if (std::memcmp(h.magic, magic, sizeof magic)) {
+            throw morphology_cache_error("not a cache file: "+path.string());
+        }
+        if (h.byte_order_mark!=byte_order_mark) {
+            throw morphology_cache_error("byte order mismatch in "+path.string());
+        }
+        if (h.version!=version) {
+            throw morphology_cache_error("unsupported version "+std::to_string(h.version)+" in "+path.string());
+        }
+        count = h.count;
+        if (sizeof h + (count+1)*sizeof(std::uint64_t) > file.size() || offset(count)!=file.size()) {
+            throw morphology_cache_error("truncated cache file: "+path.string());
+        }
+    }
+
+    std::uint64_t offset(std::size_t i) const {
+        std::uint64_t o;
+        std::memcpy(&o, file.c_str() + sizeof(header) + i*sizeof o, sizeof o);
+        return o;
+    }
+
+    // Locate entry i, checking that its parts lie within its extent.
+    std::pair<entry_header, const char*> entry(std::size_t i) const {
+        if (i>=count) throw morphology_cache_error("entry "+std::to_string(i)+" out of range");
+        auto first = offset(i), last = offset(i+1);
+        entry_header e;
+        if (first>last || last>file.size() || last-first<sizeof e) throw morphology_cache_error("corrupt index");
+        const char* p = file.c_str() + first;
+        std::memcpy(&e, p, sizeof e);
+        // Check the parts one by one, such that corrupt sizes cannot wrap.
+        std::uint64_t rest = last-first-sizeof e;
+        bool ok = e.num_segments<=rest/72;
+        if (ok) rest -= padded(8*e.num_segments) + 64*e.num_segments;
+        ok = ok && e.labels_size<=rest;
+        if (ok) rest -= e.labels_size;
+        ok = ok && e.decor_size<=rest;
+        if (!ok) throw morphology_cache_error("corrupt entry "+std::to_string(i));
+        return {e, p + sizeof e};
+    }
+
+    std::string_view labels_text(std::size_t i) const {
+        auto [e, p] = entry(i);
+        return {p + padded(8*e.num_segments) + 64*e.num_segments, e.labels_size};
+    }
+};
+
+morphology_cache::morphology_cache(const std::filesystem::path& path):
+    impl_(new impl(path))
+{}
+
+morphology_cache::morphology_cache(morphology_cache&&) = default;
+morphology_cache::~morphology_cache() = default;
+
+std::size_t morphology_cache::size() const {
+    return impl_->count;
+}
+
+arb::segment_tree morphology_cache::segment_tree(std::size_t i) const {
+    auto [e, p] = impl_->entry(i);
+    const auto n = e.num_segments;
+    std::vector<std::uint32_t> parents(n);
+    std::vector<std::int32_t> tags(n);
+    std::vector<double> points(8*n);
+    std::memcpy(parents.data(), p, 4*n);
+    std::memcpy(tags.data(), p + 4*n, 4*n);
+    std::memcpy(points.data(), p + padded(8*n), 64*n);
+
+    arb::segment_tree tree;
+    tree.reserve(n);
+    for (std::size_t j = 0; j<n; ++j) {
+        const double* x = points.data() + 8*j;
+        tree.append(parents[j], {x[0], x[1], x[2], x[3]}, {x[4], x[5], x[6], x[7]}, tags[j]);
+    }
+    return tree;
+}
+
+arb::morphology morphology_cache::morphology(std::size_t i) const {
+    return arb::morphology(segment_tree(i));
+}
+
+arb::label_dict morphology_cache::labels(std::size_t i) const {
+    return component_from_text<arb::label_dict>(impl_->labels_text(i));
+}
+
+std::optional<arb::decor> morphology_cache::decor(std::size_t i) const {
+    auto [e, p] = impl_->entry(i);
+    if (!(e.flags&has_decor)) return std::nullopt;
+    auto labels = impl_->labels_text(i);
+    return component_from_text<arb::decor>({labels.data() + labels.size(), e.decor_size});
+}
+
+morphology_cache_entry morphology_cache::operator[](std::size_t i) const {
+    return {segment_tree(i), labels(i), decor(i)};
+}
+
+} // namespace arborio
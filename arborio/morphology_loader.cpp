@@ -0,0 +1,98 @@
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <tuple>
+
+#include <arbor/arbexcept.hpp>
+
+#include <arborio/morphology_loader.hpp>
+#include <arborio/neurolucida.hpp>
+#include <arborio/swcio.hpp>
+
+#include "execution_context.hpp"
+#include "threading/threading.hpp"
+
+#include "mapped_file.hpp"
+
+namespace arborio {
+
+static morphology_format deduce_format(const std::filesystem::path& path) {
+    auto ext = path.extension();
+    if (ext==".swc" || ext==".SWC") return morphology_format::swc_arbor;
+    if (ext==".asc" || ext==".ASC") return morphology_format::asc;
+    throw arb::arbor_exception("unable to determine morphology format of file: "+path.string());
+}
+
+static loaded_morphology parse_morphology(const mapped_file& file, morphology_format format) {
+    switch (format) {
+    case morphology_format::swc_arbor:
+        return load_swc_arbor(parse_swc(file.view()));
+    case morphology_format::swc_neuron:
+        return load_swc_neuron(parse_swc(file.view()));
+    case morphology_format::asc:
+        return parse_asc_string(file.c_str());
+    default:
+        throw arb::arbor_internal_error("unexpected morphology format");
+    }
+}
+
+ARB_ARBORIO_API std::vector<loaded_morphology> load_morphologies(
+    const std::vector<std::filesystem::path>& paths,
+    const arb::context& ctx,
+    morphology_format format)
+{
+    using arb::threading::parallel_for;
+    const int n = paths.size();
+    auto pool = ctx->thread_pool.get();
+
+    std::vector<morphology_format> formats(n, format);
+    if (format==morphology_format::automatic) {
+        for (int i = 0; i<n; ++i) formats[i] = deduce_format(paths[i]);
+    }
+
+    // Identify each file by format, size and hash of its contents, and parse
+    // only the first file to claim a key, from the same mapping. The owners
+    // stay mapped, such that files with a matching key are compared byte by
+    // byte; on a hash collision, the file is parsed by itself.
+    using file_key = std::tuple<morphology_format, std::size_t, std::size_t>;
+    std::map<file_key, int> owner;
+    std::mutex owner_mutex;
+
+    std::vector<std::optional<mapped_file>> files(n);
+    std::vector<int> source(n);
+    std::vector<loaded_morphology> result(n);
+    parallel_for::apply(0, n, pool,
+        [&](int i) {
+            auto& file = files[i];
+            try {
+                file.emplace(paths[i]);
+            }
+            catch (arb::file_not_found_error&) {
+                throw arb::file_not_found_error("unable to open morphology file: "+paths[i].string());
+            }
+
+            file_key key{formats[i], file->size(), std::hash<std::string_view>{}(file->view())};
+            {
+                std::lock_guard<std::mutex> guard(owner_mutex);
+                source[i] = owner.emplace(key, i).first->second;
+            }
+            if (source[i]!=i) {
+                if (file->view()!=files[source[i]]->view()) source[i] = i;
+            }
+            if (source[i]==i) {
+                result[i] = parse_morphology(*file, formats[i]);
+            }
+            else {
+                file.reset();
+            }
+        });
+
+    for (int i = 0; i<n; ++i) {
+        if (source[i]!=i) result[i] = result[source[i]];
+    }
+    return result;
+}
+
+} // namespace arborio
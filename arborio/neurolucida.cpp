@@ -1,6 +1,5 @@
 #include <cstring>
 #include <ostream>
-#include <fstream>
 #include <numeric>
 
 #include <arbor/util/expected.hpp>
@@ -9,6 +8,8 @@
 #include "arbor/arbexcept.hpp"
 #include "arbor/morph/primitives.hpp"
 #include "asc_lexer.hpp"
+#include "from_chars.hpp"
+#include "mapped_file.hpp"
 
 #include <optional>
 
@@ -92,7 +93,14 @@ parse_hopefully<double> parse_double(asc::lexer& L) {
         return unexpected(PARSE_ERROR("missing real number", L.current().loc));
     }
     L.next(); // consume the number
-    return std::stod(t.spelling);
+    const char* first = t.spelling.data();
+    const char* last = first + t.spelling.size();
+    if (*first=='+') ++first;
+    double value;
+    if (from_chars(first, last, value).ec!=std::errc{}) {
+        return unexpected(PARSE_ERROR("real number out of range", t.loc));
+    }
+    return value;
 }
 
 #define PARSE_DOUBLE(L, X) {if (auto rval__ = parse_double(L)) X=*rval__; else return FORWARD_PARSE_ERROR(rval__.error());}
@@ -813,27 +821,8 @@ ARB_ARBORIO_API loaded_morphology parse_asc_string(const char* input) {
 }
 
 
-inline std::string read_file(const std::filesystem::path& filename) {
-    std::ifstream fid(filename);
-
-    if (!fid.good()) {
-        throw arb::file_not_found_error(filename.string());
-    }
-
-    // load contents of the file into a string.
-    std::string fstr;
-    fid.seekg(0, std::ios::end);
-    fstr.reserve(fid.tellg());
-    fid.seekg(0, std::ios::beg);
-
-    fstr.assign((std::istreambuf_iterator<char>(fid)),
-                 std::istreambuf_iterator<char>());
-    return fstr;
-}
-
-
 ARB_ARBORIO_API loaded_morphology load_asc(const std::filesystem::path& filename) {
-    std::string fstr = read_file(filename);
-    return parse_asc_string(fstr.c_str());
+    mapped_file file(filename);
+    return parse_asc_string(file.c_str());
 }
 } // namespace arborio
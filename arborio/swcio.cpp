@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cctype>
 #include <ios>
 #include <limits>
 #include <iostream>
@@ -15,6 +16,9 @@
 
 #include <arborio/swcio.hpp>
 
+#include "from_chars.hpp"
+#include "mapped_file.hpp"
+
 namespace arborio {
 
 // SWC exceptions:
@@ -154,9 +158,55 @@ ARB_ARBORIO_API swc_data parse_swc(std::istream& in) {
     return swc_data(metadata, std::move(records));
 }
 
-ARB_ARBORIO_API swc_data parse_swc(const std::string& text) {
-    std::istringstream is(text);
-    return parse_swc(is);
+// Parse one whitespace separated field at `p`, accepting what stream
+// extraction would; advances `p` past the field on success.
+template <typename T>
+static bool parse_swc_field(const char*& p, const char* end, T& value) {
+    while (p!=end && std::isspace((unsigned char)*p)) ++p;
+    if (p!=end && *p=='+') ++p;
+    auto [ptr, ec] = from_chars(p, end, value);
+    if (ec!=std::errc{}) return false;
+    p = ptr;
+    return true;
+}
+
+static bool parse_swc_record(const char* p, const char* end, swc_record& r) {
+    return parse_swc_field(p, end, r.id)
+        && parse_swc_field(p, end, r.tag)
+        && parse_swc_field(p, end, r.x)
+        && parse_swc_field(p, end, r.y)
+        && parse_swc_field(p, end, r.z)
+        && parse_swc_field(p, end, r.r)
+        && parse_swc_field(p, end, r.parent_id);
+}
+
+// Same as the stream parser, but directly on the text.
+ARB_ARBORIO_API swc_data parse_swc(std::string_view text) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    auto next_line = [end](const char* eol) { return eol==end? end: eol+1; };
+
+    std::string metadata;
+    while (p!=end && *p=='#') {
+        const char* eol = std::find(p, end, '\n');
+        const char* from = p+1;
+        while (from!=eol && (*from==' ' || *from=='\t')) ++from;
+        metadata.append(from, eol);
+        metadata += '\n';
+        p = next_line(eol);
+    }
+
+    std::vector<swc_record> records;
+    records.reserve(std::count(p, end, '\n')+1);
+    while (p!=end && *p!='\n') {
+        const char* eol = std::find(p, end, '\n');
+        swc_record r;
+        if (!parse_swc_record(p, eol, r)) break;
+        records.push_back(r);
+        p = next_line(eol);
+    }
+
+    return swc_data(metadata, std::move(records));
 }
 
 arb::segment_tree load_swc_arbor_raw(const swc_data& data) {
@@ -335,16 +385,23 @@ ARB_ARBORIO_API loaded_morphology load_swc_arbor(const swc_data& data) {
     return {raw, {raw}, ld, swc_metadata{}};
 }
 
+static swc_data parse_swc_file(const std::filesystem::path& path) {
+    std::optional<mapped_file> file;
+    try {
+        file.emplace(path);
+    }
+    catch (arb::file_not_found_error&) {
+        throw arb::file_not_found_error("unable to open SWC file: "+path.string());
+    }
+    return parse_swc(file->view());
+}
+
 ARB_ARBORIO_API loaded_morphology load_swc_arbor(const std::filesystem::path& path) {
-    std::ifstream fd(path);
-    if (!fd) throw arb::file_not_found_error("unable to open SWC file: "+path.string());
-    return load_swc_arbor(parse_swc(fd));
+    return load_swc_arbor(parse_swc_file(path));
 }
 
 ARB_ARBORIO_API loaded_morphology load_swc_neuron(const std::filesystem::path& path) {
-    std::ifstream fd(path);
-    if (!fd) throw arb::file_not_found_error("unable to open SWC file: "+path.string());
-    return load_swc_neuron(parse_swc(fd));
+    return load_swc_neuron(parse_swc_file(path));
 }
 
 } // namespace arborio
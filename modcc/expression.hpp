@@ -105,6 +105,7 @@ enum class solverMethod {
     cnexp, // for diagonal linear ODE systems.
     sparse, // for non-diagonal linear ODE systems.
     stochastic, // for systems of SDEs
+    expm, // for homogeneous linear ODE systems, integrated exactly.
     none
 };
 
@@ -118,6 +119,7 @@ static std::string to_string(solverMethod m) {
         case solverMethod::cnexp:      return std::string("cnexp");
         case solverMethod::sparse:     return std::string("sparse");
         case solverMethod::stochastic: return std::string("stochastic");
+        case solverMethod::expm:       return std::string("expm");
         case solverMethod::none:       return std::string("none");
     }
     return std::string("<error : undefined solverMethod>");
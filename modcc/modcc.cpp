@@ -3,10 +3,10 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
-#include <regex>
 
 #include <tinyopt/tinyopt.h>
 
+#include "printer/catalogueprinter.hpp"
 #include "printer/cprinter.hpp"
 #include "printer/gpuprinter.hpp"
 #include "printer/infoprinter.hpp"
@@ -49,17 +49,7 @@ std::unordered_map<std::string, targetKind> targetKindMap = {
     {"gpu", targetKind::gpu},
 };
 
-std::unordered_map<std::string, enum simd_spec::simd_abi> simdAbiMap = {
-    {"none",        simd_spec::none},
-    {"neon",        simd_spec::neon},
-    {"sve",         simd_spec::sve},
-    {"vls_sve",     simd_spec::vls_sve},
-    {"avx",         simd_spec::avx},
-    {"avx2",        simd_spec::avx2},
-    {"avx512",      simd_spec::avx512},
-    {"default_abi", simd_spec::default_abi},
-    {"native",      simd_spec::native}
-};
+const auto& simdAbiMap = simd_abi_names();
 
 template <typename Map, typename V>
 auto key_by_value(const Map& map, const V& v) -> decltype(map.begin()->first) {
@@ -117,18 +107,9 @@ std::ostream& operator<<(std::ostream& out, const printer_options& popt) {
 }
 
 std::istream& operator>> (std::istream& i, simd_spec& spec) {
-    auto npos = std::string::npos;
     std::string s;
     i >> s;
-    unsigned width = no_size;
-
-    auto suffix = s.find_last_of('/');
-    if (suffix!=npos) {
-        width = stoul(s.substr(suffix+1));
-        s = s.substr(0, suffix);
-    }
-
-    spec = simd_spec(simdAbiMap.at(s.c_str()), width);
+    spec = parse_simd_spec(s);
     return i;
 }
 
@@ -297,79 +278,7 @@ int main(int argc, char **argv) {
         for (const auto& [mod, prefix]: modules) names.push_back(mod);
         for (const auto& mod: opt.rawfiles) names.push_back(mod);
 
-        const auto ns = std::regex_replace(popt.cpp_namespace, std::regex{"::"}, "_");
-        {
-            auto fn = outdir / (opt.catalogue + "_catalogue.cpp");
-            std::ofstream out(fn);
-             out << "// Automatically generated by modcc\n"
-                   "\n"
-                   "#include <arbor/mechanism_abi.h>\n"
-                   "\n";
-
-            for (const auto& mod: names) out << fmt::format("#include \"{}.hpp\"\n", mod);
-
-            out << "\n"
-                   "#ifdef STANDALONE\n"
-                   "extern \"C\" {\n"
-                   "    [[gnu::visibility(\"default\")]] const void* get_catalogue(int* n) {\n"
-                << fmt::format("        *n = {0};\n"
-                               "        static arb_mechanism cat[{0}] = {{\n",
-                               names.size());
-            for (const auto& mod: names) {
-                out << fmt::format("            make_{}_{}(),\n", ns, mod);
-            }
-            out << "        };\n"
-                   "        return (void*)cat;\n"
-                   "    }\n"
-                   "}\n"
-                   "\n"
-                   "#else\n"
-                   "\n"
-                   "#include <arbor/mechanism.hpp>\n"
-                   "#include <arbor/assert.hpp>\n"
-                   "\n"
-                << fmt::format("#include \"{0}_catalogue.hpp\"\n"
-                               "\n"
-                               "namespace arb {{\n"
-                               "mechanism_catalogue build_{0}_catalogue() {{\n"
-                               "    mechanism_catalogue cat;\n",
-                               opt.catalogue);
-            for (const auto& mod: names) {
-                out << fmt::format("    {{\n"
-                                   "        auto mech = make_{}_{}();\n"
-                                   "        auto ty = mech.type();\n"
-                                   "        auto nm = ty.name;\n"
-                                   "        auto ig = mech.i_gpu();\n"
-                                   "        auto ic = mech.i_cpu();\n"
-                                   "        arb_assert(ic || ig);\n"
-                                   "        cat.add(nm, ty);\n"
-                                   "        if (ic) cat.register_implementation(nm, std::make_unique<arb::mechanism>(ty, *ic));\n"
-                                   "        if (ig) cat.register_implementation(nm, std::make_unique<arb::mechanism>(ty, *ig));\n"
-                                   "    }}\n",
-                                   ns, mod);
-            }
-            out << "    return cat;\n"
-                   "}\n"
-                   "\n"
-                << fmt::format("ARB_ARBOR_API const mechanism_catalogue& global_{0}_catalogue() {{\n"
-                               "    static mechanism_catalogue cat = build_{0}_catalogue();\n"
-                               "    return cat;\n"
-                               "}}\n",
-                               opt.catalogue)
-                << "} // namespace arb\n"
-                   "#endif\n";
-        }
-        {
-        std::ofstream out(outdir / (opt.catalogue + "_catalogue.hpp"));
-        out << fmt::format("#pragma once\n"
-                           "\n"
-                           "#include <arbor/mechcat.hpp>\n"
-                           "#include <arbor/export.hpp>\n"
-                           "\n"
-                           "namespace arb {{\n"
-                           "ARB_ARBOR_API const mechanism_catalogue& global_{0}_catalogue();\n"
-                           "}}\n",
-                           opt.catalogue);
-        }
+        io::write_all(build_catalogue_source(opt.catalogue, names, popt), outdir / (opt.catalogue + "_catalogue.cpp"));
+        io::write_all(build_catalogue_header(opt.catalogue), outdir / (opt.catalogue + "_catalogue.hpp"));
     }
 }
@@ -482,6 +482,14 @@ bool Module::semantic() {
         case solverMethod::stochastic:
                 solver = std::make_unique<EulerMaruyamaSolverVisitor>(white_noise_vars);
             break;
+        case solverMethod::expm:
+            if (solve_expression->variant()==solverVariant::steadystate) {
+                error("SOLVE expression '" + solve_expression->name() + "' cannot be solved for "
+                      "the steady state using the expm method", solve_expression->location());
+                return false;
+            }
+            solver = std::make_unique<ExpmSolverVisitor>();
+            break;
         case solverMethod::none:
             if (deriv->kind()==procedureKind::linear) {
                 solver = std::make_unique<LinearSolverVisitor>(state_vars);
@@ -1657,6 +1657,9 @@ expression_ptr Parser::parse_solve() {
         case tok::stochastic:
             method = solverMethod::stochastic;
             break;
+        case tok::expm:
+            method = solverMethod::expm;
+            break;
         default:
             goto solve_statement_error;
         }
@@ -1678,7 +1681,7 @@ solve_statement_error:
           "    or\n"
           "  SOLVE x\n"
           "where 'x' is the name of a DERIVATIVE block and "
-          "'method' is 'cnexp' or 'sparse'",
+          "'method' is 'cnexp', 'sparse', 'stochastic' or 'expm'",
         loc);
     return nullptr;
 }
@@ -0,0 +1,87 @@
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "printer/catalogueprinter.hpp"
+#include "io/prefixbuf.hpp"
+
+ARB_LIBMODCC_API std::string build_catalogue_source(const std::string& catalogue,
+                                                    const std::vector<std::string>& names,
+                                                    const printer_options& opt) {
+    const auto ns = std::regex_replace(opt.cpp_namespace, std::regex{"::"}, "_");
+
+    io::pfxstringstream out;
+    out << "// Automatically generated by modcc\n"
+           "\n"
+           "#include <arbor/mechanism_abi.h>\n"
+           "\n";
+
+    for (const auto& mod: names) out << fmt::format("#include \"{}.hpp\"\n", mod);
+
+    out << "\n"
+           "#ifdef STANDALONE\n"
+           "extern \"C\" {\n"
+           "    [[gnu::visibility(\"default\")]] const void* get_catalogue(int* n) {\n"
+        << fmt::format("        *n = {0};\n"
+                       "        static arb_mechanism cat[{0}] = {{\n",
+                       names.size());
+    for (const auto& mod: names) {
+        out << fmt::format("            make_{}_{}(),\n", ns, mod);
+    }
+    out << "        };\n"
+           "        return (void*)cat;\n"
+           "    }\n"
+           "}\n"
+           "\n"
+           "#else\n"
+           "\n"
+           "#include <arbor/mechanism.hpp>\n"
+           "#include <arbor/assert.hpp>\n"
+           "\n"
+        << fmt::format("#include \"{0}_catalogue.hpp\"\n"
+                       "\n"
+                       "namespace arb {{\n"
+                       "mechanism_catalogue build_{0}_catalogue() {{\n"
+                       "    mechanism_catalogue cat;\n",
+                       catalogue);
+    for (const auto& mod: names) {
+        out << fmt::format("    {{\n"
+                           "        auto mech = make_{}_{}();\n"
+                           "        auto ty = mech.type();\n"
+                           "        auto nm = ty.name;\n"
+                           "        auto ig = mech.i_gpu();\n"
+                           "        auto ic = mech.i_cpu();\n"
+                           "        arb_assert(ic || ig);\n"
+                           "        cat.add(nm, ty);\n"
+                           "        if (ic) cat.register_implementation(nm, std::make_unique<arb::mechanism>(ty, *ic));\n"
+                           "        if (ig) cat.register_implementation(nm, std::make_unique<arb::mechanism>(ty, *ig));\n"
+                           "    }}\n",
+                           ns, mod);
+    }
+    out << "    return cat;\n"
+           "}\n"
+           "\n"
+        << fmt::format("ARB_ARBOR_API const mechanism_catalogue& global_{0}_catalogue() {{\n"
+                       "    static mechanism_catalogue cat = build_{0}_catalogue();\n"
+                       "    return cat;\n"
+                       "}}\n",
+                       catalogue)
+        << "} // namespace arb\n"
+           "#endif\n";
+
+    return out.str();
+}
+
+ARB_LIBMODCC_API std::string build_catalogue_header(const std::string& catalogue) {
+    return fmt::format("#pragma once\n"
+                       "\n"
+                       "#include <arbor/mechcat.hpp>\n"
+                       "#include <arbor/export.hpp>\n"
+                       "\n"
+                       "namespace arb {{\n"
+                       "ARB_ARBOR_API const mechanism_catalogue& global_{0}_catalogue();\n"
+                       "}}\n",
+                       catalogue);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <libmodcc/export.hpp>
+
+#include "printer/printeropt.hpp"
+
+// Build the catalogue source and header files that collect the mechanisms
+// `names` into the catalogue `catalogue`.
+//
+// The source provides `get_catalogue` for loading as a shared object when
+// compiled with STANDALONE defined, and `arb::global_<catalogue>_catalogue()`
+// otherwise.
+
+ARB_LIBMODCC_API std::string build_catalogue_source(const std::string& catalogue,
+                                                    const std::vector<std::string>& names,
+                                                    const printer_options& opt);
+
+ARB_LIBMODCC_API std::string build_catalogue_header(const std::string& catalogue);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 constexpr unsigned no_size = unsigned(-1);
 
@@ -33,3 +34,33 @@ struct simd_spec {
         }
     }
 };
+
+// Names of SIMD ABIs as accepted on the modcc command line.
+inline const std::unordered_map<std::string, enum simd_spec::simd_abi>& simd_abi_names() {
+    static const std::unordered_map<std::string, enum simd_spec::simd_abi> names = {
+        {"none",        simd_spec::none},
+        {"neon",        simd_spec::neon},
+        {"sve",         simd_spec::sve},
+        {"vls_sve",     simd_spec::vls_sve},
+        {"avx",         simd_spec::avx},
+        {"avx2",        simd_spec::avx2},
+        {"avx512",      simd_spec::avx512},
+        {"default_abi", simd_spec::default_abi},
+        {"native",      simd_spec::native}
+    };
+    return names;
+}
+
+// Parse a SIMD ABI specification such as 'avx2' or 'native/4'; a '/n' suffix
+// forces a SIMD width of n. Throws std::out_of_range for an unknown ABI.
+inline simd_spec parse_simd_spec(std::string s) {
+    unsigned width = no_size;
+
+    auto suffix = s.find_last_of('/');
+    if (suffix!=std::string::npos) {
+        width = std::stoul(s.substr(suffix+1));
+        s = s.substr(0, suffix);
+    }
+
+    return simd_spec(simd_abi_names().at(s), width);
+}
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -143,79 +144,65 @@ not_gating:
 
 // Sparse solver visitor implementation.
 
-static expression_ptr as_expression(symge::symbol_term term) {
-    Location loc;
-    if (term.is_zero()) {
-        return make_expression<IntegerExpression>(loc, 0);
-    }
-    else {
-        return make_expression<MulBinaryExpression>(loc,
-            make_expression<IdentifierExpression>(loc, name(term.left)),
-            make_expression<IdentifierExpression>(loc, name(term.right)));
-    }
-}
-
-static expression_ptr as_expression(symge::symbol_term_diff diff) {
-    Location loc;
-    if (diff.left.is_zero() && diff.right.is_zero()) {
-        return make_expression<IntegerExpression>(loc, 0);
-    }
-    else if (diff.right.is_zero()) {
-        return as_expression(diff.left);
-    }
-    else if (diff.left.is_zero()) {
-        return make_expression<NegUnaryExpression>(loc,
-            as_expression(diff.right));
-    }
-    else {
-        return make_expression<SubBinaryExpression>(loc,
-            as_expression(diff.left),
-            as_expression(diff.right));
-    }
-}
-
-std::vector<local_assignment> SystemSolver::generate_row_updates(scope_ptr scope, std::vector<symge::symbol> row_sym) {
+std::vector<local_assignment> SystemSolver::generate_elimination(scope_ptr scope) {
     std::vector<local_assignment> S_;
-    for (const auto& s: row_sym) {
-        if (primitive(s)) continue;
-
-        auto expr = as_expression(definition(s));
-        auto local_t_term = make_unique_local_assign(scope, expr.get(), "t_");
-        auto t_ = local_t_term.id->is_identifier()->spelling();
-        symtbl_.name(s, t_);
-        S_.push_back(std::move(local_t_term));
-    }
-    return S_;
-}
+    Location loc;
 
-local_assignment SystemSolver::generate_normalizing_term(scope_ptr scope, std::vector<symge::symbol> row_sym) {
-    // Get the max element in the row
-    expression_ptr max;
-    for (auto &s: row_sym) {
-        auto elem = make_expression<IdentifierExpression>(Location(), symtbl_.name(s));
-        auto abs = make_expression<AbsUnaryExpression>(elem->location(), elem->is_identifier()->clone());
-        if (!max) {
-            max = std::move(abs);
-        } else {
-            max = make_expression<MaxBinaryExpression>(elem->location(), max->clone(), std::move(abs));
+    auto n = A_.nrow();
+    auto rhs_col = A_.augcol();
+    auto id = [&loc](const std::string& name) { return make_expression<IdentifierExpression>(loc, name); };
+    auto assign = [&](expression_ptr expr, const char* prefix) {
+        auto l = make_unique_local_assign(scope, expr, prefix);
+        auto name = l.id->is_identifier()->spelling();
+        S_.push_back(std::move(l));
+        return name;
+    };
+
+    // Working copy of the augmented system: names of the locals holding each entry.
+    std::vector<std::map<unsigned, std::string>> rows(n);
+    for (unsigned i = 0; i<n; ++i) {
+        for (const auto& e: A_[i]) rows[i][e.col] = symge::name(e.value);
+    }
+
+    auto order = symge::elimination_order(A_);
+    std::vector<bool> eliminated(n);
+    std::vector<std::string> inv(n);
+
+    // Forward elimination: every step uses one reciprocal of the pivot, and
+    // touches only entries known to be structurally non-zero.
+    for (const auto& p: order) {
+        auto& prow = rows[p.row];
+        inv[p.row] = assign(make_expression<DivBinaryExpression>(loc,
+                                make_expression<NumberExpression>(loc, 1.0), id(prow.at(p.col))), "inv_");
+        eliminated[p.row] = true;
+
+        for (unsigned i = 0; i<n; ++i) {
+            if (eliminated[i] || !rows[i].count(p.col)) continue;
+            auto& row = rows[i];
+
+            auto f = assign(make_expression<MulBinaryExpression>(loc, id(row.at(p.col)), id(inv[p.row])), "f_");
+            row.erase(p.col);
+            for (const auto& [j, a]: prow) {
+                if (j==p.col) continue;
+                auto update = make_expression<MulBinaryExpression>(loc, id(f), id(a));
+                row[j] = assign(row.count(j)?
+                                    make_expression<SubBinaryExpression>(loc, id(row.at(j)), std::move(update)):
+                                    make_expression<NegUnaryExpression>(loc, std::move(update)), "t_");
+            }
         }
     }
-    // Safely invert max
-    auto inv = make_expression<SafeInvUnaryExpression>(max->location(), std::move(max));
-
-    // Create a symbol for inv
-    auto local_inv_term = make_unique_local_assign(scope, inv.get(), "inv_");
 
-    return local_inv_term;
-}
-
-std::vector<expression_ptr> SystemSolver::generate_normalizing_assignments(expression_ptr normalizer, std::vector<symge::symbol> row_sym) {
-    std::vector<expression_ptr> S_;
-    for (auto &s: row_sym) {
-        auto elem = make_expression<IdentifierExpression>(Location(), symtbl_.name(s));
-        auto ratio = make_expression<MulBinaryExpression>(elem->location(), elem->clone(), normalizer->clone());
-        auto assign = make_expression<AssignmentExpression>(elem->location(), elem->clone(), std::move(ratio));
-        S_.push_back(std::move(assign));
+    // Back substitution in reverse pivot order.
+    solution_.assign(n, "");
+    for (auto p = order.rbegin(); p!=order.rend(); ++p) {
+        const auto& row = rows[p->row];
+        expression_ptr b = row.count(rhs_col)? id(row.at(rhs_col)): make_expression<NumberExpression>(loc, 0.0);
+        for (const auto& [j, a]: row) {
+            if (j==p->col || j==rhs_col) continue;
+            b = make_expression<SubBinaryExpression>(loc, std::move(b),
+                    make_expression<MulBinaryExpression>(loc, id(a), id(solution_[j])));
+        }
+        solution_[p->col] = assign(make_expression<MulBinaryExpression>(loc, std::move(b), id(inv[p->row])), "x_");
     }
     return S_;
 }
@@ -223,30 +210,14 @@ std::vector<expression_ptr> SystemSolver::generate_normalizing_assignments(expre
 std::vector<expression_ptr> SystemSolver::generate_solution_assignments(std::vector<std::string> lhs_vars) {
     std::vector<expression_ptr> U_;
 
-    // State variable updates given by rhs/diagonal for reduced matrix.
     Location loc;
-    auto nrow = A_.nrow();
-    for (unsigned i = 0; i < nrow; ++i) {
-        const symge::sym_row& row = A_[i];
-        unsigned rhs_col = A_.augcol();
-        unsigned lhs_col = static_cast<unsigned>(-1);
-        for (unsigned r = 0; r < A_.nrow(); ++r) {
-            if (row[r]) {
-                lhs_col = r;
-                break;
-            }
-        }
-
-        if (lhs_col==unsigned(-1)) {
+    for (unsigned i = 0; i < solution_.size(); ++i) {
+        if (solution_[i].empty()) {
             throw std::logic_error("zero row in matrix solver");
         }
-        auto expr = make_expression<AssignmentExpression>(loc,
-                        make_expression<IdentifierExpression>(loc, lhs_vars[lhs_col]),
-                        make_expression<DivBinaryExpression>(loc,
-                            make_expression<IdentifierExpression>(loc, symge::name(A_[i][rhs_col])),
-                            make_expression<IdentifierExpression>(loc, symge::name(A_[i][lhs_col]))));
-
-        U_.push_back(std::move(expr));
+        U_.push_back(make_expression<AssignmentExpression>(loc,
+                         make_expression<IdentifierExpression>(loc, lhs_vars[i]),
+                         make_expression<IdentifierExpression>(loc, solution_[i])));
     }
     return U_;
 }
@@ -470,33 +441,184 @@ void SparseSolverVisitor::finalize() {
     }
     system_.augment(rhs);
 
-    // Reduce the system
-    auto row_symbols = system_.reduce();
-
-    // Row by row:
-    // Generate entries of the system and declare and assign as local variables
-    // Generate normalizing terms and normalize the row
-    for (auto& row: row_symbols) {
-        auto entries = system_.generate_row_updates(block_scope_, row);
-        for (auto& l: entries) {
-            statements_.push_back(std::move(l.local_decl));
-            statements_.push_back(std::move(l.assignment));
+    // Solve the system, declaring and assigning intermediate entries as local variables
+    for (auto& l: system_.generate_elimination(block_scope_)) {
+        statements_.push_back(std::move(l.local_decl));
+        statements_.push_back(std::move(l.assignment));
+    }
+
+    // Update the state variables
+    auto updates = system_.generate_solution_assignments(dvars_);
+    std::move(std::begin(updates), std::end(updates), std::back_inserter(statements_));
+
+    BlockRewriterBase::finalize();
+}
+
+// Matrix exponential solver visitor implementation.
+
+void ExpmSolverVisitor::visit(BlockExpression* e) {
+    // Do a first pass to extract variables comprising ODE system
+    // lhs; can't really trust 'STATE' block.
+
+    for (auto& stmt: e->statements()) {
+        if (stmt && stmt->is_assignment() && stmt->is_assignment()->lhs()->is_derivative()) {
+            auto id = stmt->is_assignment()->lhs()->is_derivative();
+            dvars_.push_back(id->name());
         }
+    }
+    scale_factor_.resize(dvars_.size());
+    dtA_.resize(dvars_.size());
 
-        // If size of system > 5 normalize the row updates
-        if (system_.size() > 5) {
-            auto norm_term = system_.generate_normalizing_term(block_scope_, row);
-            auto norm_assigns = system_.generate_normalizing_assignments(norm_term.id->clone(), row);
+    BlockRewriterBase::visit(e);
+}
 
-            statements_.push_back(std::move(norm_term.local_decl));
-            statements_.push_back(std::move(norm_term.assignment));
-            std::move(std::begin(norm_assigns), std::end(norm_assigns), std::back_inserter(statements_));
+void ExpmSolverVisitor::visit(CompartmentExpression *e) {
+    auto loc = e->location();
+
+    for (auto& s: e->is_compartment()->state_vars()) {
+        auto it = std::find(dvars_.begin(), dvars_.end(), s->is_identifier()->spelling());
+        if (it == dvars_.end()) {
+            error({"COMPARTMENT variable is not used", loc});
+            return;
         }
+        auto idx = it - dvars_.begin();
+        scale_factor_[idx] = make_expression<DivBinaryExpression>(
+                loc, make_expression<NumberExpression>(loc, 1.0), e->scale_factor()->clone());
     }
+}
 
-    // Update the state variables
-    auto updates = system_.generate_solution_assignments(dvars_);
-    std::move(std::begin(updates), std::end(updates), std::back_inserter(statements_));
+void ExpmSolverVisitor::visit(AssignmentExpression *e) {
+    auto loc = e->location();
+    scope_ptr scope = e->scope();
+
+    auto lhs = e->lhs();
+    auto rhs = e->rhs();
+    auto deriv = lhs->is_derivative();
+
+    if (!deriv) {
+        statements_.push_back(e->clone());
+
+        auto id = lhs->is_identifier();
+        if (id) {
+            auto expand = substitute(rhs, local_expr_);
+            if (involves_identifier(expand, dvars_)) {
+                local_expr_[id->spelling()] = std::move(expand);
+            }
+        }
+        return;
+    }
+
+    auto s = deriv->name();
+    auto expanded_rhs = substitute(rhs, local_expr_);
+    linear_test_result r = linear_test(expanded_rhs, dvars_);
+    if (!r.is_linear || !r.is_homogeneous) {
+        error({"System not homogeneous linear for expm", loc});
+        return;
+    }
+
+    if (s!=dvars_[deq_index_]) {
+        error({"ICE: inconsistent ordering of derivative assignments", loc});
+        return;
+    }
+
+    // Row deq_index_ of dt·A; the entry for column j is c*dt, scaled if
+    // the state in column j is subject to a COMPARTMENT statement.
+    auto dt_expr = make_expression<IdentifierExpression>(loc, "dt");
+    for (unsigned j = 0; j<dvars_.size(); ++j) {
+        if (!r.coef.count(dvars_[j])) continue;
+
+        expression_ptr expr = make_expression<MulBinaryExpression>(loc, r.coef[dvars_[j]]->clone(), dt_expr->clone());
+        if (scale_factor_[j]) {
+            expr = make_expression<MulBinaryExpression>(loc, std::move(expr), scale_factor_[j]->clone());
+        }
+
+        auto local_a_term = make_unique_local_assign(scope, expr.get(), "a_");
+        statements_.push_back(std::move(local_a_term.local_decl));
+        statements_.push_back(std::move(local_a_term.assignment));
+
+        dtA_[deq_index_][j] = local_a_term.id->is_identifier()->spelling();
+    }
+    ++deq_index_;
+}
+
+void ExpmSolverVisitor::finalize() {
+    if (has_error()) return;
+
+    using matrix = std::vector<std::map<unsigned, std::string>>;
+
+    Location loc;
+    const unsigned n = dvars_.size();
+
+    auto id = [&](const std::string& name) {
+        return make_expression<IdentifierExpression>(loc, name);
+    };
+    auto num = [&](double v) {
+        return make_expression<NumberExpression>(loc, v);
+    };
+    auto assign = [&](expression_ptr expr, const char* prefix) {
+        auto local = make_unique_local_assign(block_scope_, expr.get(), prefix);
+        statements_.push_back(std::move(local.local_decl));
+        statements_.push_back(std::move(local.assignment));
+        return local.id->is_identifier()->spelling();
+    };
+
+    // R = I + c·P·Q (or R = P·Q), expanding only structurally non-zero terms.
+    auto product = [&](const matrix& P, const matrix& Q, double c, bool add_identity) {
+        matrix R(n);
+        for (unsigned i = 0; i<n; ++i) {
+            for (unsigned j = 0; j<n; ++j) {
+                expression_ptr sum;
+                for (const auto& [k, p]: P[i]) {
+                    auto q = Q[k].find(j);
+                    if (q==Q[k].end()) continue;
+                    auto term = make_expression<MulBinaryExpression>(loc, id(p), id(q->second));
+                    sum = sum? make_expression<AddBinaryExpression>(loc, std::move(sum), std::move(term)): std::move(term);
+                }
+                if (sum && c!=1) sum = make_expression<MulBinaryExpression>(loc, num(c), std::move(sum));
+                if (add_identity && i==j) {
+                    sum = sum? make_expression<AddBinaryExpression>(loc, num(1.0), std::move(sum)): num(1.0);
+                }
+                if (sum) R[i][j] = assign(std::move(sum), "e_");
+            }
+        }
+        return R;
+    };
+
+    // With B = dt·A/2^s, evaluate the Taylor polynomial of degree m in Horner form,
+    //     T = I + B(I + B/2(... (I + B/m))),
+    // then square s times: exp(dt·A) ≈ T^(2^s).
+    const unsigned m = taylor_degree;
+    const double scale = std::ldexp(1.0, -(int)squarings);
+
+    matrix T(n);
+    for (unsigned i = 0; i<n; ++i) {
+        for (const auto& [j, a]: dtA_[i]) {
+            expression_ptr expr = make_expression<MulBinaryExpression>(loc, num(scale/m), id(a));
+            if (i==j) expr = make_expression<AddBinaryExpression>(loc, num(1.0), std::move(expr));
+            T[i][j] = assign(std::move(expr), "e_");
+        }
+        if (!T[i].count(i)) T[i][i] = assign(num(1.0), "e_");
+    }
+    for (unsigned k = m-1; k>0; --k) {
+        T = product(dtA_, T, scale/k, true);
+    }
+    for (unsigned k = 0; k<squarings; ++k) {
+        T = product(T, T, 1, false);
+    }
+
+    // x ← T·x, computed in full before any state is overwritten.
+    std::vector<std::string> x(n);
+    for (unsigned i = 0; i<n; ++i) {
+        expression_ptr sum;
+        for (const auto& [j, t]: T[i]) {
+            auto term = make_expression<MulBinaryExpression>(loc, id(t), id(dvars_[j]));
+            sum = sum? make_expression<AddBinaryExpression>(loc, std::move(sum), std::move(term)): std::move(term);
+        }
+        x[i] = assign(sum? std::move(sum): num(0.0), "x_");
+    }
+    for (unsigned i = 0; i<n; ++i) {
+        statements_.push_back(make_expression<AssignmentExpression>(loc, id(dvars_[i]), id(x[i])));
+    }
 
     BlockRewriterBase::finalize();
 }
@@ -709,28 +831,10 @@ void LinearSolverVisitor::finalize() {
 
     system_.augment(rhs_);
 
-    // Reduce the system
-    auto row_symbols = system_.reduce();
-
-    // Row by row:
-    // Generate entries of the system and declare and assign as local variables
-    // Generate normalizing terms and normalize the row
-    for (auto& row: row_symbols) {
-        auto entries = system_.generate_row_updates(block_scope_, row);
-        for (auto& l: entries) {
-            statements_.push_back(std::move(l.local_decl));
-            statements_.push_back(std::move(l.assignment));
-        }
-
-        // If size of system > 5 normalize the row updates
-        if (system_.size() > 5) {
-            auto norm_term = system_.generate_normalizing_term(block_scope_, row);
-            auto norm_assigns = system_.generate_normalizing_assignments(norm_term.id->clone(), row);
-
-            statements_.push_back(std::move(norm_term.local_decl));
-            statements_.push_back(std::move(norm_term.assignment));
-            std::move(std::begin(norm_assigns), std::end(norm_assigns), std::back_inserter(statements_));
-        }
+    // Solve the system, declaring and assigning intermediate entries as local variables
+    for (auto& l: system_.generate_elimination(block_scope_)) {
+        statements_.push_back(std::move(l.local_decl));
+        statements_.push_back(std::move(l.assignment));
     }
 
     // Update the state variables
@@ -931,29 +1035,11 @@ void SparseNonlinearSolverVisitor::finalize() {
 
     system_.augment(rhs);
 
-    // Reduce the system
-    auto row_symbols =  system_.reduce();
-
-    // Row by row:
-    // Generate entries of the system and declare and assign as local variables
-    // Generate normalizing terms and normalize the row
+    // Solve the system, declaring intermediate entries as local variables
     std::vector<expression_ptr> S_;
-    for (auto& row: row_symbols) {
-        auto entries = system_.generate_row_updates(block_scope_, row);
-        for (auto& l: entries) {
-            statements_.push_back(std::move(l.local_decl));
-            S_.push_back(std::move(l.assignment));
-        }
-
-        // If size of system > 5 normalize the row updates
-        if (system_.size() > 5) {
-            auto norm_term = system_.generate_normalizing_term(block_scope_, row);
-            auto norm_assigns = system_.generate_normalizing_assignments(norm_term.id->clone(), row);
-
-            statements_.push_back(std::move(norm_term.local_decl));
-            S_.push_back(std::move(norm_term.assignment));
-            std::move(std::begin(norm_assigns), std::end(norm_assigns), std::back_inserter(S_));
-        }
+    for (auto& l: system_.generate_elimination(block_scope_)) {
+        statements_.push_back(std::move(l.local_decl));
+        S_.push_back(std::move(l.assignment));
     }
 
     // Update the state variables
@@ -4,6 +4,7 @@
 // an integration step over the state variables, based on
 // solver method.
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -76,6 +77,9 @@ protected:
     // 'Symbol table' for initial variables.
     symge::symbol_table symtbl_;
 
+    // Names of the locals holding the solution, by column.
+    std::vector<std::string> solution_;
+
 public:
     struct system_loc {
         unsigned row, col;
@@ -86,6 +90,7 @@ public:
     void reset() {
         A_.clear();
         symtbl_.clear();
+        solution_.clear();
     }
     unsigned size() const {
         return A_.size();
@@ -113,20 +118,11 @@ public:
         A_.augment(rhs_sym);
     }
 
-    // Returns a vector of rows of symbols
-    // Needed for normalization
-    std::vector<std::vector<symge::symbol>> reduce() {
-        return symge::gj_reduce(A_, symtbl_);
-    }
-
-    // Returns a vector of local assignments for row updates during system reduction
-    std::vector<local_assignment> generate_row_updates(scope_ptr scope, std::vector<symge::symbol> row_sym);
-
-    // Given a row of symbols, generates local assignment for a normalizing term
-    local_assignment generate_normalizing_term(scope_ptr scope, std::vector<symge::symbol> row_sym);
-
-    // Given a row of symbols, generates expressions normalizing row updates
-    std::vector<expression_ptr> generate_normalizing_assignments(expression_ptr normalizer, std::vector<symge::symbol> row_sym);
+    // Returns local assignments that solve the system by Gaussian elimination
+    // in a static pivot order (see `symge::elimination_order`) followed by
+    // back substitution. The generated code is free of branches and needs one
+    // division per row.
+    std::vector<local_assignment> generate_elimination(scope_ptr scope);
 
     // Returns solution assignment of lhs_vars
     std::vector<expression_ptr> generate_solution_assignments(std::vector<std::string> lhs_vars);
@@ -219,7 +215,7 @@ public:
     virtual void visit(BlockExpression* e) override;
     virtual void visit(AssignmentExpression *e) override;
     virtual void visit(CompartmentExpression *e) override;
-    virtual void visit(ConserveExpression *e) override {};
+    virtual void visit(ConserveExpression *e) override {}
     virtual void finalize() override;
     virtual void reset() override {
         deq_index_ = 0;
@@ -232,6 +228,51 @@ public:
     }
 };
 
+// Exact integration of a homogeneous linear system x' = A·x, where A may depend
+// on anything but the state, by x ← exp(dt·A)·x. The matrix exponential is
+// computed per CV by scaling and squaring a truncated Taylor series.
+class ARB_LIBMODCC_API ExpmSolverVisitor : public SolverVisitorBase {
+protected:
+    // 'Current' differential equation is for variable with this
+    // index in `dvars`.
+    unsigned deq_index_ = 0;
+
+    // Expanded local assignments that need to be substituted in for derivative
+    // calculations.
+    substitute_map local_expr_;
+
+    // State variable multiplier/divider
+    std::vector<expression_ptr> scale_factor_;
+
+    // Non-zero entries of dt·A by row, as names of local variables.
+    std::vector<std::map<unsigned, std::string>> dtA_;
+
+public:
+    using SolverVisitorBase::visit;
+
+    // Degree of the Taylor polynomial and number of squarings; the series is
+    // evaluated for dt·A/2^squarings.
+    static constexpr unsigned taylor_degree = 6;
+    static constexpr unsigned squarings = 10;
+
+    ExpmSolverVisitor() {}
+    ExpmSolverVisitor(scope_ptr enclosing): SolverVisitorBase(enclosing) {}
+
+    virtual void visit(BlockExpression* e) override;
+    virtual void visit(AssignmentExpression *e) override;
+    virtual void visit(CompartmentExpression *e) override;
+    // The exponential preserves the linear invariants of the system.
+    virtual void visit(ConserveExpression *e) override {}
+    virtual void finalize() override;
+    virtual void reset() override {
+        deq_index_ = 0;
+        local_expr_.clear();
+        scale_factor_.clear();
+        dtA_.clear();
+        SolverVisitorBase::reset();
+    }
+};
+
 class ARB_LIBMODCC_API LinearSolverVisitor : public SolverVisitorBase {
 protected:
     // 'Current' differential equation is for variable with this
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <set>
 #include <stdexcept>
 #include <vector>
 #include <numeric>
@@ -7,12 +8,6 @@
 
 namespace symge {
 
-struct pivot {
-    unsigned row;
-    unsigned col;
-};
-
-
 // Returns q[c]*p - p[c]*q; new symbols required due to fill-in are provided by the
 // `define_sym` functor, which takes a `symbol_term_diff` and returns a `symbol`.
 
@@ -144,4 +139,68 @@ ARB_LIBMODCC_API std::vector<std::vector<symge::symbol>> gj_reduce(sym_matrix& A
     return row_symbols;
 }
 
+ARB_LIBMODCC_API std::vector<pivot> elimination_order(const sym_matrix& A) {
+    unsigned n = A.nrow();
+    if (n>A.ncol()) throw std::runtime_error("improper matrix for reduction");
+
+    // Structural non-zeros in the square part of each row.
+    std::vector<std::set<unsigned>> pattern(n);
+    for (unsigned i = 0; i<n; ++i) {
+        for (const auto& e: A[i]) {
+            if (e.col<n) pattern[i].insert(e.col);
+        }
+    }
+
+    std::vector<bool> row_done(n), col_done(n);
+    std::vector<pivot> order;
+
+    // Fill-in caused by eliminating column p.col using row p.row.
+    auto fill = [&](pivot p) {
+        unsigned nfill = 0;
+        for (unsigned i = 0; i<n; ++i) {
+            if (row_done[i] || i==p.row || !pattern[i].count(p.col)) continue;
+            for (auto j: pattern[p.row]) nfill += !pattern[i].count(j);
+        }
+        return nfill;
+    };
+
+    for (unsigned k = 0; k<n; ++k) {
+        pivot best{msparse::row_npos, msparse::row_npos};
+        unsigned best_cost = 0;
+
+        for (unsigned r = 0; r<n; ++r) {
+            if (row_done[r]) continue;
+
+            pivot p{r, msparse::row_npos};
+            if (pattern[r].count(r)) {
+                p.col = r;
+            }
+            else {
+                for (auto c: pattern[r]) {
+                    if (!col_done[c]) { p.col = c; break; }
+                }
+            }
+            if (p.col==msparse::row_npos) throw std::runtime_error("singular matrix for reduction");
+
+            auto cost = fill(p);
+            if (best.row==msparse::row_npos || cost<best_cost) {
+                best = p;
+                best_cost = cost;
+            }
+        }
+
+        for (unsigned i = 0; i<n; ++i) {
+            if (row_done[i] || i==best.row || !pattern[i].count(best.col)) continue;
+            pattern[i].insert(pattern[best.row].begin(), pattern[best.row].end());
+            pattern[i].erase(best.col);
+        }
+        row_done[best.row] = true;
+        col_done[best.col] = true;
+        pattern[best.row].erase(best.col);
+        order.push_back(best);
+    }
+
+    return order;
+}
+
 } // namespace symge
@@ -150,6 +150,17 @@ inline bool primitive(symbol s) {
 using sym_row = msparse::row<symbol>;
 using sym_matrix = msparse::matrix<symbol>;
 
+struct pivot {
+    unsigned row;
+    unsigned col;
+};
+
+// Choose a static pivot sequence for Gaussian elimination of the square part
+// of A, based on its sparsity pattern alone. Pivots are taken from the
+// diagonal where present, in an order that greedily minimises fill-in; no
+// pivoting is performed at run time.
+ARB_LIBMODCC_API std::vector<pivot> elimination_order(const sym_matrix& A);
+
 // Perform Gauss-Jordan reduction on a (possibly augmented) symbolic matrix, with
 // pivots taken from the diagonal elements. New symbol definitions due to fill-in
 // will be added via the provided symbol table.
@@ -67,6 +67,7 @@ static Keyword keywords[] = {
     {"cnexp",               tok::cnexp},
     {"sparse",              tok::sparse},
     {"stochastic",          tok::stochastic},
+    {"expm",                tok::expm},
     {"min",                 tok::min},
     {"max",                 tok::max},
     {"exp",                 tok::exp},
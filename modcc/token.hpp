@@ -91,6 +91,7 @@ enum class tok {
     cnexp,
     sparse,
     stochastic,
+    expm,
 
     conductance,
 
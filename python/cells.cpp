@@ -115,6 +115,10 @@ arb::cv_policy make_cv_policy_max_extent(double cv_length, const std::string& re
     return arb::cv_policy_max_extent(cv_length, arborio::parse_region_expression(reg).unwrap());
 }
 
+arb::cv_policy make_cv_policy_d_lambda(double frequency, double d_lambda, const std::string& reg) {
+    return arb::cv_policy_d_lambda(frequency, d_lambda, arborio::parse_region_expression(reg).unwrap());
+}
+
 // Helper for finding a mechanism description in a Python object.
 // Allows rev_pot_method to be specified with string or mechanism_desc
 std::optional<arb::mechanism_desc> maybe_method(py::object method) {
@@ -186,6 +190,8 @@ void register_cells(py::module& m) {
     py::class_<arb::lif_cell> lif_cell(m, "lif_cell", "A leaky integrate-and-fire cell.");
     py::class_<arb::cv_policy> cv_policy(m, "cv_policy", "Describes the rules used to discretize (compartmentalise) a cable cell morphology.");
     py::class_<ion_settings> py_ion_data(m, "ion_settings");
+    py::class_<arb::adaptive_timestep_parameters> adaptive_timestep(m, "adaptive_timestep",
+        "Settings for adaptive time stepping of cable cells.");
     py::class_<arb::cable_cell_global_properties> gprop(m, "cable_global_properties");
     py::class_<arb::decor> decor(m, "decor",
                                  "Description of the decorations to be applied to a cable cell, that is the painted,\n"
@@ -352,6 +358,14 @@ void register_cells(py::module& m) {
           "domain"_a="(all)", "the domain to which the policy is to be applied",
           "Policy to use as many CVs as required to ensure that no CV has a length longer than a given value.");
 
+    m.def("cv_policy_d_lambda",
+          &make_cv_policy_d_lambda,
+          "frequency"_a=100., "the frequency [Hz] at which the length constant is evaluated",
+          "d_lambda"_a=0.1, "the maximum CV length as a fraction of the length constant",
+          "domain"_a="(all)", "the domain to which the policy is to be applied",
+          "Policy to use an odd number of CVs per branch such that no CV is longer than d_lambda times the\n"
+          "length constant at the given frequency (NEURON's d-lambda rule).");
+
     m.def("cv_policy_fixed_per_branch",
           &make_cv_policy_fixed_per_branch,
           "n"_a, "the number of CVs per branch",
@@ -608,6 +622,29 @@ void register_cells(py::module& m) {
         .def_property_readonly("reversal_potential",        [](const ion_settings& s) { return s.reversal_potential; },        "Reversal potential.")
         .def_property_readonly("reversal_potential_method", [](const ion_settings& s) { return s.reversal_potential_method; }, "Reversal potential method.");
 
+    adaptive_timestep
+        .def(py::init(
+                [](const U::quantity& dv_max, const U::quantity& dt_min, double growth) {
+                    arb::adaptive_timestep_parameters p;
+                    p.dv_max = dv_max.value_as(U::mV);
+                    p.dt_min = dt_min.value_as(U::ms);
+                    p.growth = growth;
+                    return p;
+                }),
+             py::kw_only(), "dv_max"_a=1.0*U::mV, "dt_min"_a=1e-3*U::ms, "growth"_a=2.0,
+             "Construct adaptive time step settings:\n"
+             "  dv_max: target bound on the change of membrane voltage per step [mV].\n"
+             "  dt_min: smallest step, taken after each event [ms].\n"
+             "  growth: factor by which successive steps grow.")
+        .def_property_readonly("dv_max", [](const arb::adaptive_timestep_parameters& p) { return p.dv_max*U::mV; },
+                               "Target bound on the change of membrane voltage per step.")
+        .def_property_readonly("dt_min", [](const arb::adaptive_timestep_parameters& p) { return p.dt_min*U::ms; },
+                               "Smallest step, taken after each event.")
+        .def_readonly("growth", &arb::adaptive_timestep_parameters::growth,
+                      "Factor by which successive steps grow.")
+        .def("__repr__", [](const arb::adaptive_timestep_parameters& p) {
+                return util::pprintf("<arbor.adaptive_timestep: dv_max {} mV, dt_min {} ms, growth {}>", p.dv_max, p.dt_min, p.growth);});
+
     gprop
         .def(py::init<>())
         .def(py::init<const arb::cable_cell_global_properties&>())
@@ -619,6 +656,19 @@ void register_cells(py::module& m) {
         .def_property("membrane_voltage_limit",
                       [](const arb::cable_cell_global_properties& props) { return props.membrane_voltage_limit_mV; },
                       [](arb::cable_cell_global_properties& props, std::optional<double> u) { props.membrane_voltage_limit_mV = u; })
+        .def_readwrite("adaptive_timestep", &arb::cable_cell_global_properties::adaptive_timestep,
+                "Settings for adaptive time stepping; None (the default) for fixed steps of length dt.")
+        .def_property("gap_junction_coupling_interval",
+                      [](const arb::cable_cell_global_properties& props) -> optional<U::quantity> {
+                          if (auto t = props.gap_junction_coupling_interval) return *t*U::ms;
+                          return {};
+                      },
+                      [](arb::cable_cell_global_properties& props, optional<U::quantity> t) {
+                          props.gap_junction_coupling_interval.reset();
+                          if (t) props.gap_junction_coupling_interval = t->value_as(U::ms);
+                      },
+                "Interval at which gap junctions between cells in different cell groups are coupled [ms];\n"
+                "None (the default) to place the peers of each gap junction in the same cell group.")
         // set cable properties
         .def_property_readonly("membrane_potential",
                                [](const arb::cable_cell_global_properties& props) { return props.default_parameters.init_membrane_potential; })
@@ -919,14 +969,23 @@ void register_cells(py::module& m) {
             "locations"_a, "detector"_a, "label"_a,
             "Add a voltage spike detector at each location in locations."
             "The group of spike detectors has the label 'label', used for forming connections between cells.");
+    py::class_<arb::thingify_cache, std::shared_ptr<arb::thingify_cache>> thingify_cache(m, "thingify_cache",
+        "Cache of concrete regions and locsets, shared between cells built from the same morphology object.");
+    thingify_cache
+        .def(py::init<>())
+        .def_property_readonly("size", &arb::thingify_cache::size, "Number of cached regions and locsets.")
+        .def_property_readonly("hits", &arb::thingify_cache::hits, "Number of evaluations served from the cache.")
+        .def("clear", &arb::thingify_cache::clear, "Drop all cached results.");
+
     cable_cell
         .def(py::init(
-            [](const arb::morphology& m, const arb::decor& d, const std::optional<::pyarb::label_dict>& l, const std::optional<arb::cv_policy>& p) {
-                if (l) return arb::cable_cell(m, d, l->dict, p);
-                return arb::cable_cell(m, d, {}, p);
+            [](const arb::morphology& m, const arb::decor& d, const std::optional<::pyarb::label_dict>& l, const std::optional<arb::cv_policy>& p, std::shared_ptr<arb::thingify_cache> c) {
+                if (l) return arb::cable_cell(m, d, l->dict, p, c);
+                return arb::cable_cell(m, d, {}, p, c);
             }),
-            "morphology"_a, "decor"_a, "labels"_a=py::none(), "discretization"_a=py::none(),
-            "Construct with a morphology, decor, label dictionary, and cv policy.")
+            "morphology"_a, "decor"_a, "labels"_a=py::none(), "discretization"_a=py::none(), "cache"_a=py::none(),
+            "Construct with a morphology, decor, label dictionary, and cv policy.\n"
+            "Regions and locsets are concretised through the thingify_cache cache, if given.")
         .def(py::init(
             [](const arb::segment_tree& t, const arb::decor& d, const std::optional<::pyarb::label_dict>& l, const std::optional<arb::cv_policy>& p) {
                 if (l) return arb::cable_cell({t}, d, l->dict, p);
@@ -934,6 +993,13 @@ void register_cells(py::module& m) {
             }),
             "segment_tree"_a, "decor"_a, "labels"_a=py::none(), "discretization"_a=py::none(),
             "Construct with a morphology derived from a segment tree, decor, label dictionary, and cv policy.")
+        .def(py::init(
+            [](const arb::cable_cell& t, const arb::decor& d, const arb::parameter_scaling& s) { return arb::cable_cell(t, d, s); }),
+            "template"_a, "decor"_a, "scaling"_a=arb::parameter_scaling{},
+            "Construct from a template cell and per-instance decorations added to those of the template.\n"
+            "Parameters of painted density mechanisms are multiplied by the factors in scaling,\n"
+            "a dict of mechanism name to a dict of parameter name to factor.\n"
+            "Morphology and labels are shared with the template.")
         .def_property_readonly("num_branches",
             [](const arb::cable_cell& c) {return c.morphology().num_branches();},
             "The number of unbranched cable sections in the morphology.")
@@ -133,6 +133,8 @@ void register_contexts(pybind11::module& m) {
             "Try to bind MPI procs?")
         .def_property("bind_threads", &proc_allocation_shim::get_bind_threads, &proc_allocation_shim::set_bind_threads,
             "Try to bind threads?")
+        .def_property("huge_pages", &proc_allocation_shim::get_huge_pages, &proc_allocation_shim::set_huge_pages,
+            "Back the state of each cell group with transparent huge pages?")
         .def_property("gpu_id", &proc_allocation_shim::get_gpu_id, &proc_allocation_shim::set_gpu_id,
             "The identifier of the GPU to use.\n"
             "Corresponds to the integer parameter used to identify GPUs in CUDA API calls.")
@@ -18,12 +18,14 @@ struct proc_allocation_shim {
     void set_num_threads(unsigned);
     void set_bind_procs(bool bp) { proc_allocation.bind_threads = bp; };
     void set_bind_threads(bool bt) { proc_allocation.bind_threads = bt; };
+    void set_huge_pages(bool hp) { proc_allocation.huge_pages = hp; };
 
     std::optional<int> get_gpu_id() const { return optional_when(proc_allocation.gpu_id, is_nonneg()); };
     unsigned get_num_threads() const { return proc_allocation.num_threads; };
     bool has_gpu() const { return proc_allocation.has_gpu(); };
     bool get_bind_threads() const { return proc_allocation.bind_threads; };
     bool get_bind_procs() const { return proc_allocation.bind_procs; };
+    bool get_huge_pages() const { return proc_allocation.huge_pages; };
 };
 
 // A Python shim that holds the information that describes an arb::context.
@@ -208,6 +208,31 @@ void register_mechanisms(pybind11::module& m) {
     m.def("bbp_catalogue", [](){return arb::global_bbp_catalogue();});
     m.def("stochastic_catalogue", [](){return arb::global_stochastic_catalogue();});
     m.def("load_catalogue", [](pybind11::object fn) { return arb::load_catalogue(util::to_string(fn)); });
+    m.def("compile_catalogue",
+          [](const std::string& name,
+             const std::vector<pybind11::object>& mod_files,
+             const std::string& simd,
+             const std::string& cxx,
+             const std::vector<std::string>& cxx_flags,
+             const std::vector<pybind11::object>& include_dirs,
+             pybind11::object cache_dir) {
+              arb::catalogue_compile_options opts;
+              opts.simd = simd;
+              opts.cxx = cxx;
+              opts.cxx_flags = cxx_flags;
+              for (const auto& dir: include_dirs) opts.include_dirs.emplace_back(util::to_string(dir));
+              if (!cache_dir.is_none()) opts.cache_dir = util::to_string(cache_dir);
+              std::vector<std::filesystem::path> files;
+              for (const auto& fn: mod_files) files.emplace_back(util::to_string(fn));
+              return arb::compile_catalogue(name, files, opts);
+          },
+          "name"_a, "mod_files"_a, "simd"_a="", "cxx"_a="", "cxx_flags"_a=std::vector<std::string>{},
+          "include_dirs"_a=std::vector<pybind11::object>{}, "cache_dir"_a=pybind11::none(),
+          "Generate, compile, and load a catalogue from NMODL files. Results are cached by content and flags.\n"
+          "simd: SIMD ABI as for modcc -S, eg 'native'; empty for no explicit vectorization.\n"
+          "cxx: C++ compiler; defaults to $CXX or the compiler Arbor was built with.\n"
+          "include_dirs: where to find Arbor's headers; defaults to the installation's include directory.\n"
+          "cache_dir: location of cached catalogues; defaults to $ARB_CATALOGUE_CACHE or ~/.cache/arbor.");
 
     // arb::mechanism_desc
     // For specifying a mechanism in the cable_cell interface.
@@ -14,11 +14,14 @@
 #include <arbor/version.hpp>
 
 #include <arborio/label_parse.hpp>
+#include <arborio/morphology_cache.hpp>
+#include <arborio/morphology_loader.hpp>
 #include <arborio/swcio.hpp>
 #include <arborio/neurolucida.hpp>
 #include <arborio/neuroml.hpp>
 #include <arborio/debug.hpp>
 
+#include "context.hpp"
 #include "util.hpp"
 #include "error.hpp"
 #include "label_dict.hpp"
@@ -443,6 +446,66 @@ void register_morphology(py::module& m) {
         "filename_or_stream"_a,
         "Load a morphology or segment_tree and meta data from a Neurolucida ASCII .asc file.");
 
+    py::enum_<arborio::morphology_format>(m, "morphology_format",
+        "Format of morphology files loaded by load_morphologies.")
+        .value("automatic", arborio::morphology_format::automatic, "From the file extension: .swc as swc_arbor, .asc as asc.")
+        .value("swc_arbor", arborio::morphology_format::swc_arbor, "As load_swc_arbor.")
+        .value("swc_neuron", arborio::morphology_format::swc_neuron, "As load_swc_neuron.")
+        .value("asc", arborio::morphology_format::asc, "As load_asc.");
+
+    m.def("load_morphologies",
+        [](const std::vector<std::string>& filenames, const context_shim& ctx, arborio::morphology_format format) {
+            std::vector<std::filesystem::path> paths(filenames.begin(), filenames.end());
+            py::gil_scoped_release release;
+            try {
+                return arborio::load_morphologies(paths, ctx.context, format);
+            }
+            catch (arborio::swc_error& e) {
+                throw pyarb_error(util::pprintf("Arbor SWC: parse error: {}", e.what()));
+            }
+        },
+        "filenames"_a, "context"_a, "format"_a=arborio::morphology_format::automatic,
+        "Load many morphology files in parallel on the threads of the context.\n"
+        "Files with identical contents are parsed only once. Returns a list of\n"
+        "loaded morphologies in the order of the file names.");
+
+    // Binary morphology cache.
+    m.def("write_morphology_cache",
+        [](py::object fn, const std::vector<py::tuple>& items) {
+            std::vector<arborio::morphology_cache_entry> entries;
+            for (const auto& item: items) {
+                if (item.size()<1 || item.size()>3) {
+                    throw pyarb_error("write_morphology_cache: expected tuples (segment_tree[, label_dict[, decor]])");
+                }
+                arborio::morphology_cache_entry e;
+                e.segment_tree = item[0].cast<arb::segment_tree>();
+                if (item.size()>1 && !item[1].is_none()) e.labels = item[1].cast<::pyarb::label_dict>().dict;
+                if (item.size()>2 && !item[2].is_none()) e.decor = item[2].cast<arb::decor>();
+                entries.push_back(std::move(e));
+            }
+            arborio::write_morphology_cache(util::to_path(fn), entries);
+        },
+        "filename"_a, "entries"_a,
+        "Write a binary morphology cache file, given a list of tuples\n"
+        "(segment_tree[, label_dict[, decor]]).");
+
+    py::class_<arborio::morphology_cache> morph_cache(m, "morphology_cache",
+        "Memory mapped binary morphology cache; entries are decoded on access.");
+    morph_cache
+        .def(py::init([](py::object fn) { return arborio::morphology_cache(util::to_path(fn)); }),
+            "filename"_a)
+        .def("__len__", &arborio::morphology_cache::size)
+        .def("segment_tree", &arborio::morphology_cache::segment_tree, "index"_a,
+            "The segment tree of an entry.")
+        .def("morphology", &arborio::morphology_cache::morphology, "index"_a,
+            "The morphology of an entry.")
+        .def("labels",
+            [](const arborio::morphology_cache& c, std::size_t i) { return ::pyarb::label_dict(c.labels(i)); },
+            "index"_a,
+            "The label dictionary of an entry.")
+        .def("decor", &arborio::morphology_cache::decor, "index"_a,
+            "The decor of an entry, or None.");
+
     // arborio::morphology_data
     nml_meta
         .def_readonly("cell_id",
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <string>
 
 #include <pybind11/pybind11.h>
@@ -37,31 +38,57 @@ struct recorder_base: sample_recorder {
                     sample_raw_.data());
     }
 
+    // Hand the buffer over to a NumPy array, which takes ownership, and start
+    // a new one of the reserved size.
+    py::object drain() override {
+        if (sample_raw_.empty()) return samples();
+        auto n_record = std::ptrdiff_t(sample_raw_.size()/stride_);
+        auto buffer = new std::vector<double>(std::move(sample_raw_));
+        py::capsule owner(buffer, [](void* p) { delete static_cast<std::vector<double>*>(p); });
+        sample_raw_ = {};
+        sample_raw_.reserve(reserve_);
+        return py::array_t<double>(
+                    std::vector<std::ptrdiff_t>{n_record, stride_},
+                    buffer->data(),
+                    owner);
+    }
+
     py::object meta() const override {
         return py::cast(meta_);
     }
 
     void reset() override {
         sample_raw_.clear();
+        n_seen_ = 0;
     }
 
 protected:
     Meta meta_;
     std::vector<double> sample_raw_;
     std::ptrdiff_t stride_;
+    std::size_t reserve_;
+    unsigned every_;
+    std::size_t n_seen_ = 0;
+
+    recorder_base(const Meta* meta_ptr, std::ptrdiff_t width, const recorder_options& opts):
+        meta_(*meta_ptr), stride_(1+width), reserve_(opts.reserve*stride_), every_(std::max(1u, opts.every))
+    {
+        sample_raw_.reserve(reserve_);
+    }
 
-    recorder_base(const Meta* meta_ptr, std::ptrdiff_t width):
-        meta_(*meta_ptr), stride_(1+width)
-    {}
+    // Down-sampling: is the next sample kept?
+    bool keep() { return n_seen_++%every_==0; }
 };
 
 template <typename Meta>
 struct recorder_cable_scalar: recorder_base<Meta> {
     using recorder_base<Meta>::sample_raw_;
+    using recorder_base<Meta>::keep;
 
     void record(any_ptr, std::size_t n_sample, const arb::sample_record* records) override {
         for (std::size_t i = 0; i<n_sample; ++i) {
             if (auto* v_ptr =any_cast<const double*>(records[i].data)) {
+                if (!keep()) continue;
                 sample_raw_.push_back(records[i].time);
                 sample_raw_.push_back(*v_ptr);
             }
@@ -72,7 +99,7 @@ struct recorder_cable_scalar: recorder_base<Meta> {
     }
 
 protected:
-    recorder_cable_scalar(const Meta* meta_ptr): recorder_base<Meta>(meta_ptr, 1) {}
+    recorder_cable_scalar(const Meta* meta_ptr, const recorder_options& opts): recorder_base<Meta>(meta_ptr, 1, opts) {}
 };
 
 struct recorder_lif: recorder_base<arb::lif_probe_metadata> {
@@ -81,6 +108,7 @@ struct recorder_lif: recorder_base<arb::lif_probe_metadata> {
     void record(any_ptr, std::size_t n_sample, const arb::sample_record* records) override {
         for (std::size_t i = 0; i<n_sample; ++i) {
             if (auto* v_ptr = any_cast<double*>(records[i].data)) {
+                if (!keep()) continue;
                 sample_raw_.push_back(records[i].time);
                 sample_raw_.push_back(*v_ptr);
             }
@@ -91,16 +119,19 @@ struct recorder_lif: recorder_base<arb::lif_probe_metadata> {
         }
     }
 
-    recorder_lif(const arb::lif_probe_metadata* meta_ptr): recorder_base<arb::lif_probe_metadata>(meta_ptr, 1) {}
+    recorder_lif(const arb::lif_probe_metadata* meta_ptr, const recorder_options& opts):
+        recorder_base<arb::lif_probe_metadata>(meta_ptr, 1, opts) {}
 };
 
 template <typename Meta>
 struct recorder_cable_vector: recorder_base<Meta> {
     using recorder_base<Meta>::sample_raw_;
+    using recorder_base<Meta>::keep;
 
     void record(any_ptr, std::size_t n_sample, const arb::sample_record* records) override {
         for (std::size_t i = 0; i<n_sample; ++i) {
             if (auto* v_ptr = any_cast<const arb::cable_sample_range*>(records[i].data)) {
+                if (!keep()) continue;
                 sample_raw_.push_back(records[i].time);
                 sample_raw_.insert(sample_raw_.end(), v_ptr->first, v_ptr->second);
             }
@@ -111,37 +142,37 @@ struct recorder_cable_vector: recorder_base<Meta> {
     }
 
 protected:
-    recorder_cable_vector(const Meta* meta_ptr, std::ptrdiff_t width):
-        recorder_base<Meta>(meta_ptr, width) {}
+    recorder_cable_vector(const Meta* meta_ptr, std::ptrdiff_t width, const recorder_options& opts):
+        recorder_base<Meta>(meta_ptr, width, opts) {}
 };
 
 // Specific recorder classes:
 struct recorder_cable_scalar_mlocation: recorder_cable_scalar<arb::mlocation> {
-    explicit recorder_cable_scalar_mlocation(const arb::mlocation* meta_ptr):
-        recorder_cable_scalar(meta_ptr) {}
+    explicit recorder_cable_scalar_mlocation(const arb::mlocation* meta_ptr, const recorder_options& opts):
+        recorder_cable_scalar(meta_ptr, opts) {}
 };
 
 struct recorder_cable_scalar_point_info: recorder_cable_scalar<arb::cable_probe_point_info> {
-    explicit recorder_cable_scalar_point_info(const arb::cable_probe_point_info* meta_ptr):
-        recorder_cable_scalar(meta_ptr) {}
+    explicit recorder_cable_scalar_point_info(const arb::cable_probe_point_info* meta_ptr, const recorder_options& opts):
+        recorder_cable_scalar(meta_ptr, opts) {}
 };
 
 struct recorder_cable_vector_mcable: recorder_cable_vector<arb::mcable_list> {
-    explicit recorder_cable_vector_mcable(const arb::mcable_list* meta_ptr):
-        recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size())) {}
+    explicit recorder_cable_vector_mcable(const arb::mcable_list* meta_ptr, const recorder_options& opts):
+        recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size()), opts) {}
 };
 
 struct recorder_cable_vector_point_info: recorder_cable_vector<std::vector<arb::cable_probe_point_info>> {
-    explicit recorder_cable_vector_point_info(const std::vector<arb::cable_probe_point_info>* meta_ptr):
-        recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size())) {}
+    explicit recorder_cable_vector_point_info(const std::vector<arb::cable_probe_point_info>* meta_ptr, const recorder_options& opts):
+        recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size()), opts) {}
 };
 
 // Helper for registering sample recorder factories and (trivial) metadata conversions.
 template <typename Meta, typename Recorder>
 void register_probe_meta_maps(pyarb_global_ptr g) {
     g->recorder_factories.assign<Meta>(
-        [](any_ptr meta_ptr) -> std::unique_ptr<sample_recorder> {
-            return std::unique_ptr<Recorder>(new Recorder(any_cast<const Meta*>(meta_ptr)));
+        [](any_ptr meta_ptr, const recorder_options& opts) -> std::unique_ptr<sample_recorder> {
+            return std::unique_ptr<Recorder>(new Recorder(any_cast<const Meta*>(meta_ptr), opts));
         });
 
     g->probe_meta_converters.assign<Meta>(
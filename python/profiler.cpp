@@ -68,7 +68,18 @@ void register_profiler(pybind11::module& m) {
             "Show summary of the profile; printing contributions above `limit` percent. Defaults to showing all.")
         .def("profiler_clear",
              [] { arb::profile::profiler_clear(); },
-             "Reset the profiler.");
+             "Reset the profiler.")
+        .def("profiler_enable_trace",
+             [](std::size_t capacity) { arb::profile::profiler_enable_trace(capacity); },
+             "capacity"_a=std::size_t(1)<<16,
+             "Record a timeline of the most recent `capacity` profiler regions on each thread; 0 disables tracing.")
+        .def("profiler_trace",
+            [](){
+                std::stringstream stream;
+                arb::profile::profiler_write_trace(stream);
+                return stream.str();
+            },
+            "Return the recorded timeline as Chrome trace-event JSON, with the MPI rank as process id.");
 #endif
 }
 
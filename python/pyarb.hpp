@@ -17,9 +17,19 @@ namespace pyarb {
 
 // Sample recorder object interface.
 
+// Options for recorders: space for `reserve` samples is allocated up front
+// and after each drain, and only every `every`th sample is kept.
+struct recorder_options {
+    std::size_t reserve = 0;
+    unsigned every = 1;
+};
+
 struct sample_recorder {
     virtual void record(arb::util::any_ptr meta, std::size_t n_sample, const arb::sample_record* records) = 0;
+    // All samples held, as a copy.
     virtual pybind11::object samples() const = 0;
+    // The samples held, handed over without copying; the recorder is left empty.
+    virtual pybind11::object drain() = 0;
     virtual pybind11::object meta() const = 0;
     virtual void reset() = 0;
     virtual ~sample_recorder() {}
@@ -28,7 +38,7 @@ struct sample_recorder {
 // Recorder 'factory' type: given an any_ptr to probe metadata of a specific subset of types,
 // return a corresponding sample_recorder instance.
 
-using sample_recorder_factory = std::function<std::unique_ptr<sample_recorder> (arb::util::any_ptr)>;
+using sample_recorder_factory = std::function<std::unique_ptr<sample_recorder> (arb::util::any_ptr, const recorder_options&)>;
 
 // Holds map: probe metadata pointer type → recorder object factory.
 
@@ -40,9 +50,9 @@ struct recorder_factory_map {
         map_[typeid(const Meta*)] = std::move(rf);
     }
 
-    std::unique_ptr<sample_recorder> make_recorder(arb::util::any_ptr meta) const {
+    std::unique_ptr<sample_recorder> make_recorder(arb::util::any_ptr meta, const recorder_options& opts = {}) const {
         try {
-            return map_.at(meta.type())(meta);
+            return map_.at(meta.type())(meta, opts);
         }
         catch (std::out_of_range&) {
             std::string ty = meta.type().name();
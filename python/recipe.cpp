@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
@@ -121,6 +124,79 @@ std::vector<arb::event_generator> recipe_shim::event_generators(arb::cell_gid_ty
     "Python error already thrown");
 }
 
+// Number of cells whose connections are requested from connections_on_range at once.
+static constexpr arb::cell_gid_type connection_range_size = 4096;
+
+std::optional<arb::connection_list> recipe_shim::connections_from_range(arb::cell_gid_type gid) const {
+    std::lock_guard<std::mutex> lock(connection_range_mutex_);
+    auto& range = connection_range_;
+    if (!range.enabled) return std::nullopt;
+
+    if (gid<range.begin || gid>=range.end) {
+        // Request the cells following gid on this rank, or gid alone if the
+        // domain decomposition is unknown.
+        const auto begin = gid;
+        auto end = begin+1;
+        if (decomp_) {
+            const auto limit = std::min(begin+connection_range_size, num_cells());
+            const auto domain = decomp_->domain_id();
+            while (end<limit && decomp_->gid_domain(end)==domain) ++end;
+        }
+
+        // Copy the columns out of Python, then convert without the GIL.
+        auto block = try_catch_pyexception([&]() -> std::optional<connection_block> {
+            pybind11::gil_scoped_acquire guard;
+            auto o = impl_->connections_on_range(begin, end);
+            if (o.is_none()) return std::nullopt;
+            if (!pybind11::isinstance<connection_block>(o)) {
+                throw pyarb_error("recipe.connections_on_range must return an arbor.connection_block or None");
+            }
+            return pybind11::cast<connection_block>(o);
+        }, msg);
+        if (!block) {
+            range.enabled = false;
+            return std::nullopt;
+        }
+
+        std::vector<arb::connection_list> connections(end-begin);
+        const auto n_label = block->labels.size();
+        for (std::size_t i = 0; i<block->target.size(); ++i) {
+            auto tgt = block->target[i];
+            if (tgt<begin || tgt>=end) {
+                throw pyarb_error(util::pprintf("recipe.connections_on_range({}, {}) returned a connection onto gid {}", begin, end, tgt));
+            }
+            if (block->source_label[i]>=n_label || block->target_label[i]>=n_label) {
+                throw pyarb_error(util::pprintf("recipe.connections_on_range({}, {}) returned a label index out of range", begin, end));
+            }
+            connections[tgt-begin].emplace_back(
+                arb::cell_global_label_type{block->source[i], block->labels[block->source_label[i]]},
+                arb::cell_local_label_type{block->labels[block->target_label[i]]},
+                block->weight[i],
+                double(block->delay[i])*U::ms);
+        }
+        range = {true, begin, end, std::move(connections)};
+    }
+    return range.connections[gid-range.begin];
+}
+
+// Turn a label argument of connection_block into indices into the label table.
+static std::vector<std::uint32_t> label_column(pybind11::object arg, std::size_t n, std::vector<std::string>& labels) {
+    if (pybind11::isinstance<pybind11::str>(arg)) {
+        auto label = arg.cast<std::string>();
+        auto it = std::find(labels.begin(), labels.end(), label);
+        std::uint32_t idx = it-labels.begin();
+        if (it==labels.end()) labels.push_back(label);
+        return std::vector<std::uint32_t>(n, idx);
+    }
+    auto a = arg.cast<pybind11::array_t<std::uint32_t, pybind11::array::c_style|pybind11::array::forcecast>>();
+    return {a.data(), a.data()+a.size()};
+}
+
+template <typename T>
+static std::vector<T> column(const pybind11::array_t<T, pybind11::array::c_style|pybind11::array::forcecast>& a) {
+    return {a.data(), a.data()+a.size()};
+}
+
 std::string con_to_string(const arb::cell_connection& c) {
     return util::pprintf("<arbor.connection: source ({}, \"{}\", {}), destination (\"{}\", {}), delay {}, weight {}>",
          c.source.gid, c.source.label.tag, c.source.label.policy, c.target.tag, c.target.policy, c.delay, c.weight);
@@ -227,6 +303,44 @@ void register_recipe(pybind11::module& m) {
         .def("__str__",  &gj_to_string)
         .def("__repr__", &gj_to_string);
 
+    pybind11::class_<connection_block> connection_block(m, "connection_block",
+        "The incoming connections of a range of cells, given as columns.");
+    connection_block
+        .def(pybind11::init(
+            [](pybind11::array_t<arb::cell_gid_type, pybind11::array::c_style|pybind11::array::forcecast> target,
+               pybind11::array_t<arb::cell_gid_type, pybind11::array::c_style|pybind11::array::forcecast> source,
+               pybind11::object source_label,
+               pybind11::object target_label,
+               pybind11::array_t<float, pybind11::array::c_style|pybind11::array::forcecast> weight,
+               pybind11::array_t<float, pybind11::array::c_style|pybind11::array::forcecast> delay,
+               std::vector<std::string> labels) {
+                auto n = target.size();
+                ::pyarb::connection_block b;
+                b.labels = std::move(labels);
+                b.target = column(target);
+                b.source = column(source);
+                b.source_label = label_column(source_label, n, b.labels);
+                b.target_label = label_column(target_label, n, b.labels);
+                b.weight = column(weight);
+                b.delay = column(delay);
+                for (auto k: {b.source.size(), b.source_label.size(), b.target_label.size(), b.weight.size(), b.delay.size()}) {
+                    if (k!=n) throw pyarb_error("connection_block: all columns must have the same length");
+                }
+                for (std::size_t i = 0; i<n; ++i) {
+                    if (!std::isfinite(b.weight[i])) throw pyarb_error("connection_block: weights must be finite");
+                    if (!std::isfinite(b.delay[i]) || b.delay[i]<=0) throw pyarb_error("connection_block: delays must be positive and finite");
+                }
+                return b;
+            }),
+            "target"_a, "source"_a, "source_label"_a, "target_label"_a, "weight"_a, "delay"_a, "labels"_a=std::vector<std::string>{},
+            "Construct from arrays of target gid, source gid, source and target label, weight and delay [ms].\n"
+            "A label is either a string, used for all connections, or an array of indices into labels.")
+        .def_property_readonly("size", [](const ::pyarb::connection_block& b) { return b.target.size(); },
+            "The number of connections.")
+        .def("__len__", [](const ::pyarb::connection_block& b) { return b.target.size(); })
+        .def("__repr__", [](const ::pyarb::connection_block& b) {
+            return util::pprintf("<arbor.connection_block: {} connections>", b.target.size()); });
+
     // Recipes
     pybind11::class_<recipe,
                      recipe_trampoline,
@@ -250,6 +364,10 @@ void register_recipe(pybind11::module& m) {
              pybind11::call_guard<pybind11::gil_scoped_release>(),
             "gid"_a,
             "A list of all the incoming connections to gid, [] by default.")
+        .def("connections_on_range", &recipe::connections_on_range,
+            "begin"_a, "end"_a,
+            "The incoming connections to the gids in [begin, end) as a connection_block, None by default.\n"
+            "If provided, this is used instead of connections_on.")
         .def("resolve_sources", &recipe::resolve_sources,
             "Global string label resolution enabled?.")
         .def("external_connections_on", &recipe::external_connections_on,
@@ -1,13 +1,17 @@
 #pragma once
 
-#include <vector>
+#include <cstdint>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
 
 #include <arbor/cable_cell_param.hpp>
+#include <arbor/domain_decomposition.hpp>
 #include <arbor/event_generator.hpp>
 #include <arbor/morph/isometry.hpp>
 #include <arbor/network.hpp>
@@ -17,6 +21,19 @@
 
 namespace pyarb {
 
+// The incoming connections of a range of cells, held column by column, as
+// returned by recipe.connections_on_range. Source and target labels are
+// indices into `labels`.
+struct connection_block {
+    std::vector<arb::cell_gid_type> target;
+    std::vector<arb::cell_gid_type> source;
+    std::vector<std::uint32_t> source_label;
+    std::vector<std::uint32_t> target_label;
+    std::vector<float> weight;
+    std::vector<float> delay; // [ms]
+    std::vector<std::string> labels;
+};
+
 // pyarb::recipe is the recipe interface used by Python.
 // Calls that return generic types return pybind11::object, to avoid
 // having to wrap some C++ types used by the C++ interface (specifically
@@ -36,6 +53,8 @@ struct recipe {
     virtual bool resolve_sources() const { return true; }
     virtual std::vector<pybind11::object> event_generators(arb::cell_gid_type gid) const { return {}; }
     virtual arb::connection_list connections_on(arb::cell_gid_type gid) const { return {}; }
+    // Either None or a connection_block.
+    virtual pybind11::object connections_on_range(arb::cell_gid_type begin, arb::cell_gid_type end) const { return pybind11::none(); }
     virtual arb::raw_connection_list raw_connections_on(arb::cell_gid_type gid) const { return {}; }
     virtual arb::ext_connection_list external_connections_on(arb::cell_gid_type gid) const { return {}; }
     virtual std::vector<arb::gap_junction_connection> gap_junctions_on(arb::cell_gid_type) const { return {}; }
@@ -75,6 +94,10 @@ struct recipe_trampoline: public recipe {
         PYBIND11_OVERRIDE(arb::connection_list, recipe, connections_on, gid);
     }
 
+    pybind11::object connections_on_range(arb::cell_gid_type begin, arb::cell_gid_type end) const override {
+        PYBIND11_OVERRIDE(pybind11::object, recipe, connections_on_range, begin, end);
+    }
+
     arb::raw_connection_list raw_connections_on(arb::cell_gid_type gid) const override {
         PYBIND11_OVERRIDE(arb::raw_connection_list, recipe, raw_connections_on, gid);
     }
@@ -114,10 +137,26 @@ class recipe_shim: public ::arb::recipe {
     // pointer to the python recipe implementation
     std::shared_ptr<::pyarb::recipe> impl_;
 
+    // Connections of the last range of cells fetched by connections_on_range,
+    // converted to connection lists by target gid.
+    struct connection_range {
+        bool enabled = true;
+        arb::cell_gid_type begin = 0, end = 0;
+        std::vector<arb::connection_list> connections;
+    };
+    mutable connection_range connection_range_;
+    mutable std::mutex connection_range_mutex_;
+
+    // Cells on this rank, if known; ranges never extend past them.
+    arb::domain_decomposition_ptr decomp_;
+
+    std::optional<arb::connection_list> connections_from_range(arb::cell_gid_type gid) const;
+
 public:
     using ::arb::recipe::recipe;
 
-    recipe_shim(std::shared_ptr<::pyarb::recipe> r): impl_(std::move(r)) {}
+    recipe_shim(std::shared_ptr<::pyarb::recipe> r, arb::domain_decomposition_ptr decomp = nullptr):
+        impl_(std::move(r)), decomp_(std::move(decomp)) {}
 
     const char* msg = "Python error already thrown";
 
@@ -139,7 +178,9 @@ public:
 
     std::vector<arb::event_generator> event_generators(arb::cell_gid_type gid) const override;
 
+    // Taken from connections_on_range, if the recipe provides it.
     arb::connection_list connections_on(arb::cell_gid_type gid) const override {
+        if (auto conns = connections_from_range(gid)) return std::move(*conns);
         return try_catch_pyexception([&](){ return impl_->connections_on(gid); }, msg);
     }
 
@@ -35,6 +35,11 @@ std::ostream& operator<<(std::ostream& o, const poisson_schedule_shim& p) {
              << ", seed " << p.seed << ">";
 }
 
+std::ostream& operator<<(std::ostream& o, const poisson_superposition_schedule_shim& p) {
+    return o << "<arbor.poisson_superposition_schedule: sources " << p.sources.size()
+             << ", seed " << p.seed << ">";
+}
+
 static std::vector<arb::time_type> as_vector(std::pair<const arb::time_type*, const arb::time_type*> ts) {
     return std::vector<arb::time_type>(ts.first, ts.second);
 }
@@ -179,6 +184,30 @@ std::vector<arb::time_type> poisson_schedule_shim::events(const arb::units::quan
     return as_vector(sched.events(beg, end));
 }
 
+poisson_superposition_schedule_shim::poisson_superposition_schedule_shim(std::vector<poisson_schedule_shim> srcs,
+                                                                         arb::seed_type s):
+    sources(std::move(srcs)), seed(s)
+{}
+
+arb::schedule poisson_superposition_schedule_shim::schedule() const {
+    std::vector<arb::poisson_source> srcs;
+    srcs.reserve(sources.size());
+    for (const auto& p: sources) srcs.push_back({p.freq, p.tstart, p.tstop});
+    return arb::poisson_superposition_schedule(srcs, seed);
+}
+
+std::vector<arb::time_type> poisson_superposition_schedule_shim::events(const arb::units::quantity& t0,
+                                                                        const arb::units::quantity& t1) {
+    auto beg = t0.value_as(arb::units::ms);
+    auto end = t1.value_as(arb::units::ms);
+    pyarb::assert_throw(is_nonneg()(beg), "t0 must be a non-negative number");
+    pyarb::assert_throw(is_nonneg()(end), "t1 must be a non-negative number");
+
+    arb::schedule sched = poisson_superposition_schedule_shim::schedule();
+
+    return as_vector(sched.events(beg, end));
+}
+
 void register_schedules(py::module& m) {
     using namespace py::literals;
     using time_type = arb::units::quantity;
@@ -259,6 +288,25 @@ void register_schedules(py::module& m) {
             "A view of monotonically increasing time values in the half-open interval [t0, t1).")
         .def("__str__",  util::to_string<poisson_schedule_shim>)
         .def("__repr__", util::to_string<poisson_schedule_shim>);
+
+    // Superposition of Poisson schedules
+    py::class_<poisson_superposition_schedule_shim, schedule_shim_base> poisson_superposition_schedule(m, "poisson_superposition_schedule",
+        "Describes the superposition of independent Poisson processes as one Poisson process with the summed rate.");
+
+    poisson_superposition_schedule
+        .def(py::init<std::vector<poisson_schedule_shim>, arb::seed_type>(),
+             "sources"_a, py::kw_only(), "seed"_a = 0,
+             "Construct a superposition of Poisson schedules with arguments:\n"
+             "  sources: The Poisson schedules to superpose; their seeds are ignored.\n"
+             "  seed:    The seed for the random number generator, 0 by default.")
+        .def_readonly("sources", &poisson_superposition_schedule_shim::sources,
+            "The superposed Poisson schedules.")
+        .def_readwrite("seed", &poisson_superposition_schedule_shim::seed,
+            "The seed for the random number generator.")
+        .def("events", &poisson_superposition_schedule_shim::events,
+            "A view of monotonically increasing time values in the half-open interval [t0, t1).")
+        .def("__str__",  util::to_string<poisson_superposition_schedule_shim>)
+        .def("__repr__", util::to_string<poisson_superposition_schedule_shim>);
 }
 
 }
@@ -107,4 +107,17 @@ struct poisson_schedule_shim: schedule_shim_base {
 
 };
 
+// A Python shim for arb::poisson_superposition_schedule, with the sources
+// given as Poisson schedules whose seeds are ignored.
+struct poisson_superposition_schedule_shim: schedule_shim_base {
+    std::vector<poisson_schedule_shim> sources;
+    arb::seed_type seed = arb::default_seed;
+
+    poisson_superposition_schedule_shim(std::vector<poisson_schedule_shim> srcs, arb::seed_type s);
+
+    std::vector<arb::time_type> events(const arb::units::quantity& t0, const arb::units::quantity& t1);
+
+    arb::schedule schedule() const override;
+};
+
 }
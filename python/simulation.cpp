@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -13,6 +18,7 @@
 #include "pyarb.hpp"
 #include "recipe.hpp"
 #include "schedule.hpp"
+#include "strprintf.hpp"
 
 #include <arborio/json_serdes.hpp>
 #include <arbor/serdes.hpp>
@@ -32,7 +38,11 @@ enum class spike_recording {
 
 class simulation_shim {
     std::unique_ptr<arb::simulation> sim_;
+    arb::domain_decomposition_ptr decomp_;
+    // Spikes are appended by the simulation's spike callback, which runs
+    // without the GIL, and may be drained from another Python thread.
     std::vector<arb::spike> spike_record_;
+    std::mutex spike_mutex_;
     pyarb_global_ptr global_ptr_;
 
     using sample_recorder_ptr = std::unique_ptr<sample_recorder>;
@@ -55,16 +65,27 @@ class simulation_shim {
             }
             return result;
         }
+
+        py::list drain() const {
+            std::size_t size = recorders->size();
+            py::list result(size);
+
+            for (std::size_t i = 0; i<size; ++i) {
+                result[i] = py::make_tuple(recorders->at(i)->drain(), recorders->at(i)->meta());
+            }
+            return result;
+        }
     };
 
     std::unordered_map<arb::sampler_association_handle, sampler_callback> sampler_map_;
 
 public:
     simulation_shim(std::shared_ptr<recipe>& rec, const context_shim& ctx, const arb::domain_decomposition_ptr decomp, std::uint64_t seed, pyarb_global_ptr global_ptr):
+        decomp_(decomp),
         global_ptr_(global_ptr)
     {
         try {
-            sim_.reset(new arb::simulation(recipe_shim(rec), ctx.context, decomp, seed));
+            sim_.reset(new arb::simulation(recipe_shim(rec, decomp), ctx.context, decomp, seed));
         }
         catch (...) {
             py_reset_and_throw();
@@ -74,7 +95,7 @@ public:
 
     void update(std::shared_ptr<recipe>& rec) {
         try {
-            sim_->update(recipe_shim(rec));
+            sim_->update(recipe_shim(rec, decomp_));
         }
         catch (...) {
             py_reset_and_throw();
@@ -101,7 +122,7 @@ public:
 
     void reset() {
         sim_->reset();
-        spike_record_.clear();
+        clear_spikes();
         for (auto&& [handle, cb]: sampler_map_) {
             for (auto& rec: *cb.recorders) {
                 rec->reset();
@@ -109,8 +130,13 @@ public:
         }
     }
 
-    void clear_samplers() {
+    void clear_spikes() {
+        std::lock_guard<std::mutex> lock(spike_mutex_);
         spike_record_.clear();
+    }
+
+    void clear_samplers() {
+        clear_spikes();
         for (auto&& [handle, cb]: sampler_map_) {
             for (auto& rec: *cb.recorders) {
                 rec->reset();
@@ -122,11 +148,19 @@ public:
         return sim_->run(tfinal, dt);
     }
 
-    void record(spike_recording policy) {
-        auto spike_recorder = [this](const std::vector<arb::spike>& spikes) {
+    void record(spike_recording policy, std::optional<std::pair<arb::cell_gid_type, arb::cell_gid_type>> gids) {
+        auto spike_recorder = [this, gids](const std::vector<arb::spike>& spikes) {
+            std::lock_guard<std::mutex> lock(spike_mutex_);
             auto old_size = spike_record_.size();
             // Append the new spikes to the end of the spike record.
-            spike_record_.insert(spike_record_.end(), spikes.begin(), spikes.end());
+            if (gids) {
+                auto [lo, hi] = *gids;
+                std::copy_if(spikes.begin(), spikes.end(), std::back_inserter(spike_record_),
+                             [lo=lo, hi=hi](const auto& s) { return s.source.gid>=lo && s.source.gid<hi; });
+            }
+            else {
+                spike_record_.insert(spike_record_.end(), spikes.begin(), spikes.end());
+            }
             // Sort the newly appended spikes.
             std::sort(spike_record_.begin()+old_size, spike_record_.end(),
                     [](const auto& lhs, const auto& rhs) {
@@ -150,10 +184,24 @@ public:
         }
     }
 
-    py::object spikes() const {
+    py::object spikes() {
+        std::lock_guard<std::mutex> lock(spike_mutex_);
         return py::array_t<arb::spike>(py::ssize_t(spike_record_.size()), spike_record_.data());
     }
 
+    // Swap out the spike record and hand it to a NumPy array without copying;
+    // recording continues into a fresh buffer.
+    py::object drain_spikes() {
+        auto drained = new std::vector<arb::spike>();
+        {
+            std::lock_guard<std::mutex> lock(spike_mutex_);
+            std::swap(*drained, spike_record_);
+        }
+        py::capsule owner(drained, [](void* p) { delete static_cast<std::vector<arb::spike>*>(p); });
+        if (drained->empty()) return py::array_t<arb::spike>(0);
+        return py::array_t<arb::spike>(py::ssize_t(drained->size()), drained->data(), owner);
+    }
+
     py::list get_probe_metadata(const arb::cell_address_type& probeset_id) const {
         py::list result;
         for (auto&& pm: sim_->get_probe_metadata(probeset_id)) {
@@ -162,11 +210,13 @@ public:
         return result;
     }
 
-    arb::sampler_association_handle sample(const arb::cell_address_type& probeset_id, const pyarb::schedule_shim_base& sched) {
+    arb::sampler_association_handle sample(const arb::cell_address_type& probeset_id,
+                                           const pyarb::schedule_shim_base& sched,
+                                           const recorder_options& opts = {}) {
         std::shared_ptr<sample_recorder_vec> recorders{new sample_recorder_vec};
 
         for (const arb::probe_metadata& pm: sim_->get_probe_metadata(probeset_id)) {
-            recorders->push_back(global_ptr_->recorder_factories.make_recorder(pm.meta));
+            recorders->push_back(global_ptr_->recorder_factories.make_recorder(pm.meta, opts));
         }
 
         // Constructed callbacks are passed to the underlying simulator object, _and_ a copy
@@ -179,6 +229,15 @@ public:
         return sah;
     }
 
+    py::list drain_samples(arb::sampler_association_handle sah) {
+        if (auto iter = sampler_map_.find(sah); iter!=sampler_map_.end()) {
+            return iter->second.drain();
+        }
+        else {
+            return py::list{};
+        }
+    }
+
     void remove_sampler(arb::sampler_association_handle sah) {
         sim_->remove_sampler(sah);
         sampler_map_.erase(sah);
@@ -201,6 +260,14 @@ public:
     void progress_banner() {
         sim_->set_epoch_callback(arb::epoch_progress_bar());
     }
+
+    std::vector<arb::mechanism_counters> mechanism_counters() const {
+        return sim_->get_mechanism_counters();
+    }
+
+    std::vector<arb::epoch_metrics> epoch_metrics() const {
+        return sim_->get_epoch_metrics();
+    }
 };
 
 void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
@@ -211,6 +278,58 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
        .value("local", spike_recording::local)
        .value("all", spike_recording::all);
 
+    py::class_<arb::mechanism_kernel_counter> kernel_counter(m, "mechanism_kernel_counter",
+        "Number of calls and cumulative wall-clock time of a mechanism kernel.");
+    kernel_counter
+        .def_readonly("calls", &arb::mechanism_kernel_counter::calls, "Number of calls.")
+        .def_readonly("time", &arb::mechanism_kernel_counter::time, "Total time spent [s].")
+        .def_property_readonly("mean_time", &arb::mechanism_kernel_counter::mean_time, "Mean time per call [s].")
+        .def("__repr__", [](const arb::mechanism_kernel_counter& c) {
+            return util::pprintf("<arbor.mechanism_kernel_counter: calls {}, time {} s>", c.calls, c.time); });
+
+    py::class_<arb::mechanism_counters> mech_counters(m, "mechanism_counters",
+        "Runtime counters of a mechanism instance in a cell group.");
+    mech_counters
+        .def_readonly("name", &arb::mechanism_counters::name, "Mechanism name.")
+        .def_readonly("group", &arb::mechanism_counters::group, "Index of the local cell group.")
+        .def_readonly("width", &arb::mechanism_counters::width, "Number of CVs or point processes.")
+        .def_readonly("events_applied", &arb::mechanism_counters::events_applied, "Number of delivered events.")
+        .def_readonly("init", &arb::mechanism_counters::init, "Initialisation kernel.")
+        .def_readonly("current", &arb::mechanism_counters::current, "Current kernel.")
+        .def_readonly("state", &arb::mechanism_counters::state, "State update kernel.")
+        .def_readonly("events", &arb::mechanism_counters::events, "Event delivery kernel.")
+        .def_readonly("ions", &arb::mechanism_counters::ions, "Ion update kernel.")
+        .def_readonly("post", &arb::mechanism_counters::post, "Post-event kernel.")
+        .def("__repr__", [](const arb::mechanism_counters& c) {
+            return util::pprintf("<arbor.mechanism_counters: {} in group {}, width {}>", c.name, c.group, c.width); });
+
+    py::class_<arb::epoch_metrics> epoch_metrics(m, "epoch_metrics",
+        "Timings [s] and counts of one integration epoch.");
+    epoch_metrics
+        .def_readonly("id", &arb::epoch_metrics::id, "Epoch index.")
+        .def_readonly("t0", &arb::epoch_metrics::t0, "Start of the epoch [ms].")
+        .def_readonly("t1", &arb::epoch_metrics::t1, "End of the epoch [ms].")
+        .def_readonly("advance_max", &arb::epoch_metrics::advance_max, "Advance time of the slowest cell group.")
+        .def_readonly("advance_mean", &arb::epoch_metrics::advance_mean, "Mean advance time of the cell groups.")
+        .def_readonly("update", &arb::epoch_metrics::update, "Time to advance all cell groups.")
+        .def_readonly("exchange", &arb::epoch_metrics::exchange, "Exchange of the spikes of the epoch.")
+        .def_readonly("gather", &arb::epoch_metrics::gather, "Part of the exchange spent gathering spikes across ranks.")
+        .def_readonly("enqueue", &arb::epoch_metrics::enqueue, "Enqueueing of the events of the epoch.")
+        .def_readonly("communication", &arb::epoch_metrics::communication, "Communication serving the neighbouring epochs, concurrent with the update.")
+        .def_readonly("step", &arb::epoch_metrics::step, "Time until update and communication were both done.")
+        .def_readonly("num_spikes", &arb::epoch_metrics::num_spikes, "Spikes generated on this rank.")
+        .def_readonly("num_events", &arb::epoch_metrics::num_events, "Events delivered on this rank.")
+        .def_readonly("rank_update_max", &arb::epoch_metrics::rank_update_max, "Update time of the slowest rank.")
+        .def_readonly("rank_update_mean", &arb::epoch_metrics::rank_update_mean, "Mean update time of the ranks.")
+        .def_property_readonly("update_critical", &arb::epoch_metrics::update_critical,
+            "Whether the update, rather than the communication, bounded the step.")
+        .def_property_readonly("rank_imbalance", &arb::epoch_metrics::rank_imbalance,
+            "Ratio of the slowest to the mean rank update time.")
+        .def_property_readonly("group_imbalance", &arb::epoch_metrics::group_imbalance,
+            "Ratio of the slowest to the mean cell group advance time.")
+        .def("__repr__", [](const arb::epoch_metrics& e) {
+            return util::pprintf("<arbor.epoch_metrics: epoch {} [{}, {}) ms, update {} s, exchange {} s>", e.id, e.t0, e.t1, e.update, e.exchange); });
+
     // Simulation
     py::class_<simulation_shim> simulation(m, "simulation",
         "The executable form of a model.\n"
@@ -271,9 +390,14 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
             "Run the simulation from current simulation time to tfinal [ms], with maximum time step size dt [ms].",
             "tfinal"_a, py::arg_v("dt", 0.025*arb::units::ms, "0.025*arbor.units.ms"))
         .def("record", &simulation_shim::record,
-            "Disable or enable local or global spike recording.")
+            "Disable or enable local or global spike recording.\n"
+            "If gids=(begin, end) is given, only spikes from sources with gid in [begin, end) are recorded.",
+            "policy"_a, "gids"_a=py::none())
         .def("spikes", &simulation_shim::spikes,
             "Retrieve recorded spikes as numpy array.")
+        .def("drain_spikes", &simulation_shim::drain_spikes,
+            "Retrieve the spikes recorded since the last call to drain_spikes as numpy array, without copying.\n"
+            "The spikes are removed from the record. May be called while the simulation runs in another thread.")
         .def("probe_metadata", &simulation_shim::get_probe_metadata,
             "Retrieve metadata associated with given probe id.",
             "probeset_id"_a)
@@ -290,34 +414,52 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
              },
             "Retrieve metadata associated with given probe id.",
             "gid"_a, "tag"_a)
-        .def("sample", &simulation_shim::sample,
+        .def("sample",
+             [](simulation_shim& sim, const arb::cell_address_type& probeset_id, const schedule_shim_base& schedule,
+                std::size_t reserve, unsigned every) {
+                 return sim.sample(probeset_id, schedule, {reserve, every});
+             },
             "Record data from probes with given probeset_id according to supplied schedule.\n"
+            "Space for reserve samples is allocated up front, and only every every-th sample is kept.\n"
             "Returns handle for retrieving data or removing the sampling.",
-            "probeset_id"_a, "schedule"_a)
+            "probeset_id"_a, "schedule"_a, "reserve"_a=0, "every"_a=1)
         .def("sample",
-             [](simulation_shim& sim, arb::cell_gid_type gid, const arb::cell_tag_type& tag, const schedule_shim_base& schedule) {
-                 return sim.sample({gid, tag}, schedule);
+             [](simulation_shim& sim, arb::cell_gid_type gid, const arb::cell_tag_type& tag, const schedule_shim_base& schedule,
+                std::size_t reserve, unsigned every) {
+                 return sim.sample({gid, tag}, schedule, {reserve, every});
              },
             "Record data from probes with given probeset_id=(gid, tag) according to supplied schedule.\n"
+            "Space for reserve samples is allocated up front, and only every every-th sample is kept.\n"
             "Returns handle for retrieving data or removing the sampling.",
-            "gid"_a, "tag"_a, "schedule"_a)
+            "gid"_a, "tag"_a, "schedule"_a, "reserve"_a=0, "every"_a=1)
         .def("sample",
-             [](simulation_shim& sim, const std::tuple<arb::cell_gid_type, const arb::cell_tag_type>& addr, const schedule_shim_base& schedule) {
-                 return sim.sample({std::get<0>(addr), std::get<1>(addr)}, schedule);
+             [](simulation_shim& sim, const std::tuple<arb::cell_gid_type, const arb::cell_tag_type>& addr, const schedule_shim_base& schedule,
+                std::size_t reserve, unsigned every) {
+                 return sim.sample({std::get<0>(addr), std::get<1>(addr)}, schedule, {reserve, every});
              },
             "Record data from probes with given probeset_id=(gid, tag) according to supplied schedule.\n"
+            "Space for reserve samples is allocated up front, and only every every-th sample is kept.\n"
             "Returns handle for retrieving data or removing the sampling.",
-            "probeset_id"_a, "schedule"_a)
+            "probeset_id"_a, "schedule"_a, "reserve"_a=0, "every"_a=1)
         .def("samples", &simulation_shim::samples,
             "Retrieve sample data as a list, one element per probe associated with the query.",
             "handle"_a)
+        .def("drain_samples", &simulation_shim::drain_samples,
+            "Retrieve the sample data recorded since the last call to drain_samples as a list, one element\n"
+            "per probe associated with the query, without copying. The data is removed from the simulation.",
+            "handle"_a)
         .def("remove_sampler", &simulation_shim::remove_sampler,
             "Remove sampling associated with the given handle.",
             "handle"_a)
         .def("remove_all_samplers", &simulation_shim::remove_sampler,
             "Remove all sampling on the simulatr.")
         .def("progress_banner", &simulation_shim::progress_banner,
-            "Show a text progress bar during simulation.");
+            "Show a text progress bar during simulation.")
+        .def("mechanism_counters", &simulation_shim::mechanism_counters,
+            "Runtime counters of all mechanism instances in the local cell groups.")
+        .def("epoch_metrics", &simulation_shim::epoch_metrics,
+            "Timings and counts of each of the most recent 16384 epochs since construction or the last reset.\n"
+            "Collective: must be called on all ranks.");
 
 }
 
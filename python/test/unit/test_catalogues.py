@@ -44,6 +44,20 @@ class TestCatalogues(unittest.TestCase):
         with self.assertRaises(FileNotFoundError):
             A.load_catalogue("_NO_EXIST_.so")
 
+    def test_compile_bad_input(self):
+        with self.assertRaises(RuntimeError):
+            A.compile_catalogue("not a name", ["dummy.mod"])
+        with self.assertRaises(RuntimeError):
+            A.compile_catalogue("empty", [], include_dirs=["/nonexistent"])
+        with self.assertRaises(FileNotFoundError):
+            A.compile_catalogue(
+                "missing",
+                ["_NO_EXIST_.mod"],
+                cxx_flags=["-O2"],
+                include_dirs=["/nonexistent"],
+                cache_dir="/nonexistent",
+            )
+
     @fixtures.dummy_catalogue()
     def test_shared_catalogue(self, dummy_catalogue):
         cat = dummy_catalogue
@@ -212,6 +212,58 @@ class TestAscIo(unittest.TestCase):
         load_pathio(self.loaders(), asc, "test.asc")
 
 
+class TestLoadMorphologies(unittest.TestCase):
+    def test_batch(self):
+        with TD() as tmp:
+            tmp = Path(tmp)
+            names = []
+            for fn, text in [("a.swc", swc_arbor), ("b.asc", asc), ("c.swc", swc_arbor)]:
+                with open(tmp / fn, "w") as fd:
+                    fd.write(text)
+                names.append(str(tmp / fn))
+
+            ctx = A.context(threads=2)
+            morphs = A.load_morphologies(names, ctx)
+            self.assertEqual(len(morphs), 3)
+            self.assertEqual(
+                morphs[0].morphology.num_branches,
+                A.load_swc_arbor(names[0]).morphology.num_branches,
+            )
+            self.assertEqual(
+                morphs[1].morphology.num_branches,
+                A.load_asc(names[1]).morphology.num_branches,
+            )
+            self.assertEqual(
+                morphs[2].segment_tree.size, morphs[0].segment_tree.size
+            )
+
+            morphs = A.load_morphologies(
+                names[:1], ctx, format=A.morphology_format.swc_neuron
+            )
+            self.assertEqual(len(morphs), 1)
+
+
+class TestMorphologyCache(unittest.TestCase):
+    def test_round_trip(self):
+        with TD() as tmp:
+            fn = Path(tmp) / "cells.cache"
+            morph = A.load_swc_arbor(StringIO(swc_arbor))
+            dec = A.decor().paint("(all)", A.density("pas"))
+            A.write_morphology_cache(
+                fn, [(morph.segment_tree, morph.labels), (morph.segment_tree, None, dec)]
+            )
+
+            cache = A.morphology_cache(fn)
+            self.assertEqual(len(cache), 2)
+            self.assertEqual(cache.segment_tree(0).size, morph.segment_tree.size)
+            self.assertEqual(
+                cache.morphology(1).num_branches, morph.morphology.num_branches
+            )
+            self.assertEqual(len(cache.labels(0)), len(morph.labels))
+            self.assertIsNone(cache.decor(0))
+            self.assertEqual(len(cache.decor(1).paintings()), 1)
+
+
 class serdes_recipe(A.recipe):
     def __init__(self):
         A.recipe.__init__(self)
@@ -225,3 +225,25 @@ class TestLifProbes(unittest.TestCase):
         )
         for d, _ in smp:
             np.testing.assert_allclose(d, exp)
+
+    def test_drain_and_every(self):
+        rec = lif_recipe()
+        sim = A.simulation(rec)
+        hdl = sim.sample(0, "Um", A.regular_schedule(0.1 * U.ms), reserve=16)
+        every = sim.sample(0, "Um", A.regular_schedule(0.1 * U.ms), every=3)
+
+        sim.run(0.5 * U.ms, 0.05 * U.ms)
+        (first, _), = sim.drain_samples(hdl)
+        sim.run(1.0 * U.ms, 0.05 * U.ms)
+        (second, _), = sim.drain_samples(hdl)
+        (third, _), = sim.drain_samples(hdl)
+
+        self.assertEqual((5, 2), first.shape)
+        self.assertEqual((5, 2), second.shape)
+        self.assertEqual((0, 2), third.shape)
+        np.testing.assert_allclose([0.0, 0.1, 0.2, 0.3, 0.4], first[:, 0])
+        np.testing.assert_allclose([0.5, 0.6, 0.7, 0.8, 0.9], second[:, 0])
+        self.assertEqual(0, len(sim.samples(hdl)[0][0]))
+
+        (thinned, _), = sim.samples(every)
+        np.testing.assert_allclose([0.0, 0.3, 0.6, 0.9], thinned[:, 0])
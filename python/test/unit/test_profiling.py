@@ -7,6 +7,8 @@ import unittest
 import arbor as A
 from arbor import units as U
 import functools
+import json
+import re
 
 """
 all tests for profiling
@@ -98,3 +100,22 @@ class TestProfiling(unittest.TestCase):
         summary = A.profiler_summary()
         self.assertEqual(str, type(summary), "profiler summary must be str")
         self.assertTrue(summary, "empty summary")
+
+    @lazy_skipIf(skipWithoutSupport, "run test only with profiling support")
+    def test_trace(self):
+        context = A.context()
+        A.profiler_initialize(context)
+        A.profiler_enable_trace(1000)
+        recipe = a_recipe()
+        dd = A.partition_load_balance(recipe, context)
+        A.simulation(recipe, context, dd).run(1 * U.ms)
+        text = A.profiler_trace()
+        trace = json.loads(text)
+        events = [e for e in trace["traceEvents"] if e["ph"] == "X"]
+        self.assertTrue(events, "empty trace")
+        self.assertTrue(all(e["pid"] == context.rank for e in events))
+        # Times are whole nanoseconds, written as microseconds.
+        times = re.findall(r'"(?:ts|dur)":([^,}]*)', text)
+        self.assertEqual(len(times), 2 * len(events))
+        self.assertTrue(all(re.fullmatch(r"\d+\.\d{3}", t) for t in times))
+        A.profiler_clear()
@@ -183,3 +183,31 @@ class TestPoissonSchedule(unittest.TestCase):
             tstart=0.0 * U.ms, freq=1 * U.kHz, seed=0, tstop=tstop * U.ms
         ).events(0 * U.ms, 100 * U.ms)
         self.assertTrue(max(events) < tstop)
+
+
+class TestPoissonSuperpositionSchedule(unittest.TestCase):
+    def test_single_source(self):
+        ps = A.poisson_schedule(tstart=2.0 * U.ms, freq=0.5 * U.kHz, seed=7)
+        ss = A.poisson_superposition_schedule([ps], seed=7)
+        self.assertEqual(ss.seed, 7)
+        self.assertEqual(len(ss.sources), 1)
+        self.assertEqual(
+            ps.events(0 * U.ms, 100 * U.ms), ss.events(0 * U.ms, 100 * U.ms)
+        )
+
+    def test_summed_rate(self):
+        ps = A.poisson_schedule(freq=0.125 * U.kHz, seed=123)
+        ss = A.poisson_superposition_schedule([ps] * 8, seed=3)
+        expected = A.poisson_schedule(freq=1.0 * U.kHz, seed=3)
+        self.assertEqual(
+            expected.events(0 * U.ms, 50 * U.ms), ss.events(0 * U.ms, 50 * U.ms)
+        )
+
+    def test_windows(self):
+        early = A.poisson_schedule(freq=1.0 * U.kHz, tstop=10 * U.ms)
+        late = A.poisson_schedule(tstart=20 * U.ms, freq=1.0 * U.kHz, tstop=30 * U.ms)
+        events = A.poisson_superposition_schedule([early, late]).events(
+            0 * U.ms, 100 * U.ms
+        )
+        self.assertTrue(events)
+        self.assertTrue(all(t < 10 or 20 <= t < 30 for t in events))
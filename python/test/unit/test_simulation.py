@@ -1,6 +1,7 @@
 import arbor as A
 from arbor import units as U
 import unittest
+import numpy as np
 
 from .. import fixtures
 
@@ -49,6 +50,77 @@ class DelayRecipe(A.recipe):
         return A.neuron_cable_properties()
 
 
+class RingRecipe(A.recipe):
+    """
+    A ring of LIF cells, connected per cell or by range of cells.
+    """
+
+    def __init__(self, ncells, by_range):
+        A.recipe.__init__(self)
+        self.ncells = ncells
+        self.by_range = by_range
+        self.ranges = []
+
+    def num_cells(self):
+        return self.ncells
+
+    def cell_kind(self, _):
+        return A.cell_kind.lif
+
+    def cell_description(self, _):
+        return A.lif_cell("src", "tgt")
+
+    def event_generators(self, gid):
+        if gid == 0:
+            return [A.event_generator("tgt", 1000, A.explicit_schedule([1 * U.ms]))]
+        return []
+
+    def connections_on(self, gid):
+        if self.by_range:
+            return []
+        src = (gid - 1) % self.ncells
+        return [A.connection((src, "src"), "tgt", 1000, 2 * U.ms)]
+
+    def connections_on_range(self, begin, end):
+        if not self.by_range:
+            return None
+        self.ranges.append((begin, end))
+        tgt = np.arange(begin, end)
+        n = len(tgt)
+        return A.connection_block(
+            tgt, (tgt - 1) % self.ncells, "src", "tgt", np.full(n, 1000.0), np.full(n, 2.0)
+        )
+
+
+class TestConnectionBlock(unittest.TestCase):
+    def test_block(self):
+        b = A.connection_block(
+            [1, 2], [0, 1], [0, 1], "syn", [0.5, 0.5], [1.0, 2.0], labels=["a", "b"]
+        )
+        self.assertEqual(2, b.size)
+        self.assertEqual(2, len(b))
+        self.assertRaises(
+            RuntimeError, A.connection_block, [1, 2], [0], "a", "b", [1, 1], [1, 1]
+        )
+        self.assertRaises(
+            RuntimeError, A.connection_block, [1], [0], "a", "b", [1], [0]
+        )
+
+    @fixtures.single_context()
+    def test_ring(self, single_context):
+        spikes = []
+        for by_range in [False, True]:
+            rec = RingRecipe(10, by_range)
+            sim = A.simulation(rec, single_context)
+            sim.record(A.spike_recording.all)
+            sim.run(50 * U.ms, 0.025 * U.ms)
+            spikes.append(sim.spikes().tolist())
+        self.assertGreater(len(spikes[0]), 10)
+        self.assertEqual(spikes[0], spikes[1])
+        # All cells are local: one range covers them.
+        self.assertEqual([(0, 10)], rec.ranges)
+
+
 class TestDelayNetwork(unittest.TestCase):
     @fixtures.single_context()
     def test_zero_delay(self, single_context):
@@ -81,3 +153,36 @@ class TestDelayNetwork(unittest.TestCase):
         self.assertRaises(ValueError, sim.run, 1.0 / 0.0 * U.ms, dt)
         if A.config()["profiling"]:
             A.profiler_clear()
+
+    @fixtures.single_context()
+    def test_epoch_metrics(self, single_context):
+        rec = DelayRecipe(1 * U.ms)
+        sim = A.simulation(rec, single_context)
+        sim.run(2 * U.ms, 0.025 * U.ms)
+        metrics = sim.epoch_metrics()
+        self.assertEqual([m.id for m in metrics], [0, 1, 2, 3])
+        self.assertEqual([m.t0 for m in metrics], [0.0, 0.5, 1.0, 1.5])
+        for m in metrics:
+            self.assertLessEqual(m.advance_mean, m.advance_max)
+            self.assertLessEqual(m.advance_max, m.update)
+            self.assertLessEqual(m.gather, m.exchange)
+            self.assertGreater(m.exchange, 0)
+            self.assertGreater(m.enqueue, 0)
+            self.assertAlmostEqual(m.rank_imbalance, 1.0)
+        sim.reset()
+        self.assertEqual(sim.epoch_metrics(), [])
+
+    @fixtures.single_context()
+    def test_mechanism_counters(self, single_context):
+        rec = DelayRecipe(1 * U.ms)
+        sim = A.simulation(rec, single_context)
+        sim.run(1 * U.ms, 0.025 * U.ms)
+        counters = sim.mechanism_counters()
+        names = sorted(c.name for c in counters)
+        self.assertIn("hh", names)
+        self.assertIn("expsyn", names)
+        for c in counters:
+            if c.name == "hh":
+                self.assertEqual(c.state.calls, 40)
+                self.assertGreater(c.state.time, 0)
+                self.assertAlmostEqual(c.state.mean_time, c.state.time / 40)
@@ -39,3 +39,30 @@ class TestSpikes(unittest.TestCase):
         )
         if A.config()["profiling"]:
             A.profiler_clear()
+
+    @fixtures.single_context()
+    def test_drain_spikes(self, single_context):
+        rec = fixtures.art_spiker_recipe()
+        sim = A.simulation(rec, single_context)
+        sim.record(A.spike_recording.all)
+
+        sim.run(2.5 * U.ms, 0.01 * U.ms)
+        first = sim.drain_spikes()
+        sim.run(5 * U.ms, 0.01 * U.ms)
+        second = sim.drain_spikes()
+
+        self.assertEqual([0.2, 0.4, 0.8, 2.0, 2.0, 2.0, 2.1, 2.2], first["time"].tolist())
+        self.assertEqual([2.8, 3.0, 3.0, 3.1, 4.5], second["time"].tolist())
+        self.assertEqual(0, len(sim.drain_spikes()))
+        self.assertEqual(0, len(sim.spikes()))
+
+    @fixtures.single_context()
+    def test_record_gid_range(self, single_context):
+        rec = fixtures.art_spiker_recipe()
+        sim = A.simulation(rec, single_context)
+        sim.record(A.spike_recording.all, gids=(1, 2))
+        sim.run(5 * U.ms, 0.01 * U.ms)
+
+        spikes = sim.drain_spikes()
+        self.assertEqual([1, 1, 1, 1, 1], spikes["source"]["gid"].tolist())
+        self.assertEqual([0.4, 2.0, 2.2, 3.1, 4.5], spikes["time"].tolist())
@@ -0,0 +1,119 @@
+// Test performance of the state update for mechanisms with non-trivial solvers.
+//
+// Compares the generated advance_state kernels for
+//   * kamt, kdrmt:           cnexp (default catalogue)
+//   * NaV:                   sparse kinetic scheme with 13 states (allen catalogue)
+//   * calcium_based_synapse: stochastic (stochastic catalogue)
+// over a range of CV counts.
+
+#include <any>
+#include <string>
+
+#include <arbor/cable_cell.hpp>
+#include <arbor/mechcat.hpp>
+#include <arbor/morph/segment_tree.hpp>
+#include <arbor/recipe.hpp>
+
+#include "backends/multicore/fvm.hpp"
+#include "benchmark/benchmark.h"
+#include "execution_context.hpp"
+#include "fvm_lowered_cell_impl.hpp"
+
+using namespace arb;
+
+using backend = arb::multicore::backend;
+using fvm_cell = arb::fvm_lowered_cell_impl<backend>;
+
+mechanism_ptr& find_mechanism(const std::string& name, fvm_cell& cell) {
+    auto &mechs = cell.mechanisms();
+    auto it = std::find_if(mechs.begin(),
+                           mechs.end(),
+                           [&](mechanism_ptr& m){return m->internal_name()==name;});
+    if (it==mechs.end()) {
+        std::cerr << "couldn't find mechanism with name " << name << "\n";
+        exit(1);
+    }
+    return *it;
+}
+
+// A single unbranched cable with `num_comp` CVs; density mechanisms are painted
+// everywhere, point mechanisms are placed once per CV.
+class recipe_1_branch: public recipe {
+    std::string mech_;
+    bool point_;
+    unsigned num_comp_;
+    arb::cable_cell_global_properties gprop_;
+
+public:
+    recipe_1_branch(std::string mech, bool point, unsigned num_comp):
+        mech_(std::move(mech)), point_(point), num_comp_(num_comp)
+    {
+        gprop_.default_parameters = arb::neuron_parameter_defaults;
+        gprop_.catalogue.extend(global_allen_catalogue());
+        gprop_.catalogue.extend(global_stochastic_catalogue());
+    }
+
+    cell_size_type num_cells() const override {
+        return 1;
+    }
+
+    virtual util::unique_any get_cell_description(cell_gid_type gid) const override {
+        arb::segment_tree tree;
+
+        double dend_radius = 1.0/2;
+        double dend_length = 1000;
+        tree.append(arb::mnpos, {0, 0, 0, dend_radius}, {0, 0, dend_length, dend_radius}, 3);
+
+        arb::decor decor;
+        decor.paint(arb::reg::all(), arb::density("pas"));
+        if (point_) {
+            for (unsigned i = 0; i<num_comp_; ++i) {
+                decor.place(arb::mlocation{0, (i+0.5)/num_comp_}, arb::synapse(mech_), "syn");
+            }
+        }
+        else {
+            decor.paint(arb::reg::all(), arb::density(mech_));
+        }
+
+        return arb::cable_cell{arb::morphology(tree), decor, {}, arb::cv_policy_fixed_per_branch(num_comp_)};
+    }
+
+    virtual cell_kind get_cell_kind(cell_gid_type) const override {
+        return cell_kind::cable;
+    }
+
+    std::any get_global_properties(arb::cell_kind) const override {
+        return gprop_;
+    }
+};
+
+void advance_state(benchmark::State& state, const std::string& name, bool point) {
+    const unsigned ncomp = state.range(0);
+    recipe_1_branch rec(name, point, ncomp);
+
+    fvm_cell cell((execution_context()));
+    cell.initialize({0}, rec);
+
+    auto& m = find_mechanism(name, cell);
+    m->set_dt(0.025);
+
+    while (state.KeepRunning()) {
+        m->update_state();
+    }
+}
+
+void kamt_state(benchmark::State& state) { advance_state(state, "kamt", false); }
+void kdrmt_state(benchmark::State& state) { advance_state(state, "kdrmt", false); }
+void nav_state(benchmark::State& state) { advance_state(state, "NaV", false); }
+void calcium_based_synapse_state(benchmark::State& state) { advance_state(state, "calcium_based_synapse", true); }
+
+void run_custom_arguments(benchmark::internal::Benchmark* b) {
+    for (auto ncomps: {10, 100, 1000, 10000}) {
+        b->Args({ncomps});
+    }
+}
+BENCHMARK(kamt_state)->Apply(run_custom_arguments);
+BENCHMARK(kdrmt_state)->Apply(run_custom_arguments);
+BENCHMARK(nav_state)->Apply(run_custom_arguments);
+BENCHMARK(calcium_based_synapse_state)->Apply(run_custom_arguments);
+BENCHMARK_MAIN();
@@ -10,17 +10,21 @@
 
 constexpr auto T = 1000.0*arb::units::ms; // ms
 
+// Lanes of Poisson events; if burst > 1, the events come in bursts of that
+// many, 1 µs apart, such that the merge sees runs from the same lane.
 struct payload {
-    payload(std::size_t ncells, std::size_t ev_per_cell) {
-        auto dt = T/ev_per_cell;
+    payload(std::size_t ncells, std::size_t ev_per_cell, std::size_t burst = 1) {
+        auto dt = T/ev_per_cell*burst;
         for(auto cell = 0ull; cell < ncells; ++cell) {
             auto gen = arb::poisson_schedule(1/dt, cell);
             auto times = gen.events(0, T.value_as(arb::units::ms));
             evts.emplace_back();
             auto& evt = evts.back();
             for (auto t: arb::util::make_range(times)) {
-                evt.emplace_back(42, t, 0.23);
-                ++size;
+                for (auto i = 0ull; i < burst; ++i) {
+                    evt.emplace_back(42, t + 1e-3*i, 0.23);
+                    ++size;
+                }
             }
             span.emplace_back(arb::util::make_range(evt.data(), evt.data() + evt.size()));
         }
@@ -34,8 +38,9 @@ struct payload {
 static void BM_tree(benchmark::State& state) {
     const std::size_t ncells = state.range(0);
     const std::size_t ev_per_cell = state.range(1);
+    const std::size_t burst = state.range(2);
 
-    const payload data{ncells, ev_per_cell};
+    const payload data{ncells, ev_per_cell, burst};
 
     while (state.KeepRunning()) {
         arb::pse_vector out;
@@ -50,8 +55,9 @@ static void BM_tree(benchmark::State& state) {
 static void BM_linear(benchmark::State& state) {
     const std::size_t ncells = state.range(0);
     const std::size_t ev_per_cell = state.range(1);
+    const std::size_t burst = state.range(2);
 
-    const payload data{ncells, ev_per_cell};
+    const payload data{ncells, ev_per_cell, burst};
 
     while (state.KeepRunning()) {
         arb::pse_vector out;
@@ -67,8 +73,9 @@ static void BM_linear(benchmark::State& state) {
 static void BM_queue(benchmark::State& state) {
     const std::size_t ncells = state.range(0);
     const std::size_t ev_per_cell = state.range(1);
+    const std::size_t burst = state.range(2);
 
-    const payload data{ncells, ev_per_cell};
+    const payload data{ncells, ev_per_cell, burst};
 
     while (state.KeepRunning()) {
         arb::pse_vector out;
@@ -84,8 +91,9 @@ static void BM_queue(benchmark::State& state) {
 static void BM_default(benchmark::State& state) {
     const std::size_t ncells = state.range(0);
     const std::size_t ev_per_cell = state.range(1);
+    const std::size_t burst = state.range(2);
 
-    const payload data{ncells, ev_per_cell};
+    const payload data{ncells, ev_per_cell, burst};
 
     while (state.KeepRunning()) {
         arb::pse_vector out;
@@ -98,9 +106,11 @@ static void BM_default(benchmark::State& state) {
 }
 
 void run_custom_arguments(benchmark::internal::Benchmark* b) {
-    for (auto ncells: {5, 13, 23, 41, 53}) {
+    for (auto ncells: {2, 5, 8, 13, 23, 41, 53, 256, 1024}) {
         for (auto ev_per_cell: {8, 32, 256, 1024}) {
-            b->Args({ncells, ev_per_cell});
+            for (auto burst: {1, 16}) {
+                b->Args({ncells, ev_per_cell, burst});
+            }
         }
     }
 }
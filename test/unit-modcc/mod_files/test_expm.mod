@@ -0,0 +1,35 @@
+: Voltage dependent kinetic scheme with a COMPARTMENT statement, solved by
+: the matrix exponential.
+
+NEURON {
+    SUFFIX test_expm
+}
+
+PARAMETER {
+    vhalf = -40 (mV)
+}
+
+STATE {
+    c o i
+}
+
+BREAKPOINT {
+    SOLVE states METHOD expm
+}
+
+KINETIC states {
+    LOCAL a, b
+    a = exp((v - vhalf)/10)
+    b = exp(-(v - vhalf)/10)
+
+    COMPARTMENT 2 {i}
+    ~ c <-> o (a, b)
+    ~ o <-> i (0.5, 0.1)
+    CONSERVE c + o + i = 1
+}
+
+INITIAL {
+    c = 1
+    o = 0
+    i = 0
+}
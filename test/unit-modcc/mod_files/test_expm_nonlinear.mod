@@ -0,0 +1,18 @@
+: The expm method requires a homogeneous linear system.
+
+NEURON {
+    SUFFIX test_expm_nonlinear
+}
+
+STATE {
+    a b
+}
+
+BREAKPOINT {
+    SOLVE states METHOD expm
+}
+
+DERIVATIVE states {
+    a' = -a*b
+    b' = a - 1
+}
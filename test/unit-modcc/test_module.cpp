@@ -266,3 +266,22 @@ TEST(Module, reaction_under_conditional) {
 
     EXPECT_FALSE(m.semantic());
 }
+
+TEST(Module, expm_solver) {
+    {
+        Module m(io::read_all(DATADIR "/mod_files/test_expm.mod"), "test_expm.mod");
+        EXPECT_NE(m.buffer().size(), 0u);
+
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        EXPECT_TRUE(m.semantic());
+    }
+    {
+        Module m(io::read_all(DATADIR "/mod_files/test_expm_nonlinear.mod"), "test_expm_nonlinear.mod");
+        EXPECT_NE(m.buffer().size(), 0u);
+
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        EXPECT_FALSE(m.semantic());
+    }
+}
@@ -176,3 +176,59 @@ TEST(symge, gj_reduce_3x3) {
     EXPECT_NEAR(y, 7.0/4.0, 1e-6);
     EXPECT_NEAR(z, 39.0/20.0, 1e-6);
 }
+
+TEST(symge, elimination_order_arrow) {
+    // Arrow matrix: dense first row and column, otherwise diagonal.
+    //
+    // | x x x x |
+    // | x x 0 0 |
+    // | x 0 x 0 |
+    // | x 0 0 x |
+    //
+    // Eliminating row 0 first would fill in the whole matrix; a fill-free
+    // order starts with one of the leaves.
+
+    symbol_table tbl;
+    sym_matrix A(4, 4);
+    A[0] = sym_row({{0, tbl.define()}, {1, tbl.define()}, {2, tbl.define()}, {3, tbl.define()}});
+    for (unsigned i = 1; i<4; ++i) {
+        A[i] = sym_row({{0, tbl.define()}, {i, tbl.define()}});
+    }
+
+    auto order = elimination_order(A);
+    ASSERT_EQ(4u, order.size());
+    for (auto p: order) EXPECT_EQ(p.row, p.col);
+    EXPECT_NE(0u, order.front().row);
+}
+
+TEST(symge, elimination_order_off_diagonal) {
+    // Row 1 has no diagonal entry; every row and column must still be used once.
+    //
+    // | x x 0 |
+    // | x 0 x |
+    // | 0 x x |
+
+    symbol_table tbl;
+    sym_matrix A(3, 3);
+    A[0] = sym_row({{0, tbl.define()}, {1, tbl.define()}});
+    A[1] = sym_row({{0, tbl.define()}, {2, tbl.define()}});
+    A[2] = sym_row({{1, tbl.define()}, {2, tbl.define()}});
+
+    auto order = elimination_order(A);
+    ASSERT_EQ(3u, order.size());
+
+    std::vector<bool> rows(3), cols(3);
+    for (auto p: order) {
+        EXPECT_FALSE(rows[p.row]);
+        EXPECT_FALSE(cols[p.col]);
+        rows[p.row] = cols[p.col] = true;
+    }
+}
+
+TEST(symge, elimination_order_singular) {
+    symbol_table tbl;
+    sym_matrix A(2, 2);
+    A[0] = sym_row({{0, tbl.define()}, {1, tbl.define()}});
+
+    EXPECT_THROW(elimination_order(A), std::runtime_error);
+}
@@ -76,3 +76,75 @@ TEST(cable_cell, lid_ranges) {
     EXPECT_EQ(r6_0->second.begin, 4u); EXPECT_EQ(r6_0->second.end, 7u);
     EXPECT_EQ(r6_1->second.begin, 7u); EXPECT_EQ(r6_1->second.end, 9u);
 }
+
+TEST(cable_cell, shared_description) {
+    segment_tree tree;
+    tree.append(mnpos, {0, 0, 0, 10}, {0, 0, 10, 10}, 1);
+    tree.append(0,     {0, 0, 10, 1}, {0, 0, 100, 1}, 3);
+
+    label_dict dict;
+    dict.set("term", "(terminal)"_ls);
+    dict.set("dend", "(tag 3)"_reg);
+
+    decor decorations;
+    decorations.paint("dend"_lab, density("pas"));
+    decorations.place("term"_lab, synapse("expsyn"), "syn");
+    decorations.set_default(temperature{300*arb::units::Kelvin});
+
+    cable_cell tmpl(arb::morphology(tree), decorations, dict);
+
+    // Copies share the description until modified.
+    cable_cell copy = tmpl;
+    EXPECT_EQ(&tmpl.provider(), &copy.provider());
+    EXPECT_EQ(&tmpl.decorations(), &copy.decorations());
+    copy.discretization(cv_policy_fixed_per_branch(3));
+    EXPECT_NE(&tmpl.decorations(), &copy.decorations());
+    EXPECT_EQ(&tmpl.provider(), &copy.provider());
+    EXPECT_FALSE(tmpl.discretization());
+    EXPECT_TRUE(copy.discretization());
+
+    // Derived cells add to the decorations of the template, sharing its labels.
+    decor delta;
+    delta.place(mlocation{0, 0.5}, synapse("exp2syn"), "extra");
+    delta.place("term"_lab, synapse("expsyn"), "more");
+    delta.set_default(temperature{310*arb::units::Kelvin});
+    cable_cell derived(tmpl, delta);
+
+    EXPECT_EQ(&tmpl.provider(), &derived.provider());
+    EXPECT_EQ(1u, tmpl.synapses().size());
+    EXPECT_EQ(1u, tmpl.synapses().at("expsyn").size());
+    EXPECT_EQ(2u, derived.synapses().at("expsyn").size());
+    EXPECT_EQ(1u, derived.synapses().at("exp2syn").size());
+    EXPECT_EQ(300., tmpl.default_parameters().temperature_K.value());
+    EXPECT_EQ(310., derived.default_parameters().temperature_K.value());
+    EXPECT_EQ(1u, derived.densities().size());
+
+    // Equivalent to a cell built from the combined decorations.
+    decor combined = decorations;
+    combined.place(mlocation{0, 0.5}, synapse("exp2syn"), "extra");
+    combined.place("term"_lab, synapse("expsyn"), "more");
+    combined.set_default(temperature{310*arb::units::Kelvin});
+    cable_cell expected(arb::morphology(tree), combined, dict);
+
+    for (const auto& [name, placements]: expected.synapses()) {
+        const auto& other = derived.synapses().at(name);
+        ASSERT_EQ(placements.size(), other.size());
+        for (std::size_t i = 0; i<placements.size(); ++i) {
+            EXPECT_EQ(placements[i].loc, other[i].loc);
+            EXPECT_EQ(placements[i].lid, other[i].lid);
+            EXPECT_EQ(placements[i].tag, other[i].tag);
+        }
+    }
+    for (const auto& label: {"syn", "extra", "more"}) {
+        auto r = expected.synapse_ranges().equal_range(hash_value(label)).first->second;
+        auto s = derived.synapse_ranges().equal_range(hash_value(label)).first->second;
+        EXPECT_EQ(r.begin, s.begin);
+        EXPECT_EQ(r.end, s.end);
+    }
+    EXPECT_EQ("more", derived.decorations().tag_of(hash_value("more")));
+
+    // Overpainting a property of the template is an error.
+    decor overpaint;
+    overpaint.paint("dend"_lab, density("pas"));
+    EXPECT_THROW((cable_cell{tmpl, overpaint}), cable_cell_error);
+}
@@ -105,3 +105,72 @@ TEST(cable_cell_group, sources) {
     }
 }
 
+
+TEST(cable_cell_group, adaptive_timestep_bounds) {
+    adaptive_timestep_parameters p;
+    p.dt_min = 0.01;
+    p.growth = 2;
+
+    // Without breaks, steps grow geometrically up to the bound; the sliver at
+    // the end of the epoch is absorbed by the last step.
+    {
+        time_type h = 0;
+        auto b = adaptive_timestep_bounds(epoch(0, 0., 0.3), h, 0.1, {}, {}, p);
+        std::vector<time_type> expected = {0., 0.01, 0.03, 0.07, 0.15, 0.25, 0.3};
+        ASSERT_EQ(expected.size(), b.size());
+        for (unsigned i = 0; i<b.size(); ++i) EXPECT_NEAR(expected[i], b[i], 1e-12);
+        EXPECT_EQ(0.1, h);
+    }
+    // Steps are split at sample times, and restart at dt_min after events.
+    {
+        time_type h = 0.1;
+        auto b = adaptive_timestep_bounds(epoch(0, 1., 1.5), h, 0.1, {1.2}, {1.05}, p);
+        std::vector<time_type> expected = {1., 1.05, 1.15, 1.2, 1.21, 1.23, 1.27, 1.35, 1.45, 1.5};
+        ASSERT_EQ(expected.size(), b.size());
+        for (unsigned i = 0; i<b.size(); ++i) EXPECT_NEAR(expected[i], b[i], 1e-12);
+    }
+}
+
+TEST(cable_cell_group, adaptive_timestep) {
+    struct adaptive_recipe: cable1d_recipe {
+        adaptive_recipe(const cable_cell& c, std::optional<adaptive_timestep_parameters> p):
+            cable1d_recipe(c)
+        {
+            cell_gprop_.adaptive_timestep = p;
+            nernst_ion("na");
+            nernst_ion("ca");
+            nernst_ion("k");
+        }
+    };
+
+    auto run = [](std::optional<adaptive_timestep_parameters> p, time_type dt, time_type t_epoch = 1) {
+        cable_cell cell = make_cell();
+        cell_label_range srcs, tgts;
+        cable_cell_group group{{0}, adaptive_recipe(cell, p), srcs, tgts, lowered_cell()};
+        for (unsigned i = 0; i*t_epoch<50; ++i) {
+            group.advance(epoch(i, i*t_epoch, (i+1)*t_epoch), dt, {});
+        }
+        return group.spikes();
+    };
+
+    auto reference = run(std::nullopt, 0.01);
+    ASSERT_EQ(4u, reference.size());
+
+    // With a generous upper bound on dt, the adaptive scheme recovers the
+    // spike train of the fine fixed-step solution.
+    adaptive_timestep_parameters p;
+    p.dv_max = 0.1;
+    auto adaptive = run(p, 0.5);
+    ASSERT_EQ(reference.size(), adaptive.size());
+    for (unsigned i = 0; i<reference.size(); ++i) {
+        EXPECT_NEAR(reference[i].time, adaptive[i].time, 0.15);
+    }
+
+    // With a single epoch, the steps grow to dt during the quiet stimulus onset
+    // and must be planned again within the epoch for each spike.
+    auto single_epoch = run(p, 0.5, 50);
+    ASSERT_EQ(reference.size(), single_epoch.size());
+    for (unsigned i = 0; i<reference.size(); ++i) {
+        EXPECT_NEAR(reference[i].time, single_epoch[i].time, 0.15);
+    }
+}
@@ -1,3 +1,5 @@
+#include <cmath>
+#include <stdexcept>
 #include <vector>
 
 #include <arbor/cable_cell.hpp>
@@ -368,3 +370,63 @@ TEST(cv_policy, combinators) {
             pol12|pol23));
     }
 }
+
+TEST(cv_policy, d_lambda) {
+    using enum cv_policy_flag;
+    namespace U = arb::units;
+
+    // A cable of 1000 µm length and 2 µm diameter.
+    segment_tree tree;
+    tree.append(mnpos, {0, 0, 0, 1}, {1000, 0, 0, 1}, 1);
+    morphology m(tree);
+
+    auto num_cv = [](const cable_cell& cell, const cv_policy& pol) {
+        return thingify(pol.cv_boundary_points(cell), cell.provider()).size()-1;
+    };
+
+    // With Ra = 100 Ω·cm and cm = 1 µF/cm², the length constant at 100 Hz is
+    // 1e5·√(2/(4π·100·100·1)) µm = 398.9 µm, for 2.507 length constants in total.
+    decor d;
+    d.set_default(axial_resistivity{100*U::Ohm*U::cm});
+    d.set_default(membrane_capacitance{0.01*U::F/U::m2});
+    {
+        cable_cell cell(m, d);
+        EXPECT_EQ(25u, num_cv(cell, cv_policy_d_lambda(100, 0.1)));
+        EXPECT_EQ(5u, num_cv(cell, cv_policy_d_lambda(100, 0.5)));
+        // Length constants scale with 1/√f.
+        EXPECT_EQ(51u, num_cv(cell, cv_policy_d_lambda(400, 0.1)));
+        EXPECT_EQ(1u, num_cv(cell, cv_policy_d_lambda(100, 10)));
+        // Interior forks split terminal CVs.
+        EXPECT_EQ(26u, num_cv(cell, cv_policy_d_lambda(100, 0.1, interior_forks)));
+    }
+
+    // Painted values take precedence over defaults: quadrupling Ra halves
+    // the length constant.
+    {
+        auto p = d;
+        p.paint(reg::all(), axial_resistivity{400*U::Ohm*U::cm});
+        cable_cell cell(m, p);
+        EXPECT_EQ(51u, num_cv(cell, cv_policy_d_lambda(100, 0.1)));
+    }
+    // On half the cable, only that half contributes twice.
+    {
+        auto p = d;
+        p.paint(reg::cable(0, 0, 0.5), membrane_capacitance{0.04*U::F/U::m2});
+        cable_cell cell(m, p);
+        EXPECT_EQ(39u, num_cv(cell, cv_policy_d_lambda(100, 0.1)));
+    }
+
+    // Restricted to a domain, boundaries are those of the domain outside.
+    {
+        cable_cell cell(m, d);
+        auto pol = cv_policy_d_lambda(100, 0.1, reg::cable(0, 0, 0.5));
+        EXPECT_EQ(13u, num_cv(cell, pol));
+    }
+
+    // Frequency and fraction must be positive and finite.
+    EXPECT_THROW(cv_policy_d_lambda(0, 0.1), std::domain_error);
+    EXPECT_THROW(cv_policy_d_lambda(-100, 0.1), std::domain_error);
+    EXPECT_THROW(cv_policy_d_lambda(100, 0), std::domain_error);
+    EXPECT_THROW(cv_policy_d_lambda(100, INFINITY, reg::all()), std::domain_error);
+    EXPECT_THROW(cv_policy_d_lambda(NAN, 0.1), std::domain_error);
+}
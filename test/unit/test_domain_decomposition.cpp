@@ -158,6 +158,10 @@ struct dummy_context {
     gathered_vector<spike> gather_spikes(const std::vector<spike>&) const { throw unimplemented{__FUNCTION__}; }
     std::vector<spike> remote_gather_spikes(const std::vector<spike>&) const { throw unimplemented{__FUNCTION__}; }
     gathered_vector<cell_gid_type> gather_gids(const std::vector<cell_gid_type>& local_gids) const { throw unimplemented{__FUNCTION__}; }
+    gathered_vector<arb_value_type> gather_values(const std::vector<arb_value_type>& local_values) const { throw unimplemented{__FUNCTION__}; }
+    gathered_vector<cell_member_type> gather_cell_members(const std::vector<cell_member_type>& local_members) const { throw unimplemented{__FUNCTION__}; }
+    std::vector<arb_value_type> max_values(const std::vector<arb_value_type>& local_values) const { throw unimplemented{__FUNCTION__}; }
+    std::vector<arb_value_type> sum_values(const std::vector<arb_value_type>& local_values) const { throw unimplemented{__FUNCTION__}; }
     void remote_ctrl_send_continue(const epoch&) const {}
     void remote_ctrl_send_done() const {}
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const { throw unimplemented{__FUNCTION__}; }
@@ -569,6 +573,58 @@ TEST(domain_decomposition, partition_by_groups) {
     }
 }
 
+TEST(domain_decomposition, gid_maps) {
+    // Three dry run ranks with the same local layout, offset by 8 gids each.
+    const unsigned nranks = 3, ncells_per_rank = 8;
+    auto ctx = std::make_shared<execution_context>();
+    ctx->distributed = make_dry_run_context(nranks, ncells_per_rank);
+    auto rec = homo_recipe(nranks*ncells_per_rank, dummy_cell{});
+
+    {
+        // Contiguous blocks per rank.
+        std::vector<cell_gid_type> gids(ncells_per_rank);
+        std::iota(gids.begin(), gids.end(), 0);
+        auto d = domain_decomposition(rec, ctx, {{cell_kind::cable, gids, backend_kind::multicore}});
+
+        for (unsigned gid = 0; gid < nranks*ncells_per_rank; ++gid) {
+            EXPECT_EQ(int(gid/ncells_per_rank), d.gid_domain(gid));
+            EXPECT_EQ(gid%ncells_per_rank, d.index_on_domain(gid));
+        }
+    }
+    {
+        // Gids out of order within each rank.
+        auto d = domain_decomposition(rec, ctx, {{cell_kind::cable, {0, 1, 2}, backend_kind::multicore},
+                                                 {cell_kind::cable, {6, 7}, backend_kind::multicore},
+                                                 {cell_kind::cable, {3, 5, 4}, backend_kind::multicore}});
+
+        std::vector<cell_size_type> index = {0, 1, 2, 5, 7, 6, 3, 4};
+        for (unsigned gid = 0; gid < nranks*ncells_per_rank; ++gid) {
+            EXPECT_EQ(int(gid/ncells_per_rank), d.gid_domain(gid));
+            EXPECT_EQ(index[gid%ncells_per_rank], d.index_on_domain(gid));
+        }
+    }
+}
+
+TEST(domain_decomposition, properties) {
+    // Two dry run ranks, the local one holding the first 10 cells.
+    const unsigned nranks = 2, ncells_per_rank = 10;
+    auto ctx = std::make_shared<execution_context>();
+    ctx->distributed = make_dry_run_context(nranks, ncells_per_rank);
+    auto rec = homo_recipe(nranks*ncells_per_rank, dummy_cell{});
+
+    auto D = partition_load_balance(rec, ctx);
+    EXPECT_EQ(2, D->num_domains());
+    EXPECT_EQ(0, D->domain_id());
+    EXPECT_EQ(ncells_per_rank, D->num_local_cells());
+    EXPECT_EQ(nranks*ncells_per_rank, D->num_global_cells());
+    EXPECT_LT(0u, D->num_groups());
+    EXPECT_EQ(D->groups().size(), D->num_groups());
+
+    cell_size_type n = 0;
+    for (const auto& g: D->groups()) n += g.gids.size();
+    EXPECT_EQ(ncells_per_rank, n);
+}
+
 TEST(domain_decomposition, invalid) {
     proc_allocation resources;
     resources.num_threads = 1;
@@ -56,6 +56,15 @@ TEST(dry_run_context, sum)
     EXPECT_EQ(unsigned(42 * num_ranks), ctx->sum(42u));
 }
 
+TEST(dry_run_context, reduce_values)
+{
+    distributed_context_handle ctx = arb::make_dry_run_context(num_ranks, num_cells_per_rank);
+    std::vector<double> values = {1., 2.5, 42.};
+
+    EXPECT_EQ(values, ctx->max_values(values));
+    EXPECT_EQ((std::vector<double>{1.*num_ranks, 2.5*num_ranks, 42.*num_ranks}), ctx->sum_values(values));
+}
+
 TEST(dry_run_context, gather_spikes)
 {
     distributed_context_handle ctx = arb::make_dry_run_context(4, 4);
@@ -98,6 +107,26 @@ TEST(dry_run_context, gather_spikes)
     EXPECT_EQ(part[4], spikes.size()*4);
 }
 
+TEST(dry_run_context, gather_cell_members)
+{
+    distributed_context_handle ctx = arb::make_dry_run_context(3, 4);
+    using mvec = std::vector<arb::cell_member_type>;
+
+    // Only the gids are offset per rank.
+    mvec members = {{0, 1}, {3, 7}};
+    mvec gathered_members = {{0, 1}, {3, 7}, {4, 1}, {7, 7}, {8, 1}, {11, 7}};
+
+    auto s = ctx->gather_cell_members(members);
+    auto& part = s.partition();
+
+    EXPECT_EQ(s.values(), gathered_members);
+    EXPECT_EQ(part.size(), 4u);
+    EXPECT_EQ(part[0], 0u);
+    EXPECT_EQ(part[1], members.size());
+    EXPECT_EQ(part[2], members.size()*2);
+    EXPECT_EQ(part[3], members.size()*3);
+}
+
 TEST(dry_run_context, gather_gids)
 {
     distributed_context_handle ctx = arb::make_dry_run_context(4, 4);
@@ -142,3 +142,29 @@ TEST(event_generators, poisson) {
     EXPECT_EQ(int1, int2);
 }
 
+
+TEST(event_generators, poisson_superposition) {
+    // n sources of the same rate draw the events of one of n times the rate.
+    cell_lid_type lid = 1;
+    float weight = 0.5;
+    auto t0 = 2*arb::units::ms;
+    auto t1 = 8*arb::units::ms;
+
+    event_generator gen = poisson_superposition_generator({"syn"}, weight, 1000, t0, 0.01*arb::units::kHz, 11, t1);
+    event_generator ref = poisson_generator({"syn"}, weight, t0, 10*arb::units::kHz, 11, t1);
+    gen.set_target_lid(lid);
+    ref.set_target_lid(lid);
+
+    pse_vector events = as_vector(gen.events(0, 10));
+    EXPECT_EQ(as_vector(ref.events(0, 10)), events);
+    EXPECT_FALSE(events.empty());
+    for (const auto& e: events) {
+        EXPECT_EQ(lid, e.target);
+        EXPECT_EQ(weight, e.weight);
+        EXPECT_LE(2., e.time);
+        EXPECT_GT(8., e.time);
+    }
+
+    gen.reset();
+    EXPECT_EQ(events, as_vector(gen.events(0, 10)));
+}
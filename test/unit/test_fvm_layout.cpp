@@ -301,6 +301,78 @@ TEST(fvm_layout, mech_index) {
     EXPECT_EQ(ivec({0,6}), M.ions.at("k"s).cv);
 }
 
+TEST(fvm_layout, shared_layout) {
+    auto system = two_cell_system();
+    auto& descriptions = system.descriptions;
+    auto& builders = system.builders;
+
+    descriptions[0].decorations.place(builders[0].location({1, 0.4}), synapse("expsyn"), "syn0");
+    descriptions[1].decorations.place(builders[1].location({3, 0.4}), synapse("expsyn"), "syn1");
+
+    // Cells 0, 2 and 1, 3 are identical, cell 4 differs from cell 0 by one synapse.
+    auto pair = system.cells();
+    auto extra = descriptions[0];
+    extra.decorations.place(builders[0].location({1, 0.6}), synapse("exp2syn"), "syn2");
+    std::vector<cable_cell> cells = {pair[0], pair[1], pair[0], pair[1], cable_cell(extra)};
+
+    EXPECT_EQ(fvm_layout_signature(cells[0]), fvm_layout_signature(cable_cell(descriptions[0])));
+    EXPECT_NE(fvm_layout_signature(cells[0]), fvm_layout_signature(cells[1]));
+    EXPECT_NE(fvm_layout_signature(cells[0]), fvm_layout_signature(cells[4]));
+
+    // Locations that differ only past the default printing precision.
+    auto near = descriptions[0];
+    near.decorations.place(mlocation{1, 0.6}, synapse("exp2syn"), "syn2");
+    auto nearer = descriptions[0];
+    nearer.decorations.place(mlocation{1, 0.6+1e-7}, synapse("exp2syn"), "syn2");
+    EXPECT_NE(fvm_layout_signature(cable_cell(near)), fvm_layout_signature(cable_cell(nearer)));
+
+    cable_cell_global_properties gprop;
+    gprop.default_parameters = neuron_parameter_defaults;
+
+    fvm_cv_discretization D = fvm_cv_discretize(cells, gprop.default_parameters);
+    EXPECT_EQ((std::vector<arb_size_type>{0, 1, 0, 1, 4}), D.cell_layout_source);
+
+    // Discretization must match that of the cells built one by one.
+    fvm_cv_discretization R;
+    for (const auto& c: cells) append(R, fvm_cv_discretize(c, gprop.default_parameters));
+    EXPECT_TRUE(R.cell_layout_source.empty());
+    EXPECT_EQ(R.geometry.cv_parent, D.geometry.cv_parent);
+    EXPECT_EQ(R.geometry.cell_cv_divs, D.geometry.cell_cv_divs);
+    EXPECT_EQ(R.cv_area, D.cv_area);
+    EXPECT_EQ(R.face_conductance, D.face_conductance);
+    EXPECT_EQ(R.cv_capacitance, D.cv_capacitance);
+
+    // Mechanism data must match that built without sharing.
+    std::vector<cell_gid_type> gids = {0, 1, 2, 3, 4};
+    std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>> gj_conns;
+    for (auto gid: gids) gj_conns[gid] = {};
+
+    fvm_mechanism_data M = fvm_build_mechanism_data(gprop, cells, gids, gj_conns, D);
+    fvm_mechanism_data N = fvm_build_mechanism_data(gprop, cells, gids, gj_conns, R);
+
+    ASSERT_EQ(N.mechanisms.size(), M.mechanisms.size());
+    for (const auto& [name, config]: N.mechanisms) {
+        SCOPED_TRACE(name);
+        ASSERT_EQ(1u, M.mechanisms.count(name));
+        const auto& shared = M.mechanisms.at(name);
+        EXPECT_EQ(config.cv, shared.cv);
+        EXPECT_EQ(config.norm_area, shared.norm_area);
+        EXPECT_EQ(config.multiplicity, shared.multiplicity);
+        EXPECT_EQ(config.target, shared.target);
+        EXPECT_EQ(config.param_values, shared.param_values);
+    }
+    ASSERT_EQ(N.ions.size(), M.ions.size());
+    for (const auto& [ion, config]: N.ions) {
+        SCOPED_TRACE(ion);
+        EXPECT_EQ(config.cv, M.ions.at(ion).cv);
+        EXPECT_EQ(config.init_iconc, M.ions.at(ion).init_iconc);
+    }
+    EXPECT_EQ(N.stimuli.cv, M.stimuli.cv);
+    EXPECT_EQ(N.stimuli.cv_unique, M.stimuli.cv_unique);
+    EXPECT_EQ(N.stimuli.envelope_amplitude, M.stimuli.envelope_amplitude);
+    EXPECT_EQ(N.target_divs, M.target_divs);
+}
+
 struct exp_instance {
     int cv;
     int multiplicity;
@@ -1987,3 +2059,55 @@ TEST(fvm_layout, inhomogeneous_parameters) {
     }
 }
 
+
+TEST(fvm_layout, parameter_scaling) {
+    auto tree = segment_tree{};
+    auto parn = tree.append(mnpos, {0., 0., 0., 1.0}, {10., 0., 0., 1.0}, 1);
+    tree.append(parn, {10., 0., 0., 0.5}, {10., 20., 0., 0.5}, 3);
+
+    auto decor = arb::decor{}
+        .paint(reg::tagged(1), density("pas", {{"g", 0.002}}))
+        .paint(reg::tagged(3), scaled_mechanism<density>(density("pas", {{"g", 0.002}})).scale("g", iexpr::diameter()));
+    cable_cell tmpl(morphology{tree}, decor, {}, cv_policy_fixed_per_branch(4));
+
+    // Factors apply on top of the painted values and scale expressions, and
+    // compose with those of the template.
+    cable_cell twice(tmpl, {}, {{"pas", {{"g", 2.}}}});
+    cable_cell thrice(twice, {}, {{"pas", {{"g", 1.5}, {"e", 1.}}}});
+    EXPECT_EQ(0u, tmpl.parameter_scales().size());
+    EXPECT_EQ(2., twice.parameter_scales().at("pas").at("g"));
+    EXPECT_EQ(3., thrice.parameter_scales().at("pas").at("g"));
+    EXPECT_EQ(&tmpl.provider(), &thrice.provider());
+
+    std::vector<cable_cell> cells = {tmpl, twice, thrice, twice};
+    EXPECT_NE(fvm_layout_signature(tmpl), fvm_layout_signature(twice));
+    EXPECT_NE(fvm_layout_signature(twice), fvm_layout_signature(thrice));
+
+    cable_cell_global_properties gprop;
+    gprop.default_parameters = neuron_parameter_defaults;
+    std::vector<cell_gid_type> gids = {0, 1, 2, 3};
+    std::unordered_map<cell_gid_type, std::vector<fvm_gap_junction>> gj_conns;
+    for (auto gid: gids) gj_conns[gid] = {};
+
+    fvm_cv_discretization D = fvm_cv_discretize(cells, gprop.default_parameters);
+    EXPECT_EQ((std::vector<arb_size_type>{0, 1, 2, 1}), D.cell_layout_source);
+    fvm_mechanism_data M = fvm_build_mechanism_data(gprop, cells, gids, gj_conns, D);
+
+    const auto& pas = M.mechanisms.at("pas");
+    const auto& g = *ptr_by_key(pas.param_values, "g"s);
+    const auto& e = *ptr_by_key(pas.param_values, "e"s);
+    const auto n = g.size()/cells.size();
+    ASSERT_EQ(n*cells.size(), g.size());
+    for (unsigned i = 0; i<n; ++i) {
+        EXPECT_DOUBLE_EQ(2*g[i], g[n + i]);
+        EXPECT_DOUBLE_EQ(3*g[i], g[2*n + i]);
+        EXPECT_DOUBLE_EQ(2*g[i], g[3*n + i]);
+        EXPECT_EQ(e[i], e[2*n + i]);
+    }
+
+    // Scaling mechanisms that are not painted, or parameters they do not have, is an error.
+    EXPECT_THROW((cable_cell{tmpl, {}, {{"hh", {{"gnabar", 2.}}}}}), cable_cell_error);
+    EXPECT_THROW((cable_cell{tmpl, {}, {{"pas", {{"g", std::numeric_limits<double>::quiet_NaN()}}}}}), cable_cell_error);
+    std::vector<cable_cell> bad = {cable_cell(tmpl, {}, {{"pas", {{"gbar", 2.}}}})};
+    EXPECT_THROW(fvm_build_mechanism_data(gprop, bad, {0}, gj_conns, fvm_cv_discretize(bad, gprop.default_parameters)), cable_cell_error);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../common_cells.hpp"
 #include "fvm_layout.hpp"
+#include "iexpr_program.hpp"
 
 #include <arbor/cable_cell.hpp>
 #include <arbor/cable_cell_param.hpp>
@@ -499,3 +500,49 @@ TEST(iexpr, fvm_layout) {
         }
     }
 }
+
+TEST(iexpr, program) {
+    segment_tree tree;
+    tree.append(mnpos, {0, 0, 0, 10}, {0, 0, 10, 10}, 1);
+    tree.append(0, {0, 0, 10, 1}, {0, 0, 20, 1}, 3);
+    tree.append(0, {0, 0, 10, 1}, {0, 0, 30, 0.5}, 4);
+    tree.append(mnpos, {0, 0, 0, 2}, {0, 0, -20, 2}, 2);
+
+    arb::mprovider prov(arb::morphology(std::move(tree)));
+
+    auto root = arb::mlocation{0, 0};
+    std::vector<iexpr> exprs = {
+        iexpr::exp(iexpr::mul(-0.1, iexpr::distance(root))),
+        iexpr::add(iexpr::distance(2.0, root), iexpr::radius()),
+        iexpr::div(iexpr::step(iexpr::sub(iexpr::distance(root), 15.0)), iexpr::diameter(0.5)),
+        iexpr::log(iexpr::proximal_distance(arb::mlocation{1, 1})),
+        iexpr::interpolation(1, root, 3, arb::mlocation_list{{1, 1}, {2, 1}}),
+        iexpr::mul(iexpr::add(2.0, 3.0), iexpr::step_left(iexpr::distal_distance(root))),
+    };
+
+    std::vector<mcable> cables = {{0, 0, 1}, {1, 0, 0.3}, {1, 0.3, 1}, {2, 0.1, 0.9}, {3, 0, 1}, {1, 0, 0.3}};
+
+    iexpr_program program;
+    for (const auto& e: exprs) {
+        auto ptr = thingify(e, prov);
+        auto r = program.lower(ptr);
+        EXPECT_EQ(r, program.lower(ptr));
+
+        auto values = program.evaluate(r, cables, prov);
+        ASSERT_EQ(cables.size(), values.size());
+        for (auto i: util::count_along(cables)) {
+            EXPECT_DOUBLE_EQ(ptr->eval(prov, cables[i]), values[i]);
+            EXPECT_DOUBLE_EQ(values[i], program.value(r, cables[i]));
+        }
+    }
+
+    // The distance to the root and the radius are shared, constants folded.
+    auto n = program.size();
+    auto r = program.lower(thingify(iexpr::mul(iexpr::distance(root), iexpr::radius()), prov));
+    EXPECT_EQ(n + 1, program.size());
+    EXPECT_FALSE(program.constant(r));
+
+    auto c = program.lower(thingify(iexpr::exp(iexpr::add(1.0, 2.0)), prov));
+    ASSERT_TRUE(program.constant(c));
+    EXPECT_DOUBLE_EQ(std::exp(3.0), *program.constant(c));
+}
@@ -141,6 +141,17 @@ TEST(mech_kinetic, kinetic_linear_2_conserve) {
     run_test<multicore::backend>("test1_kin_steadystate", state_variables, t0_values, t1_1_values, 0.5);
 }
 
+TEST(mech_kinetic, kinetic_linear_expm) {
+    // Exact solution x(dt) = exp(dt·A)·x(0) of the test0 schemes.
+    std::vector<std::string> state_variables = {"s", "h", "d"};
+    std::vector<arb_value_type> t0_values = {0.5, 0.2, 0.3};
+    std::vector<arb_value_type> t1_0_values = {0.351608706, 0.508430880, 0.139960415};
+    std::vector<arb_value_type> t1_1_values = {0.275235121, 0.711483836, 0.0132810429};
+
+    run_test<multicore::backend>("test0_kin_expm", state_variables, t0_values, t1_0_values, 0.5);
+    run_test<multicore::backend>("test0_kin_compartment_expm", state_variables, t0_values, t1_1_values, 0.5);
+}
+
 TEST(mech_kinetic, kinetic_nonlinear) {
     std::vector<std::string> state_variables = {"a", "b", "c"};
     std::vector<arb_value_type> t0_values = {0.2, 0.3, 0.5};
@@ -220,6 +231,16 @@ TEST(mech_kinetic_gpu, kinetic_linear_2_conserve) {
     run_test<gpu::backend>("test1_kin_steadystate", state_variables, t0_values, t1_1_values, 0.5);
 }
 
+TEST(mech_kinetic_gpu, kinetic_linear_expm) {
+    std::vector<std::string> state_variables = {"s", "h", "d"};
+    std::vector<arb_value_type> t0_values = {0.5, 0.2, 0.3};
+    std::vector<arb_value_type> t1_0_values = {0.351608706, 0.508430880, 0.139960415};
+    std::vector<arb_value_type> t1_1_values = {0.275235121, 0.711483836, 0.0132810429};
+
+    run_test<gpu::backend>("test0_kin_expm", state_variables, t0_values, t1_0_values, 0.5);
+    run_test<gpu::backend>("test0_kin_compartment_expm", state_variables, t0_values, t1_1_values, 0.5);
+}
+
 TEST(mech_kinetic_gpu, kinetic_nonlinear) {
     std::vector<std::string> state_variables = {"a", "b", "c"};
     std::vector<arb_value_type> t0_values = {0.2, 0.3, 0.5};
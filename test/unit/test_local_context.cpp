@@ -48,6 +48,15 @@ TEST(local_context, sum)
     EXPECT_EQ(42u,  ctx.min(42u));
 }
 
+TEST(local_context, reduce_values)
+{
+    arb::local_context ctx;
+    std::vector<double> values = {1., 2.5, 42.};
+
+    EXPECT_EQ(values, ctx.max_values(values));
+    EXPECT_EQ(values, ctx.sum_values(values));
+}
+
 TEST(local_context, gather)
 {
     arb::local_context ctx;
@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <string>
 
 #include <arbor/arbexcept.hpp>
@@ -14,6 +15,11 @@
 #define LIBDIR "."
 #endif
 
+#ifndef MODDIR
+#warning "MODDIR not set; defaulting to '.'"
+#define MODDIR "."
+#endif
+
 using namespace std::string_literals;
 using namespace arb;
 
@@ -294,6 +300,44 @@ TEST(mechcat, loading) {
 #endif
 }
 
+#if defined(ARB_INCLUDE_DIRS)
+TEST(mechcat, compiling) {
+    namespace fs = std::filesystem;
+
+    catalogue_compile_options opts;
+    opts.include_dirs = {ARB_INCLUDE_DIRS};
+    opts.cache_dir = fs::path{LIBDIR}/"catalogue-cache";
+    fs::remove_all(opts.cache_dir);
+
+    auto count_cached = [&] {
+        unsigned n = 0;
+        for (const auto& e: fs::directory_iterator(opts.cache_dir)) n += e.path().extension()==".so";
+        return n;
+    };
+
+    EXPECT_THROW(compile_catalogue("not-an-identifier", {MODDIR "/dummy.mod"}, opts), bad_catalogue_error);
+    EXPECT_THROW(compile_catalogue("jit", {MODDIR "/does-not-exist.mod"}, opts), file_not_found_error);
+
+    const mechanism_catalogue cat = compile_catalogue("jit", {MODDIR "/dummy.mod"}, opts);
+    EXPECT_EQ(std::vector<std::string>{"dummy"}, cat.mechanism_names());
+    EXPECT_EQ(1u, count_cached());
+
+    // Same sources and options: served from the cache.
+    const mechanism_catalogue cached = compile_catalogue("jit", {MODDIR "/dummy.mod"}, opts);
+    EXPECT_EQ(std::vector<std::string>{"dummy"}, cached.mechanism_names());
+    EXPECT_EQ(1u, count_cached());
+
+    // Different flags: a new entry.
+    opts.cxx_flags = {"-DARB_UNUSED_FLAG"};
+    compile_catalogue("jit", {MODDIR "/dummy.mod"}, opts);
+    EXPECT_EQ(2u, count_cached());
+
+    opts.cxx_flags = {"-fno-such-flag-for-sure"};
+    EXPECT_THROW(compile_catalogue("jit", {MODDIR "/dummy.mod"}, opts), catalogue_compilation_error);
+    EXPECT_EQ(2u, count_cached());
+}
+#endif
+
 TEST(mechcat, derived_info) {
     auto cat = build_fake_catalogue();
 
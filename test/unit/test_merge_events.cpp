@@ -270,3 +270,31 @@ TEST(merge_events, tourney_poisson) {
     EXPECT_TRUE(std::is_sorted(lf.begin(), lf.end()));
     EXPECT_EQ(lf, expected);
 }
+
+// Test the tree merge on lanes with long runs, ties across lanes, and
+// events that differ only in target or in the sign of the weight.
+TEST(merge_events, tourney_runs) {
+    std::vector<pse_vector> lanes = {
+        {{0, 1, 1}, {0, 1.1, 1}, {0, 1.2, 1}, {0, 1.3, 1}, {0, 5, 1}, {0, 5.1, 1}},
+        {{1, 1.2, -2}, {0, 2, 1}, {0, 2, 2}, {0, 3, -1}, {0, 4, 1}},
+        {},
+        {{0, 1.2, 1}, {0, 1.2, 1}, {2, 1.2, -1}, {0, 6, 0}},
+        {{0, 0.5, 0}},
+    };
+    pse_vector expected;
+    for (const auto& l: lanes) util::append(expected, l);
+    util::sort(expected);
+
+    for (std::size_t n = 1; n <= lanes.size(); ++n) {
+        std::vector<event_span> spans;
+        for (std::size_t i = 0; i < lanes.size(); ++i) {
+            const auto& l = lanes[(i+n)%lanes.size()];
+            spans.emplace_back(l.data(), l.data()+l.size());
+        }
+
+        pse_vector out;
+        tree_merge_events(spans, out);
+        EXPECT_EQ(expected, out);
+        for (const auto& s: spans) EXPECT_TRUE(s.empty());
+    }
+}
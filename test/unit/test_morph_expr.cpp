@@ -193,6 +193,63 @@ TEST(region, thingify_named) {
     }
 }
 
+TEST(region, thingify_shared_cache) {
+    using pvec = std::vector<msize_t>;
+    using svec = std::vector<mpoint>;
+
+    auto sm = segments_from_points(svec{ {0,0,0,1}, {10,0,0,1}, {20,0,0,1} }, pvec{mnpos, 0, 1});
+    morphology m(sm);
+    auto cache = std::make_shared<thingify_cache>();
+
+    region mid = reg::distal_interval(ls::location(0, 0.25), 5);
+    locset ends = ls::terminal();
+
+    // Cells share results for anonymous expressions on the same morphology.
+    label_dict d1, d2;
+    d1.set("fruit", reg::cable(0, 0, 0.5));
+    d2.set("fruit", reg::cable(0, 0.5, 1));
+    mprovider p1(m, d1, cache);
+    mprovider p2(m, d2, cache);
+    EXPECT_EQ(20., p2.embedding().branch_length(0));
+
+    EXPECT_EQ(mextent(mcable_list{{0, 0.25, 0.5}}), thingify(mid, p1));
+    EXPECT_EQ(0u, cache->hits());
+    EXPECT_EQ(thingify(mid, p1), thingify(mid, p2));
+    EXPECT_EQ(thingify(ends, p1), thingify(ends, p2));
+    EXPECT_EQ(3u, cache->hits());
+
+    // Expressions referring to labels are evaluated per cell...
+    region fruit = reg::named("fruit");
+    EXPECT_EQ(mextent(mcable_list{{0, 0, 0.5}}), thingify(fruit, p1));
+    EXPECT_EQ(mextent(mcable_list{{0, 0.5, 1}}), thingify(fruit, p2));
+    EXPECT_EQ(mextent(mcable_list{{0, 0.25, 0.5}}), thingify(intersect(fruit, mid), p1));
+
+    // ... but their anonymous parts are shared.
+    auto size = cache->size();
+    thingify(join(mid, reg::tagged(1)), p1);
+    thingify(join(mid, reg::tagged(1)), p2);
+    EXPECT_EQ(size+2, cache->size());
+
+    // Expressions differing only past the default printing precision are
+    // not confused.
+    auto near = thingify(ls::location(0, 0.1234567), p1);
+    auto nearer = thingify(ls::location(0, 0.1234568), p1);
+    EXPECT_EQ(mlocation_list{{0, 0.1234567}}, near);
+    EXPECT_EQ(mlocation_list{{0, 0.1234568}}, nearer);
+    auto ext = thingify(reg::cable(0, 0.5, 0.7654321), p1);
+    EXPECT_EQ(mextent(mcable_list{{0, 0.5, 0.7654322}}), thingify(reg::cable(0, 0.5, 0.7654322), p1));
+    EXPECT_NE(ext, thingify(reg::cable(0, 0.5, 0.7654322), p1));
+
+    // A different morphology object does not share results.
+    auto hits = cache->hits();
+    mprovider p3(morphology(sm), d1, cache);
+    thingify(mid, p3);
+    EXPECT_EQ(hits, cache->hits());
+
+    cache->clear();
+    EXPECT_EQ(0u, cache->size());
+}
+
 // Compare locsets to within machine epsilon accuracy.
 bool compare_locsets(const mlocation_list& lhs, const mlocation_list& rhs) {
     if (lhs.size()!=rhs.size()) return false;
@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <arbor/cable_cell.hpp>
+#include <arbor/morph/mprovider.hpp>
+#include <arbor/morph/primitives.hpp>
+#include <arbor/morph/segment_tree.hpp>
+
+#include <arborio/cableio.hpp>
+#include <arborio/morphology_cache.hpp>
+
+using namespace arborio;
+
+namespace {
+std::string acc_text(const arb::cable_cell& cell) {
+    std::ostringstream os;
+    write_component(os, cell);
+    return os.str();
+}
+
+struct temp_path {
+    std::filesystem::path path;
+    explicit temp_path(const std::string& name):
+        path(std::filesystem::temp_directory_path()/(name+"-"+std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+    {}
+    ~temp_path() { std::filesystem::remove(path); }
+};
+
+morphology_cache_entry make_entry(unsigned n, bool with_decor) {
+    morphology_cache_entry e;
+    auto p = e.segment_tree.append(arb::mnpos, {0, 0, 0, 5}, {0, 0, 10, 5}, 1);
+    for (unsigned i = 0; i<n; ++i) {
+        e.segment_tree.append(p, {0, 0.5*i, 10, 1}, {0, 1.+i, 20+i/3., 0.5}, 3);
+    }
+    e.segment_tree.append(0, {0, 0, 0, 5}, {0, -1/3., -10, 0.25}, 2);
+
+    e.labels.set("soma", arb::reg::tagged(1));
+    e.labels.set("mid", arb::ls::location(0, 0.5));
+    e.labels.set("third", arb::ls::location(0, 1/3.));
+    e.labels.set("prox", arb::reg::cable(0, 0, 3.61e-5));
+
+    if (with_decor) {
+        arb::decor d;
+        d.set_default(arb::membrane_capacitance{0.01*arb::units::F/arb::units::m2});
+        d.paint(arb::reg::named("soma"), arb::density("hh"));
+        d.paint(arb::reg::tagged(3), arb::density("pas", {{"g", 0.002}}));
+        d.paint(arb::reg::named("prox"), arb::density("pas", {{"g", 3.61e-5}, {"e", -65.1/3}}));
+        d.place(arb::ls::named("mid"), arb::synapse("expsyn"), "syn");
+        d.place(arb::ls::named("third"), arb::synapse("expsyn", {{"tau", 1/3.}}), "syn3");
+        d.place(arb::ls::named("mid"), arb::threshold_detector{-10*arb::units::mV}, "det");
+        e.decor = d;
+    }
+    return e;
+}
+} // anonymous namespace
+
+TEST(morphology_cache, round_trip) {
+    temp_path tmp("arbor-test-morphology-cache");
+    std::vector<morphology_cache_entry> entries = {make_entry(3, true), make_entry(0, false), {}, make_entry(100, true)};
+    write_morphology_cache(tmp.path, entries);
+
+    morphology_cache cache(tmp.path);
+    ASSERT_EQ(entries.size(), cache.size());
+
+    for (std::size_t i = 0; i<entries.size(); ++i) {
+        const auto& expected = entries[i];
+        auto tree = cache.segment_tree(i);
+        EXPECT_EQ(expected.segment_tree, tree);
+        EXPECT_EQ(expected.decor.has_value(), cache.decor(i).has_value());
+
+        auto entry = cache[i];
+        EXPECT_EQ(expected.segment_tree, entry.segment_tree);
+        EXPECT_EQ(expected.labels.regions().size(), entry.labels.regions().size());
+        EXPECT_EQ(expected.labels.locsets().size(), entry.labels.locsets().size());
+
+        // Cells built from the cache describe themselves as the originals do.
+        if (expected.decor) {
+            arb::cable_cell original(arb::morphology(expected.segment_tree), *expected.decor, expected.labels);
+            arb::cable_cell restored(cache.morphology(i), *entry.decor, entry.labels);
+            EXPECT_EQ(acc_text(original), acc_text(restored));
+
+            // Texts would agree even if both lost precision: compare the
+            // decoded paintings and placements too.
+            arb::mprovider p_expected(original.morphology(), expected.labels);
+            arb::mprovider p_restored(restored.morphology(), entry.labels);
+
+            const auto& paint_expected = expected.decor->paintings();
+            const auto& paint_restored = entry.decor->paintings();
+            ASSERT_EQ(paint_expected.size(), paint_restored.size());
+            for (std::size_t j = 0; j<paint_expected.size(); ++j) {
+                EXPECT_EQ(thingify(paint_expected[j].first, p_expected), thingify(paint_restored[j].first, p_restored));
+                const auto& a = std::get<arb::density>(paint_expected[j].second).mech;
+                const auto& b = std::get<arb::density>(paint_restored[j].second).mech;
+                EXPECT_EQ(a.name(), b.name());
+                EXPECT_EQ(a.values(), b.values());
+            }
+
+            const auto& place_expected = expected.decor->placements();
+            const auto& place_restored = entry.decor->placements();
+            ASSERT_EQ(place_expected.size(), place_restored.size());
+            for (std::size_t j = 0; j<place_expected.size(); ++j) {
+                EXPECT_EQ(thingify(std::get<0>(place_expected[j]), p_expected), thingify(std::get<0>(place_restored[j]), p_restored));
+                EXPECT_EQ(std::get<1>(place_expected[j]).index(), std::get<1>(place_restored[j]).index());
+                if (auto a = std::get_if<arb::synapse>(&std::get<1>(place_expected[j]))) {
+                    EXPECT_EQ(a->mech.values(), std::get<arb::synapse>(std::get<1>(place_restored[j])).mech.values());
+                }
+            }
+        }
+    }
+
+    EXPECT_THROW(cache.segment_tree(entries.size()), morphology_cache_error);
+}
+
+TEST(morphology_cache, bad_files) {
+    temp_path tmp("arbor-test-morphology-cache-bad");
+    EXPECT_THROW(morphology_cache{tmp.path}, arb::file_not_found_error);
+
+    std::ofstream(tmp.path) << "((segment 0 (point 0 0 0 1) (point 0 0 1 1) 1))";
+    EXPECT_THROW(morphology_cache{tmp.path}, morphology_cache_error);
+
+    // Truncated cache.
+    std::ostringstream os;
+    write_morphology_cache(os, {make_entry(10, true)});
+    auto bytes = os.str();
+    std::ofstream(tmp.path, std::ios::binary).write(bytes.data(), bytes.size()/2);
+    EXPECT_THROW(morphology_cache{tmp.path}, morphology_cache_error);
+
+    // Entry sizes whose sum wraps around; the entry follows the 24 byte
+    // header and an index of two offsets.
+    auto corrupt = [&](std::size_t field, std::uint64_t value) {
+        auto b = bytes;
+        std::memcpy(b.data() + 40 + 8*field, &value, sizeof value);
+        std::ofstream(tmp.path, std::ios::binary).write(b.data(), b.size());
+        morphology_cache cache(tmp.path);
+        cache.segment_tree(0);
+    };
+    EXPECT_THROW(corrupt(0, std::uint64_t(1)<<61), morphology_cache_error);
+    EXPECT_THROW(corrupt(1, std::uint64_t(-1)), morphology_cache_error);
+    EXPECT_THROW(corrupt(2, std::uint64_t(-8)), morphology_cache_error);
+
+    // Unknown version.
+    bytes[8] = char(morphology_cache_version()+1);
+    std::ofstream(tmp.path, std::ios::binary).write(bytes.data(), bytes.size());
+    EXPECT_THROW(morphology_cache{tmp.path}, morphology_cache_error);
+}
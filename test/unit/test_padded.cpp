@@ -46,12 +46,68 @@ TEST(padded_vector, allocator_propagation) {
     EXPECT_EQ(1u, pb.alignment());
     EXPECT_NE(pa, pb);
 
-    // Propagate on copy- or move-assignment:
+    // Keep the allocator and storage on copy-assignment:
+    auto data = b.data();
     b = a;
-    EXPECT_NE(pb.alignment(), b.get_allocator().alignment());
-    EXPECT_EQ(pa.alignment(), b.get_allocator().alignment());
+    EXPECT_EQ(pb.alignment(), b.get_allocator().alignment());
+    EXPECT_EQ(data, b.data());
+    EXPECT_EQ(a, b);
 
+    // Propagate on move-assignment:
     pvector<double> c;
     c = std::move(a);
     EXPECT_EQ(c.get_allocator().alignment(), pa.alignment());
 }
+
+TEST(padded_vector, arena) {
+    auto ar = std::make_shared<arb::util::arena>();
+    padded_allocator<double> pa(64, ar);
+
+    pvector<double> a(101, 1.0, pa);
+    pvector<double> b(33, 2.0, pa);
+
+    EXPECT_EQ(pa, a.get_allocator());
+    EXPECT_TRUE(is_aligned(a.data(), 64));
+    EXPECT_TRUE(is_aligned(b.data(), 64));
+
+    // Consecutive allocations are adjacent, up to padding.
+    EXPECT_EQ((char*)a.data()+832, (char*)b.data());
+    EXPECT_EQ(832u+320u, ar->used());
+    EXPECT_LE(ar->used(), ar->reserved());
+
+    // Copies do not allocate from the arena.
+    pvector<double> c(a);
+    EXPECT_FALSE(c.get_allocator().arena());
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(832u+320u, ar->used());
+
+    // Assigning a copy to an arena backed array keeps its storage.
+    auto pa_data = a.data();
+    c[0] = 4.0;
+    a = c;
+    EXPECT_EQ(pa_data, a.data());
+    EXPECT_EQ(ar, a.get_allocator().arena());
+    EXPECT_EQ(4.0, a[0]);
+    EXPECT_EQ(832u+320u, ar->used());
+
+    // Releasing the most recent allocation frees its space for reuse.
+    auto pb = b.data();
+    b = pvector<double>(pa);
+    EXPECT_EQ(832u, ar->used());
+    pvector<double> d(33, 3.0, pa);
+    EXPECT_EQ(pb, d.data());
+}
+
+TEST(padded_vector, arena_chunks) {
+    auto ar = std::make_shared<arb::util::arena>(true);
+    padded_allocator<char> pa(8, ar);
+
+    // Allocations larger than a chunk get a chunk of their own, rounded up to
+    // whole huge pages.
+    std::size_t n = arb::util::arena::huge_page_size+1;
+    std::vector<char, padded_allocator<char>> v(n, 'a', pa);
+
+    EXPECT_TRUE(is_aligned(v.data(), arb::util::arena::huge_page_size));
+    EXPECT_EQ(2*arb::util::arena::huge_page_size, ar->reserved());
+    EXPECT_LE((std::int64_t)ar->reserved(), arb::util::arena::total_reserved());
+}
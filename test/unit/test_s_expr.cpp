@@ -239,6 +239,7 @@ TEST(cv_policies, round_tripping) {
     auto literals = {"(every-segment (tag 42))",
                      "(fixed-per-branch 23 (segment 0) (flag-interior-forks))",
                      "(max-extent 23.1 (segment 0) (flag-interior-forks))",
+                     "(d-lambda 50 0.2 (segment 0) (flag-none))",
                      "(single (segment 0))",
                      "(explicit (terminal) (segment 0))",
                      "(join (every-segment (tag 42)) (single (segment 0)))",
@@ -253,6 +254,7 @@ TEST(cv_policies, literals) {
     EXPECT_NO_THROW("(every-segment (tag 42))"_cvp);
     EXPECT_NO_THROW("(fixed-per-branch 23 (segment 0) (flag-interior-forks))"_cvp);
     EXPECT_NO_THROW("(max-extent 23.1 (segment 0) (flag-interior-forks))"_cvp);
+    EXPECT_NO_THROW("(d-lambda 100 0.1)"_cvp);
     EXPECT_NO_THROW("(single (segment 0))"_cvp);
     EXPECT_NO_THROW("(explicit (terminal) (segment 0))"_cvp);
     EXPECT_NO_THROW("(join (every-segment (tag 42)) (single (segment 0)))"_cvp);
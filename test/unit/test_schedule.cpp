@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <random>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include <arbor/common_types.hpp>
@@ -293,3 +294,56 @@ TEST(schedule, poisson_tstop) {
     EXPECT_TRUE(*max <= T);
 }
 
+
+TEST(schedule, poisson_superposition) {
+    namespace U = arb::units;
+
+    // A single source is an ordinary Poisson schedule.
+    auto single = poisson_superposition_schedule({{0.234*U::kHz, 3.3*U::ms, 80*U::ms}}, 42);
+    auto reference = poisson_schedule(3.3*U::ms, 0.234*U::kHz, 42, 80*U::ms);
+    EXPECT_EQ(as_vector(reference.events(0, 100)), as_vector(single.events(0, 100)));
+
+    // Counts over intervals of constant summed rate against the corresponding
+    // Poisson distributions: 2 kHz in [0, 20), 5 kHz in [20, 40), 6 kHz in
+    // [40, 45), 5 kHz in [45, 50), and 3 kHz in [50, 100); the last source
+    // is never active.
+    constexpr double alpha = 0.01;
+    std::vector<poisson_source> sources = {
+        {2*U::kHz, 0*U::ms, 50*U::ms},
+        {3*U::kHz, 20*U::ms, 100*U::ms},
+        {1*U::kHz, 40*U::ms, 45*U::ms},
+        {7*U::kHz, 60*U::ms, 60*U::ms},
+    };
+    auto S = poisson_superposition_schedule(sources, 7);
+    auto events = as_vector(S.events(0, 200));
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end()));
+    ASSERT_FALSE(events.empty());
+    EXPECT_LT(events.back(), 100.);
+
+    auto count = [&](double t0, double t1) {
+        return std::count_if(events.begin(), events.end(), [&](auto t) { return t0<=t && t<t1; });
+    };
+    for (auto [t0, t1, lambda]: {std::tuple{0., 20., 40.}, {20., 40., 100.}, {40., 45., 30.}, {45., 50., 25.}, {50., 100., 150.}}) {
+        double cdf = poisson::poisson_cdf_approx(count(t0, t1), lambda);
+        EXPECT_GT(cdf, alpha/2);
+        EXPECT_LT(cdf, 1 - alpha/2);
+    }
+
+    // Many sources of one rate as one of the summed rate.
+    std::vector<poisson_source> many(1024, {0.125*U::kHz});
+    auto M = poisson_superposition_schedule(many, 3);
+    auto N = poisson_superposition_schedule({{128*U::kHz}}, 3);
+    EXPECT_EQ(as_vector(N.events(0, 1)), as_vector(M.events(0, 1)));
+
+    EXPECT_TRUE(as_vector(poisson_superposition_schedule({}).events(0, 100)).empty());
+    EXPECT_THROW(poisson_superposition_schedule({{-1*U::kHz}}), std::domain_error);
+    EXPECT_THROW(poisson_superposition_schedule({{1*U::kHz, 10*U::ms, 5*U::ms}}), std::domain_error);
+}
+
+TEST(schedule, poisson_superposition_invariants) {
+    SCOPED_TRACE("poisson_superposition_invariants");
+    std::vector<poisson_source> sources = {{0.5*arb::units::kHz, 2*arb::units::ms, 12*arb::units::ms},
+                                           {0.4*arb::units::kHz, 4*arb::units::ms}};
+    run_invariant_checks(poisson_superposition_schedule(sources), 1, 15.3, 7);
+    run_reset_check(poisson_superposition_schedule(sources, 5), 1, 15, 7);
+}
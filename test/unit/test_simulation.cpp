@@ -2,20 +2,26 @@
 
 #include <vector>
 #include <any>
+#include <optional>
 
 #include <arbor/cable_cell.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/context.hpp>
 #include <arbor/domain_decomposition.hpp>
+#include <arbor/domdecexcept.hpp>
 #include <arbor/load_balance.hpp>
 #include <arbor/lif_cell.hpp>
 #include <arbor/recipe.hpp>
+#include <arbor/sampling.hpp>
+#include <arbor/simple_sampler.hpp>
 #include <arbor/simulation.hpp>
 #include <arbor/spike_source_cell.hpp>
 
 #include "util/rangeutil.hpp"
 #include "util/transform.hpp"
 
+#include "../common_cells.hpp"
+
 using namespace arb;
 namespace U = arb::units;
 
@@ -206,3 +212,215 @@ TEST(simulation, restart) {
         }
     }
 }
+
+struct hh_with_synapse: public recipe {
+    hh_with_synapse(schedule triggers): triggers_(std::move(triggers)) {
+        properties.default_parameters = neuron_parameter_defaults;
+    }
+
+    cell_size_type num_cells() const override { return 1; }
+    cell_kind get_cell_kind(cell_gid_type) const override { return cell_kind::cable; }
+    util::unique_any get_cell_description(cell_gid_type) const override {
+        auto c = make_cell_soma_only(false);
+        c.decorations.place(mlocation{0, 0.5}, synapse("expsyn"), "syn");
+        return cable_cell(c);
+    }
+    std::vector<event_generator> event_generators(cell_gid_type) const override {
+        return {event_generator({"syn"}, 0.1, triggers_)};
+    }
+    std::any get_global_properties(cell_kind) const override { return properties; }
+
+    cable_cell_global_properties properties;
+    schedule triggers_;
+};
+
+TEST(simulation, mechanism_counters) {
+    {
+        lif_chain rec(3, 10, explicit_schedule_from_milliseconds(std::vector<double>{1.}));
+        simulation sim(rec);
+        sim.run(5*U::ms, 0.025*U::ms);
+        EXPECT_TRUE(sim.get_mechanism_counters().empty());
+    }
+
+    hh_with_synapse rec(explicit_schedule_from_milliseconds(std::vector<double>{1., 2., 3.}));
+    simulation sim(rec);
+    sim.run(5*U::ms, 0.025*U::ms);
+
+    auto counters = sim.get_mechanism_counters();
+    for (const auto& c: counters) EXPECT_EQ(0u, c.group);
+
+    auto find = [&](const std::string& name) {
+        auto it = std::find_if(counters.begin(), counters.end(), [&](auto& c) { return c.name==name; });
+        EXPECT_NE(counters.end(), it);
+        return it==counters.end()? mechanism_counters{}: *it;
+    };
+    auto h = find("hh");
+    auto e = find("expsyn");
+
+    EXPECT_EQ(1u, h.width);
+    EXPECT_EQ(1u, e.width);
+    EXPECT_EQ(200u, h.state.calls);
+    EXPECT_EQ(200u, h.current.calls);
+    EXPECT_LE(1u, h.init.calls);
+    EXPECT_LT(0., h.state.time);
+    EXPECT_DOUBLE_EQ(h.state.time/h.state.calls, h.state.mean_time());
+    EXPECT_EQ(0u, h.events_applied);
+    EXPECT_EQ(3u, e.events_applied);
+    EXPECT_EQ(3u, e.events.calls);
+}
+
+TEST(simulation, epoch_metrics) {
+    lif_chain rec(3, 10, explicit_schedule_from_milliseconds(std::vector<double>{1.}));
+    simulation sim(rec);
+    EXPECT_TRUE(sim.get_epoch_metrics().empty());
+
+    // Epochs are half the delay long; one spike and one event per cell.
+    sim.run(15*U::ms, 0.025*U::ms);
+    sim.run(30*U::ms, 0.025*U::ms);
+    auto metrics = sim.get_epoch_metrics();
+    ASSERT_EQ(6u, metrics.size());
+
+    std::uint64_t n_spike = 0, n_event = 0;
+    for (unsigned i = 0; i<metrics.size(); ++i) {
+        const auto& m = metrics[i];
+        EXPECT_EQ(i, m.id);
+        EXPECT_DOUBLE_EQ(5.*i, m.t0);
+        EXPECT_DOUBLE_EQ(5.*(i+1), m.t1);
+        EXPECT_LE(m.advance_mean, m.advance_max);
+        EXPECT_LE(m.advance_max, m.update);
+        EXPECT_LE(m.gather, m.exchange);
+        // Every epoch is exchanged and enqueued once, and overlaps the
+        // communication of a neighbour as each run has more than one epoch.
+        EXPECT_LT(0., m.exchange);
+        EXPECT_LT(0., m.enqueue);
+        EXPECT_LT(0., m.communication);
+        EXPECT_DOUBLE_EQ(m.update, m.rank_update_max);
+        EXPECT_DOUBLE_EQ(m.update, m.rank_update_mean);
+        EXPECT_DOUBLE_EQ(1., m.rank_imbalance());
+        n_spike += m.num_spikes;
+        n_event += m.num_events;
+    }
+    EXPECT_EQ(1u, metrics[0].num_spikes);
+    EXPECT_EQ(1u, metrics[2].num_spikes);
+    EXPECT_EQ(1u, metrics[4].num_spikes);
+    EXPECT_EQ(3u, n_spike);
+    EXPECT_EQ(3u, n_event);
+
+    sim.reset();
+    EXPECT_TRUE(sim.get_epoch_metrics().empty());
+
+    // Only the most recent epochs are kept.
+    const unsigned max_epochs = 1<<14;
+    sim.run(5.*(max_epochs+10)*U::ms, 0.025*U::ms);
+    metrics = sim.get_epoch_metrics();
+    ASSERT_EQ(max_epochs, metrics.size());
+    for (unsigned i = 0; i<metrics.size(); ++i) {
+        EXPECT_EQ(i+10, metrics[i].id);
+    }
+}
+
+// Two passive cells joined by a gap junction, one driven by a current clamp,
+// optionally coupled across cell groups at a fixed interval.
+struct gj_pair: public recipe {
+    gj_pair(std::optional<double> interval) {
+        properties.default_parameters = neuron_parameter_defaults;
+        properties.gap_junction_coupling_interval = interval;
+    }
+
+    cell_size_type num_cells() const override { return 2; }
+    cell_kind get_cell_kind(cell_gid_type) const override { return cell_kind::cable; }
+    util::unique_any get_cell_description(cell_gid_type gid) const override {
+        segment_tree tree;
+        tree.append(mnpos, {0, 0, 0, 10}, {0, 0, 20, 10}, 1);
+        decor d;
+        d.paint(reg::all(), density("pas"));
+        d.place(mlocation{0, 0.5}, junction("gj", {{"g", 1.}}), "gj");
+        if (!gid) d.place(mlocation{0, 0.5}, i_clamp::box(1*U::ms, 5*U::ms, 0.5*U::nA), "cc");
+        return cable_cell(morphology(tree), d);
+    }
+    std::vector<gap_junction_connection> gap_junctions_on(cell_gid_type gid) const override {
+        return {gap_junction_connection({1-gid, "gj"}, {"gj"}, 0.1)};
+    }
+    std::vector<probe_info> get_probes(cell_gid_type) const override {
+        return {{cable_probe_membrane_voltage{mlocation{0, 0.5}}, "v"}};
+    }
+    std::any get_global_properties(cell_kind) const override { return properties; }
+
+    cable_cell_global_properties properties;
+};
+
+TEST(simulation, gap_junction_coupling) {
+    auto run = [](const recipe& rec, const domain_decomposition_ptr& d, const context& ctx) {
+        std::vector<trace_vector<double>> traces(2);
+        simulation sim(rec, ctx, d);
+        for (cell_gid_type gid: {0u, 1u}) {
+            sim.add_sampler(one_probe({gid, "v"}), regular_schedule(0.5*U::ms), make_simple_sampler(traces[gid]));
+        }
+        sim.run(8*U::ms, 0.025*U::ms);
+        return traces;
+    };
+
+    auto ctx = make_context();
+    gj_pair single(std::nullopt);
+    auto single_dd = partition_load_balance(single, ctx);
+    ASSERT_EQ(1u, single_dd->num_groups());
+    auto expected = run(single, single_dd, ctx);
+
+    // Cells joined by gap junctions may only be placed in different groups
+    // when they are coupled at an interval.
+    gj_pair coupled(0.025);
+    partition_hint_map hints = {{cell_kind::cable, {1, partition_hint::max_size, false}}};
+    auto coupled_dd = partition_load_balance(coupled, ctx, hints);
+    ASSERT_EQ(2u, coupled_dd->num_groups());
+    EXPECT_THROW(domain_decomposition(single, ctx, coupled_dd->groups()), dom_dec_exception);
+    auto result = run(coupled, coupled_dd, ctx);
+
+    for (cell_gid_type gid: {0u, 1u}) {
+        ASSERT_EQ(1u, result[gid].size());
+        const auto& r = result[gid].at(0);
+        const auto& e = expected[gid].at(0);
+        ASSERT_EQ(e.size(), r.size());
+        // Coupling lags by up to one interval, here one time step.
+        for (std::size_t i = 0; i<r.size(); ++i) {
+            EXPECT_NEAR(e[i].v, r[i].v, 0.5);
+        }
+    }
+
+    // The undriven cell follows the driven one.
+    const auto& v1 = result[1].at(0);
+    EXPECT_GT(v1.at(8).v, v1.at(0).v + 1);
+}
+
+// Threshold detectors in groups with remote gap junction peers, whose voltage
+// array extends past the CVs, see only the CVs: on run and on reset.
+TEST(simulation, gap_junction_coupling_detectors) {
+    struct gj_pair_detected: gj_pair {
+        using gj_pair::gj_pair;
+        util::unique_any get_cell_description(cell_gid_type gid) const override {
+            auto c = util::any_cast<cable_cell&&>(gj_pair::get_cell_description(gid));
+            auto d = c.decorations();
+            d.place(mlocation{0, 0.5}, threshold_detector{-50*U::mV}, "det");
+            return cable_cell(c.morphology(), d);
+        }
+    };
+
+    auto ctx = make_context();
+    gj_pair_detected rec(0.025);
+    partition_hint_map hints = {{cell_kind::cable, {1, partition_hint::max_size, false}}};
+    auto dd = partition_load_balance(rec, ctx, hints);
+    ASSERT_EQ(2u, dd->num_groups());
+
+    simulation sim(rec, ctx, dd);
+    std::vector<spike> spikes;
+    sim.set_global_spike_callback([&](const std::vector<spike>& s) { spikes.insert(spikes.end(), s.begin(), s.end()); });
+
+    sim.run(8*U::ms, 0.025*U::ms);
+    auto first = spikes;
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(0u, first.front().source.gid);
+
+    spikes.clear();
+    sim.reset();
+    sim.run(8*U::ms, 0.025*U::ms);
+    EXPECT_EQ(first, spikes);
+}
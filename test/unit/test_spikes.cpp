@@ -202,6 +202,72 @@ TEST(SPIKES_TEST_CLASS, threshold_watcher) {
     EXPECT_FALSE(watch.is_crossed(2));
 }
 
+TEST(SPIKES_TEST_CLASS, threshold_watcher_many) {
+    using value_type = backend::value_type;
+    using index_type = backend::index_type;
+    using array = backend::array;
+    using iarray = backend::iarray;
+
+    // Watch 3 values with 100 detectors, more than fit in one chunk of the
+    // multicore watcher, such that detector i watches value i%3 with
+    // threshold i: many detectors share a value with different thresholds.
+    execution_context context;
+    const unsigned n = 100;
+
+    std::vector<index_type> index;
+    std::vector<value_type> thresh;
+    std::vector<int> src_to_spike_vec;
+    for (unsigned i = 0; i<n; ++i) {
+        index.push_back(i%3);
+        thresh.push_back(i);
+        src_to_spike_vec.push_back(i);
+    }
+
+    iarray src_to_spike(n);
+    memory::copy(src_to_spike_vec, src_to_spike);
+    array time_since_spike(n, -1.0);
+    std::vector<value_type> time_since_spike_vec(n);
+
+    array values(3, 0);
+    backend::threshold_watcher watch(values.size(), src_to_spike.data(), index, thresh, context);
+    watch.reset(values);
+    EXPECT_TRUE(watch.is_crossed(0));
+    for (unsigned i = 1; i<n; ++i) EXPECT_FALSE(watch.is_crossed(i));
+
+    // Raise the second value to 2n over t=(0, 1): every detector on it bar
+    // the first crosses at t=i/(2n), in order of detectors.
+    values[1] = 2.*n;
+    watch.test(time_since_spike, 0., 1.);
+
+    auto crossings = watch.crossings();
+    ASSERT_EQ(33u, crossings.size());
+    for (unsigned j = 0; j<crossings.size(); ++j) {
+        unsigned i = 1 + 3*j;
+        EXPECT_EQ(i, crossings[j].index);
+        EXPECT_DOUBLE_EQ(value_type(i)/(2*n), crossings[j].time);
+    }
+
+    memory::copy(time_since_spike, time_since_spike_vec);
+    for (unsigned i = 0; i<n; ++i) {
+        EXPECT_DOUBLE_EQ(i%3==1? 1. - value_type(i)/(2*n): -1.0, time_since_spike_vec[i]);
+        EXPECT_EQ(i==0 || i%3==1, watch.is_crossed(i));
+    }
+
+    // Raise the third value to n over t=(1, 2): the crossings interpolate
+    // from the value at the previous test, not from that of another value.
+    watch.clear_crossings();
+    values[2] = n;
+    watch.test(time_since_spike, 1., 2.);
+
+    crossings = watch.crossings();
+    ASSERT_EQ(33u, crossings.size());
+    for (unsigned j = 0; j<crossings.size(); ++j) {
+        unsigned i = 2 + 3*j;
+        EXPECT_EQ(i, crossings[j].index);
+        EXPECT_DOUBLE_EQ(1 + value_type(i)/n, crossings[j].time);
+    }
+}
+
 TEST(SPIKES_TEST_CLASS, threshold_watcher_interpolation) {
     auto dt = 0.025*arb::units::ms;
     auto duration = 1*arb::units::ms;
@@ -1,12 +1,15 @@
 #include <array>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 #include <arbor/cable_cell.hpp>
+#include <arbor/context.hpp>
 #include <arbor/morph/morphology.hpp>
 #include <arbor/morph/primitives.hpp>
 
+#include <arborio/morphology_loader.hpp>
 #include <arborio/swcio.hpp>
 
 #include <gtest/gtest.h>
@@ -253,6 +256,62 @@ TEST(swc_parser, stream_validity) {
 
 }
 
+TEST(swc_parser, text_matches_stream) {
+    std::string text =
+        "#  metadata\n"
+        "#\tmore\n"
+        "1 1 0.1 0.2 0.3 0.4 -1\n"
+        "  2\t1 +1e-3 .5 -0.3 4 1 trailing\n"
+        "3 1 0.1 0.2 0.3 0.4 2\r\n"
+        "\n"
+        "4 1 0.1 0.2 0.3 0.4 3\n";
+
+    std::istringstream is(text);
+    auto expected = parse_swc(is);
+    auto data = parse_swc(std::string_view(text));
+
+    EXPECT_EQ(expected.metadata(), data.metadata());
+    EXPECT_EQ(expected.records(), data.records());
+    ASSERT_EQ(3u, data.records().size());
+    EXPECT_EQ(swc_record(2, 1, 1e-3, 0.5, -0.3, 4, 1), data.records()[1]);
+
+    // Parsing stops at the first incomplete record.
+    EXPECT_EQ(1u, parse_swc("1 1 0.1 0.2 0.3 0.4 -1\n2 1 0.1 0.2 0.3\n").records().size());
+}
+
+TEST(swc_parser, load_morphologies) {
+    namespace fs = std::filesystem;
+    auto dir = fs::temp_directory_path()/("arbor-test-swcio-"+std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+    fs::create_directories(dir);
+
+    auto write = [&](const std::string& name, const std::string& text) {
+        auto path = dir/name;
+        std::ofstream(path) << text;
+        return path;
+    };
+    std::string one = "1 1 0 0 0 1 -1\n2 1 0 0 10 1 1\n";
+    std::string two = "1 3 0 0 0 1 -1\n2 3 0 0 10 1 1\n3 3 0 0 20 1 2\n";
+    std::vector<fs::path> paths = {write("a.swc", one), write("b.swc", two), write("c.swc", one), write("d.swc", two)};
+
+    auto ctx = arb::make_context(arb::proc_allocation{2, -1});
+    auto loaded = load_morphologies(paths, ctx);
+    ASSERT_EQ(4u, loaded.size());
+    for (unsigned i = 0; i<paths.size(); ++i) {
+        auto expected = load_swc_arbor(paths[i]);
+        EXPECT_EQ(expected.segment_tree, loaded[i].segment_tree);
+    }
+    EXPECT_EQ(1u, loaded[0].morphology.num_branches());
+    EXPECT_EQ(3, loaded[1].segment_tree.segments().back().tag);
+
+    auto bad = paths;
+    bad.push_back(dir/"missing.swc");
+    EXPECT_THROW(load_morphologies(bad, ctx), arb::file_not_found_error);
+    EXPECT_THROW(load_morphologies({write("e.txt", one)}, ctx), arb::arbor_exception);
+    EXPECT_EQ(1u, load_morphologies({dir/"e.txt"}, ctx, morphology_format::swc_neuron).size());
+
+    fs::remove_all(dir);
+}
+
 TEST(swc_parser, arbor_compliant) {
     {
         // Otherwise, ensure segment ends and tags correspond.
@@ -191,6 +191,39 @@ TEST(task_group, parallel_for) {
     }
 }
 
+TEST(task_group, parallel_for_pinned) {
+    for (int nthreads = 1; nthreads < 20; nthreads*=2) {
+        task_system ts(nthreads);
+        for (int n = 0; n < 10000; n = !n ? 1 : 2 * n) {
+            std::vector<int> v(n, -1);
+            parallel_for::apply_pinned(0, n, &ts, [&](int i) { v[i] = i; });
+            for (int i = 0; i < n; i++) {
+                EXPECT_EQ(i, v[i]);
+            }
+        }
+
+        // Nested in and around other loops.
+        const int n = 100, m = 1000;
+        std::vector<int> v(n*m, -1);
+        parallel_for::apply_pinned(0, n, &ts, [&](int i) {
+            parallel_for::apply(0, m, &ts, [&](int j) { v[i*m+j] = i + j; });
+        });
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                EXPECT_EQ(i + j, v[i*m+j]);
+            }
+        }
+        parallel_for::apply(0, n, &ts, [&](int i) {
+            parallel_for::apply_pinned(0, m, &ts, [&](int j) { v[i*m+j] = i - j; });
+        });
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                EXPECT_EQ(i - j, v[i*m+j]);
+            }
+        }
+    }
+}
+
 
 TEST(task_group, manual_nested_parallel_for) {
     // Check for deadlock or stack overflow
@@ -122,3 +122,26 @@ TEST(timestep_range, rounding) {
         EXPECT_EQ(r.t_end(), t_end);
     }
 }
+
+TEST(timestep_range, bounds) {
+    timestep_range r(std::vector<time_type>{5., 5.5, 6., 7.5, 10.});
+    EXPECT_FALSE(r.empty());
+    EXPECT_EQ(r.size(), 4u);
+    EXPECT_EQ(r.t_begin(), 5.);
+    EXPECT_EQ(r.t_end(), 10.);
+    check(r, 0, 5., 5.5);
+    check(r, 1, 5.5, 6.);
+    check(r, 2, 6., 7.5);
+    check(r, 3, 7.5, 10.);
+    EXPECT_EQ(r.find(4.), r.end());
+    EXPECT_EQ(r.find(10.), r.end());
+
+    // Resetting with a step size reverts to equal steps.
+    r.reset(5., 10., 1.0);
+    EXPECT_EQ(r.size(), 5u);
+    check(r, 2, 7., 8.);
+
+    // Fewer than two bounds yield an empty range.
+    EXPECT_TRUE(timestep_range(std::vector<time_type>{3.}).empty());
+    EXPECT_TRUE(timestep_range(std::vector<time_type>{}).empty());
+}